@@ -53,6 +53,7 @@ BaseTableView::BaseTableView(BaseTable *base_tab) : BaseObjectView(base_tab)
 	this->setAcceptHoverEvents(true);
 	sel_child_obj=nullptr;
 	connected_rels=0;
+	compact_mode=false;
 }
 
 BaseTableView::~BaseTableView(void)
@@ -138,8 +139,8 @@ void BaseTableView::hoverLeaveEvent(QGraphicsSceneHoverEvent *)
 void BaseTableView::hoverMoveEvent(QGraphicsSceneHoverEvent *event)
 {
 	/* Case the table itself is not selected shows the child selector
-		at mouse position */
-	if(!this->isSelected())
+		at mouse position. In compact mode there is no child item to be selected */
+	if(!this->isSelected() && !compact_mode)
 	{
 		QList<QGraphicsItem *> items;
 		float cols_height, item_idx, ext_height=0;
@@ -201,6 +202,42 @@ void BaseTableView::updateConnectedRelsCount(int inc)
   if(connected_rels < 0) connected_rels=0;
 }
 
+void BaseTableView::setCompactMode(bool value)
+{
+	if(compact_mode!=value)
+	{
+		compact_mode=value;
+
+		/* In compact mode the object is cached as a pixmap since it's composed only by a few
+		 polygons and, when zoomed out, it's not modified frequently */
+		this->setCacheMode(compact_mode ? QGraphicsItem::DeviceCoordinateCache : QGraphicsItem::NoCache);
+		configureDetailLevel();
+	}
+}
+
+bool BaseTableView::isCompactMode(void)
+{
+	return(compact_mode);
+}
+
+void BaseTableView::configureDetailLevel(void)
+{
+	columns->setVisible(!compact_mode);
+	ext_attribs->setVisible(!compact_mode && !hide_ext_attribs && !ext_attribs->childItems().isEmpty());
+
+	if(compact_mode)
+	{
+		obj_selection->setVisible(this->isSelected());
+		sel_child_obj=nullptr;
+	}
+}
+
+void BaseTableView::configurePendingObject(void)
+{
+	this->configureObject();
+	emit s_objectMoved();
+}
+
 void BaseTableView::configureTag(void)
 {
   BaseTable *tab=dynamic_cast<BaseTable *>(this->getSourceObject());
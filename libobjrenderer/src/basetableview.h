@@ -72,6 +72,14 @@ class BaseTableView: public BaseObjectView {
     //! brief Configures the tag object when the source object has one.
     void configureTag(void);
 
+		/*! \brief Hides the columns and extended attributes when the compact mode is active.
+		This method must be called at the end of configureObject() of the derived classes */
+		void configureDetailLevel(void);
+
+		/*! \brief Indicates that the object is drawn only as title + body rectangles (low detail mode).
+		The object's geometry is the same in both modes so the connected relationships are not affected */
+		bool compact_mode;
+
 	public:
 		BaseTableView(BaseTable *base_tab);
 		virtual ~BaseTableView(void);
@@ -95,6 +103,16 @@ class BaseTableView: public BaseObjectView {
 		//! \brief Returns the current count of connected relationships
 		int getConnectRelsCount(void);
 
+		//! \brief Toggles the low detail drawing of the object (see compact_mode)
+		void setCompactMode(bool value);
+
+		//! \brief Returns the current state of the low detail drawing
+		bool isCompactMode(void);
+
+		/*! \brief Configures the object whose configuration was postponed by the scene and notifies
+		the connected relationships about the possible new dimensions */
+		void configurePendingObject(void);
+
 	signals:
 		//! \brief Signal emitted when a table is moved over the scene
 		void s_objectMoved(void);
@@ -17,6 +17,7 @@
 */
 
 #include "graphicalview.h"
+#include "objectsscene.h"
 
 GraphicalView::GraphicalView(View *view) : BaseTableView(view)
 {
@@ -53,6 +54,12 @@ void GraphicalView::configureObject(void)
 	TableObject *tab_obj=nullptr;
   Tag *tag=view->getTag();
 
+	ObjectsScene *obj_scene=dynamic_cast<ObjectsScene *>(this->scene());
+
+	//Postpones the configuration of the object when it's outside the visible area of the scene
+	if(obj_scene && obj_scene->deferItemConfiguration(this))
+		return;
+
 	//Configures the view's title
 	title->configureObject(view);
 
@@ -265,5 +272,6 @@ void GraphicalView::configureObject(void)
 
 	this->setToolTip(this->table_tooltip);
   configureTag();
+	configureDetailLevel();
 }
 
@@ -28,13 +28,21 @@ QRectF ObjectsScene::page_margins=QRectF(2,2,2,2);
 QSizeF ObjectsScene::custom_paper_size=QSizeF(0,0);
 QBrush ObjectsScene::grid;
 bool ObjectsScene::corner_move=true;
+bool ObjectsScene::show_frame_time=(getenv("PGMODELER_SHOW_FRAME_TIME")!=nullptr);
 
 ObjectsScene::ObjectsScene(void)
 {
   moving_objs=move_scene=false;
   enable_range_sel=true;
+	compact_mode=configuring_items=false;
+	frame_time=0;
 	this->setBackgroundBrush(grid);
 
+	/* Using the BSP tree explicitly since the item lookup on large models (painting only the exposed area,
+	hovering and range selection) depends on it. The indexing is not disabled during objects movement
+	because the amount of items moved at once is generally small compared to the whole scene */
+	this->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+
 	sel_ini_pnt.setX(NAN);
 	sel_ini_pnt.setY(NAN);
 
@@ -54,9 +62,12 @@ ObjectsScene::ObjectsScene(void)
 
   connect(&scene_move_timer, SIGNAL(timeout()), this, SLOT(moveObjectScene()));
   connect(&corner_hover_timer, SIGNAL(timeout()), this, SLOT(enableSceneMove()));
+	connect(&pending_items_timer, SIGNAL(timeout()), this, SLOT(configurePendingItems()));
 
   scene_move_timer.setInterval(SCENE_MOVE_TIMEOUT);
   corner_hover_timer.setInterval(SCENE_MOVE_TIMEOUT * 10);
+	pending_items_timer.setSingleShot(true);
+	pending_items_timer.setInterval(0);
 }
 
 ObjectsScene::~ObjectsScene(void)
@@ -99,6 +110,149 @@ ObjectsScene::~ObjectsScene(void)
 	}
 }
 
+void ObjectsScene::setFrameTimeVisible(bool value)
+{
+	show_frame_time=value;
+}
+
+bool ObjectsScene::isFrameTimeVisible(void)
+{
+	return(show_frame_time);
+}
+
+void ObjectsScene::setZoomFactor(float zoom)
+{
+	bool compact=(zoom < MIN_DETAIL_ZOOM);
+
+	if(compact!=compact_mode)
+		setCompactMode(compact);
+}
+
+void ObjectsScene::setCompactMode(bool value)
+{
+	if(compact_mode!=value)
+	{
+		QList<QGraphicsItem *> items=this->items();
+		BaseTableView *tab=nullptr;
+
+		compact_mode=value;
+
+		for(auto item : items)
+		{
+			tab=dynamic_cast<BaseTableView *>(item);
+
+			if(tab && !tab->parentItem())
+				tab->setCompactMode(compact_mode);
+		}
+	}
+}
+
+bool ObjectsScene::isCompactMode(void)
+{
+	return(compact_mode);
+}
+
+bool ObjectsScene::isItemInVisibleArea(QGraphicsItem *item)
+{
+	QList<QGraphicsView *> views=this->views();
+	QRectF rect=item->sceneBoundingRect();
+
+	for(auto view : views)
+	{
+		if(view->isVisible() &&
+			 view->mapToScene(view->viewport()->rect()).boundingRect().intersects(rect))
+			return(true);
+	}
+
+	return(false);
+}
+
+bool ObjectsScene::deferItemConfiguration(BaseTableView *item)
+{
+	BaseGraphicObject *graph_obj=nullptr;
+
+	if(!item || configuring_items || !item->boundingRect().isValid())
+		return(false);
+
+	/* The position of the source object is always applied (e.g. when undoing a movement or aligning objects
+	outside the visible area) so the visibility is tested against the place where the item must be drawn */
+	graph_obj=dynamic_cast<BaseGraphicObject *>(item->getSourceObject());
+	if(graph_obj && item->pos()!=graph_obj->getPosition())
+		item->setPos(graph_obj->getPosition());
+
+	if(isItemInVisibleArea(item))
+	{
+		pending_items.erase(item);
+		return(false);
+	}
+
+	pending_items.insert(item);
+	return(true);
+}
+
+void ObjectsScene::configurePendingItems(bool all)
+{
+	vector<BaseTableView *> items;
+
+	for(auto tab : pending_items)
+	{
+		if(all || isItemInVisibleArea(tab))
+			items.push_back(tab);
+	}
+
+	if(!items.empty())
+	{
+		configuring_items=true;
+
+		for(auto tab : items)
+		{
+			pending_items.erase(tab);
+			tab->configurePendingObject();
+		}
+
+		configuring_items=false;
+	}
+}
+
+void ObjectsScene::drawBackground(QPainter *painter, const QRectF &rect)
+{
+	frame_timer.start();
+
+	/* Items can't be reconfigured during the painting so the configuration of the pending
+	items is scheduled to be done right after the current frame */
+	if(!pending_items.empty() && !configuring_items && !pending_items_timer.isActive())
+		pending_items_timer.start();
+
+	QGraphicsScene::drawBackground(painter, rect);
+}
+
+void ObjectsScene::drawForeground(QPainter *painter, const QRectF &rect)
+{
+	QGraphicsScene::drawForeground(painter, rect);
+
+	//The frame time is drawn only on viewports (the painter's device is a widget)
+	if(show_frame_time && frame_timer.isValid() && dynamic_cast<QWidget *>(painter->device()))
+	{
+		QString text;
+
+		//Calculates the average using the exponential moving average of the frame times
+		frame_time=(frame_time * 0.9f) + (frame_timer.nsecsElapsed()/1000000.0f * 0.1f);
+		text=QString("%1 ms | %2 items | %3 pending%4")
+				 .arg(frame_time, 0, 'f', 2)
+				 .arg(this->items(rect).size())
+				 .arg(pending_items.size())
+				 .arg(compact_mode ? QString(" | compact") : QString());
+
+		painter->save();
+		painter->resetTransform();
+		painter->setPen(Qt::black);
+		painter->setBrush(QColor(255,255,225,220));
+		painter->drawRect(QRectF(QPointF(2,2), QSizeF(painter->fontMetrics().width(text) + 10, painter->fontMetrics().height() + 6)));
+		painter->drawText(QPointF(7, 5 + painter->fontMetrics().ascent()), text);
+		painter->restore();
+	}
+}
+
 void ObjectsScene::enableCornerMove(bool enable)
 {
   ObjectsScene::corner_move=enable;
@@ -301,8 +455,11 @@ void ObjectsScene::addItem(QGraphicsItem *item)
 			connect(rel, SIGNAL(s_relationshipModified(BaseGraphicObject*)),
 							this, SLOT(emitObjectModification(BaseGraphicObject*)));
 		else if(tab)
+		{
 			connect(tab, SIGNAL(s_childObjectSelected(TableObject*)),
 							this, SLOT(emitChildObjectSelection(TableObject*)));
+			tab->setCompactMode(compact_mode);
+		}
 
 		if(obj)
 		{
@@ -328,7 +485,10 @@ void ObjectsScene::removeItem(QGraphicsItem *item)
 			rel->disconnectTables();
 		}
 		else if(tab)
+		{
 			disconnect(tab, nullptr, this, nullptr);
+			pending_items.erase(tab);
+		}
 		else if(object)
 			disconnect(object, nullptr, this, nullptr);
 
@@ -51,7 +51,10 @@ class ObjectsScene: public QGraphicsScene {
 
     /*! \brief Timer responsible to check if the user puts cursor at corners for a certain amount of time.
     When this timeout the scene_move_timer will be triggered and the scene will be moved */
-    corner_hover_timer;
+    corner_hover_timer,
+
+		//! \brief Single shot timer that configures the pending items exposed on the views right after the current frame
+		pending_items_timer;
 
     //! \brief Attributes used to control the direction of scene movement when user puts cursor at corners
     int scene_move_dx, scene_move_dy;
@@ -96,6 +99,28 @@ class ObjectsScene: public QGraphicsScene {
     Additionally this method configures the direction of movement when returning true */
     bool mouseIsAtCorner(void);
 
+		//! \brief Indicates if the frame time of the scene rendering must be drawn over the viewports
+		static bool show_frame_time;
+
+		/*! \brief Indicates that the tables and views are drawn only as title + body rectangles
+		(low detail mode). This mode is activated when the zoom factor is lower than MIN_DETAIL_ZOOM */
+		bool compact_mode,
+
+		//! \brief Indicates that the pending items are being configured so their configuration can't be postponed
+		configuring_items;
+
+		//! \brief Stores the tables/views which configuration was postponed because they were not visible
+		set<BaseTableView *> pending_items;
+
+		//! \brief Timer used to measure the time spent rendering a frame (from drawBackground to drawForeground)
+		QElapsedTimer frame_timer;
+
+		//! \brief Average frame time (in milliseconds) of the latest rendered frames
+		float frame_time;
+
+		//! \brief Returns if the item intersects the visible area of at least one view attached to the scene
+		bool isItemInVisibleArea(QGraphicsItem *item);
+
 	protected:
 		//! \brief Brush used to draw the grid over the scene
 		static QBrush grid;
@@ -108,10 +133,37 @@ class ObjectsScene: public QGraphicsScene {
 		//! \brief Draws a line from the point 'p_start' to the cursor position and simulates the relationship creation
 		void showRelationshipLine(bool value, const QPointF &p_start=QPointF(NAN,NAN));
 
+		//! \brief Starts the frame time measurement and schedules the configuration of pending items exposed on the viewports
+		void drawBackground(QPainter *painter, const QRectF &rect);
+
+		//! \brief Finishes the frame time measurement and draws it over the viewport when show_frame_time is set
+		void drawForeground(QPainter *painter, const QRectF &rect);
+
 	public:
+		//! \brief Minimum zoom factor in which the tables and views are drawn with all their children objects
+		static constexpr float MIN_DETAIL_ZOOM=0.40f;
+
 		ObjectsScene(void);
 		~ObjectsScene(void);
 
+		//! \brief Toggles the drawing of the frame time over the viewports
+		static void setFrameTimeVisible(bool value);
+		static bool isFrameTimeVisible(void);
+
+		//! \brief Activates the compact mode (low detail drawing) of tables and views if the zoom is lower than MIN_DETAIL_ZOOM
+		void setZoomFactor(float zoom);
+
+		/*! \brief Toggles the compact mode of all tables and views in the scene. Before rendering the whole
+		scene (e.g. exporting or printing the model) the compact mode must be disabled and the pending items
+		configured via configurePendingItems(true) */
+		void setCompactMode(bool value);
+		bool isCompactMode(void);
+
+		/*! \brief Returns true and marks the item as pending when its configuration can be postponed.
+		Only items already configured once that are outside the visible area of the views are postponed.
+		The position of the source object is applied to the item even when its configuration is postponed */
+		bool deferItemConfiguration(BaseTableView *item);
+
     static void enableCornerMove(bool enable);
     static bool isCornerMoveEnabled(void);
 
@@ -135,6 +187,10 @@ class ObjectsScene: public QGraphicsScene {
 		void alignObjectsToGrid(void);
 		void update(void);
 
+		/*! \brief Configures the pending items that became visible on the views. If 'all' is true
+		the pending items are configured regardless their visibility */
+		void configurePendingItems(bool all=false);
+
     //! brief Toggles the object range selection
     void enableRangeSelection(bool value);
 
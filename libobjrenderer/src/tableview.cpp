@@ -17,6 +17,7 @@
 */
 
 #include "tableview.h"
+#include "objectsscene.h"
 
 TableView::TableView(Table *table) : BaseTableView(table)
 {
@@ -46,6 +47,12 @@ void TableView::configureObject(void)
 	QString atribs[]={ ParsersAttributes::TABLE_BODY, ParsersAttributes::TABLE_EXT_BODY };
   Tag *tag=table->getTag();
 
+	ObjectsScene *obj_scene=dynamic_cast<ObjectsScene *>(this->scene());
+
+	//Postpones the configuration of the object when it's outside the visible area of the scene
+	if(obj_scene && obj_scene->deferItemConfiguration(this))
+		return;
+
 	//Configures the table title
 	title->configureObject(table);
 	px=0;
@@ -229,4 +236,5 @@ void TableView::configureObject(void)
 	this->setToolTip(this->table_tooltip);
 
   configureTag();
+	configureDetailLevel();
 }
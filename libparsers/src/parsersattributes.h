@@ -392,6 +392,7 @@ namespace ParsersAttributes {
 	NOT_EXT_OBJECT="not-ext-object",
 	EXT_OBJ_OIDS="ext-obj-oids",
 	FILTER_OIDS="filter-oids",
+	FILTER_TAB_OIDS="filter-tab-oids",
 	FILTER_TABLE_TYPES="filter-tab-types",
 	GEN_ALTER_CMDS="gen-alter-cmds",
 	LAST_SYS_OID="last-sys-oid",
@@ -49,17 +49,28 @@ const QString SchemaParser::PGSQL_VERSION_91="9.1";
 const QString SchemaParser::PGSQL_VERSION_92="9.2";
 const QString SchemaParser::PGSQL_VERSION_93="9.3";
 
-vector<QString> SchemaParser::buffer;
-attribs_map SchemaParser::attributes;
-QString SchemaParser::filename="";
-unsigned SchemaParser::line=0;
-unsigned SchemaParser::column=0;
-unsigned SchemaParser::comment_count=0;
-bool SchemaParser::ignore_unk_atribs=false;
-bool SchemaParser::ignore_empty_atribs=false;
+QThreadStorage<SchemaParser *> SchemaParser::parsers;
+QMutex SchemaParser::cache_mutex;
+bool SchemaParser::cache_templates=true;
+map<QString, map<QString, shared_ptr<const SchemaTemplate> > > SchemaParser::templates;
 
 QString SchemaParser::pgsql_version=SchemaParser::PGSQL_VERSION_93;
 
+SchemaParser::SchemaParser(void)
+{
+	line=column=comment_count=0;
+	ignore_unk_atribs=ignore_empty_atribs=false;
+}
+
+SchemaParser &SchemaParser::getParser(void)
+{
+	//The instance is destroyed by QThreadStorage when the thread finishes
+	if(!parsers.hasLocalData())
+		parsers.setLocalData(new SchemaParser);
+
+	return(*parsers.localData());
+}
+
 void SchemaParser::setPgSQLVersion(const QString &pgsql_ver)
 {
 	if(!pgsql_ver.isEmpty() &&
@@ -69,14 +80,44 @@ void SchemaParser::setPgSQLVersion(const QString &pgsql_ver)
 										.arg(PGSQL_VERSION_90 + ", " + PGSQL_VERSION_91 + ", " + PGSQL_VERSION_92 + ", " + PGSQL_VERSION_93),
 										ERR_INV_POSTGRESQL_VERSION,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+	QMutexLocker locker(&cache_mutex);
+	QString prev_version=SchemaParser::pgsql_version;
+
 	if(!pgsql_ver.isEmpty())
 		SchemaParser::pgsql_version=pgsql_ver;
 	else
 		SchemaParser::pgsql_version=PGSQL_VERSION_93;
+
+	//Compiled templates are bound to the version in use so they are dropped when it changes
+	if(prev_version!=SchemaParser::pgsql_version)
+		templates.clear();
+}
+
+void SchemaParser::setTemplateCacheEnabled(bool value)
+{
+	QMutexLocker locker(&cache_mutex);
+
+	cache_templates=value;
+
+	if(!cache_templates)
+		templates.clear();
+}
+
+bool SchemaParser::isTemplateCacheEnabled(void)
+{
+	QMutexLocker locker(&cache_mutex);
+	return(cache_templates);
+}
+
+void SchemaParser::clearTemplateCache(void)
+{
+	QMutexLocker locker(&cache_mutex);
+	templates.clear();
 }
 
 QString SchemaParser::getPgSQLVersion(void)
 {
+	QMutexLocker locker(&cache_mutex);
 	return(SchemaParser::pgsql_version);
 }
 
@@ -91,15 +132,17 @@ void SchemaParser::getPgSQLVersions(vector<QString> &versions)
 
 void SchemaParser::restartParser(void)
 {
+	SchemaParser &parser=getParser();
+
 	/* Clears the buffer and resets the counters for line,
 		column and amount of comments */
-	buffer.clear();
-	attributes.clear();
-	line=column=comment_count=0;
+	parser.buffer.clear();
+	parser.line=parser.column=parser.comment_count=0;
 }
 
 void SchemaParser::loadBuffer(const QString &buf)
 {
+	SchemaParser &parser=getParser();
 	QString buf_aux=buf, lin;
 	QTextStream ts(&buf_aux);
 	int pos=0;
@@ -118,7 +161,7 @@ void SchemaParser::loadBuffer(const QString &buf)
 		if(lin=="") lin+=CHR_LINE_END;
 
 		//If the entire line is commented out increases the comment lines counter
-		if(lin[0]==CHR_COMMENT) comment_count++;
+		if(lin[0]==CHR_COMMENT) parser.comment_count++;
 
 		//Looking for the position of other comment characters for deletion
 		pos=lin.indexOf(CHR_COMMENT);
@@ -134,7 +177,7 @@ void SchemaParser::loadBuffer(const QString &buf)
 				lin+=CHR_LINE_END;
 
 			//Add the treated line in the buffer
-			buffer.push_back(lin);
+			parser.buffer.push_back(lin);
 		}
 	}
 }
@@ -159,7 +202,7 @@ void SchemaParser::loadFile(const QString &filename)
 
 		//Loads the parser buffer
 		loadBuffer(buf);
-		SchemaParser::filename=filename;
+		getParser().filename=filename;
 	}
 }
 
@@ -388,116 +431,105 @@ bool SchemaParser::isSpecialCharacter(char chr)
 				 chr==CHR_END_PURETEXT);
 }
 
-bool SchemaParser::evaluateExpression(void)
+void SchemaParser::compileExpression(SchemaInstruction &cond_instr)
 {
 	QString current_line, cond, attrib, prev_cond;
-	bool error=false, end_eval=false, expr_is_true=true, attrib_true=true;
+	bool error=false, end_eval=false;
 	unsigned attrib_count=0, and_or_count=0;
+	SchemaExprTerm term;
 
-	try
+	current_line=buffer[line];
+
+	while(!end_eval && !error)
 	{
-		current_line=buffer[line];
+		ignoreBlankChars(current_line);
 
-		while(!end_eval && !error)
+		if(current_line[column]==CHR_LINE_END)
 		{
-      ignoreBlankChars(current_line);
-
-      if(current_line[column]==CHR_LINE_END)
-      {
-        line++;
-        if(line < buffer.size())
-        {
-          current_line=buffer[line];
-          column=0;
-          ignoreBlankChars(current_line);
-         }
-        else if(!end_eval)
-          error=true;
-      }
-
-			switch(current_line[column].toLatin1())
+			line++;
+			if(line < buffer.size())
 			{
-				//Extract the next conditional token
-				case CHR_INI_CONDITIONAL:
-					prev_cond=cond;
-					cond=getConditional();
-
-								//Error 1: %if @{a} %or %or %then
-					error=(cond==prev_cond ||
-								 //Error 2: %if @{a} %and %or %then
-								 (cond==TOKEN_AND && prev_cond==TOKEN_OR) ||
-								 //Error 3: %if @{a} %or %and %then
-								 (cond==TOKEN_OR && prev_cond==TOKEN_AND) ||
-								 //Error 4: %if %and @{a} %then
-								 (attrib_count==0 && (cond==TOKEN_AND || cond==TOKEN_OR)));
-
-					if(cond==TOKEN_THEN)
-					{
-						/* Returns the parser to the token %then because additional
-						operations is done whe this token is found */
-						column-=cond.length()+1;
-						end_eval=true;
-
-									//Error 1: %if @{a} %not %then
-						error=(prev_cond==TOKEN_NOT ||
-									//Error 2: %if %then
-									attrib_count==0 ||
-									//Error 3: %if @{a} %and %then
-									(and_or_count!=attrib_count-1));
-					}
-					else if(cond==TOKEN_OR || cond==TOKEN_AND)
-						and_or_count++;
-				break;
+				current_line=buffer[line];
+				column=0;
+				ignoreBlankChars(current_line);
+			}
+			else if(!end_eval)
+				error=true;
+		}
 
-				case CHR_INI_ATTRIB:
-					attrib=getAttribute();
+		switch(current_line[column].toLatin1())
+		{
+			//Extract the next conditional token
+			case CHR_INI_CONDITIONAL:
+				prev_cond=cond;
+				cond=getConditional();
+
+							//Error 1: %if @{a} %or %or %then
+				error=(cond==prev_cond ||
+							 //Error 2: %if @{a} %and %or %then
+							 (cond==TOKEN_AND && prev_cond==TOKEN_OR) ||
+							 //Error 3: %if @{a} %or %and %then
+							 (cond==TOKEN_OR && prev_cond==TOKEN_AND) ||
+							 //Error 4: %if %and @{a} %then
+							 (attrib_count==0 && (cond==TOKEN_AND || cond==TOKEN_OR)));
+
+				if(cond==TOKEN_THEN)
+				{
+					/* Returns the parser to the token %then because additional
+					operations is done whe this token is found */
+					column-=cond.length()+1;
+					end_eval=true;
+
+								//Error 1: %if @{a} %not %then
+					error=(prev_cond==TOKEN_NOT ||
+								//Error 2: %if %then
+								attrib_count==0 ||
+								//Error 3: %if @{a} %and %then
+								(and_or_count!=attrib_count-1));
+				}
+				else if(cond==TOKEN_OR || cond==TOKEN_AND)
+					and_or_count++;
+			break;
 
-					//Raises an error if the attribute does is unknown
-					if(attributes.count(attrib)==0 && !ignore_unk_atribs)
-					{
-						throw Exception(Exception::getErrorMessage(ERR_UNK_ATTRIBUTE)
-														.arg(attrib).arg(filename).arg((line + comment_count +1)).arg((column+1)),
-														ERR_UNK_ATTRIBUTE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-					}
+			case CHR_INI_ATTRIB:
+				attrib=getAttribute();
 
-					//Error 1: A conditional token other than %or %not %and if found on conditional expression
-					error=(!cond.isEmpty() && cond!=TOKEN_OR && cond!=TOKEN_AND && cond!=TOKEN_NOT) ||
-								//Error 2: A %not token if found after an attribute: %if @{a} %not %then
-								(attrib_count > 0 && cond==TOKEN_NOT && prev_cond.isEmpty()) ||
-								//Error 3: Two attributes not separated by any conditional token: %if @{a} @{b} %then
-								(attrib_count > 0 && cond.isEmpty());
+				//Error 1: A conditional token other than %or %not %and if found on conditional expression
+				error=(!cond.isEmpty() && cond!=TOKEN_OR && cond!=TOKEN_AND && cond!=TOKEN_NOT) ||
+							//Error 2: A %not token if found after an attribute: %if @{a} %not %then
+							(attrib_count > 0 && cond==TOKEN_NOT && prev_cond.isEmpty()) ||
+							//Error 3: Two attributes not separated by any conditional token: %if @{a} @{b} %then
+							(attrib_count > 0 && cond.isEmpty());
 
-					//Increments the extracted attribute counter
-					attrib_count++;
+				//Increments the extracted attribute counter
+				attrib_count++;
 
-					if(!error)
-					{
-						//Appliyng the NOT operator if found
-						attrib_true=(cond==TOKEN_NOT ? attributes[attrib].isEmpty() : !attributes[attrib].isEmpty());
-
-						//Executing the AND operation if the token is found
-						if(cond==TOKEN_AND || prev_cond==TOKEN_AND)
-							expr_is_true=(expr_is_true && attrib_true);
-						else if(cond==TOKEN_OR || prev_cond==TOKEN_OR)
-							expr_is_true=(expr_is_true || attrib_true);
-						else
-							expr_is_true=attrib_true;
-
-						cond.clear();
-						prev_cond.clear();
-					}
-				break;
+				if(!error)
+				{
+					//Stores the NOT operator and the operator that joins the term to the previous ones
+					term.attribute=attrib;
+					term.negate=(cond==TOKEN_NOT);
+					term.line=line;
+					term.column=column;
+
+					if(cond==TOKEN_AND || prev_cond==TOKEN_AND)
+						term.oper=TOKEN_AND;
+					else if(cond==TOKEN_OR || prev_cond==TOKEN_OR)
+						term.oper=TOKEN_OR;
+					else
+						term.oper.clear();
 
-				default:
-					error=true;
-				break;
-			}
+					cond_instr.expression.push_back(term);
+					cond.clear();
+					prev_cond.clear();
+				}
+			break;
+
+			default:
+				error=true;
+			break;
 		}
 	}
-	catch(Exception &e)
-	{
-		throw Exception(e.getErrorMessage(),e.getErrorType(),	__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
-	}
 
 	if(error)
 	{
@@ -505,6 +537,32 @@ bool SchemaParser::evaluateExpression(void)
 										.arg(filename).arg((line + comment_count + 1)).arg((column+1)),
 										ERR_INVALID_SYNTAX,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 	}
+}
+
+bool SchemaParser::evaluateExpression(const vector<SchemaExprTerm> &expression, attribs_map &attribs)
+{
+	bool expr_is_true=true, attrib_true=true, empty_val;
+	vector<SchemaExprTerm>::const_iterator itr=expression.begin();
+	attribs_map::iterator attr_itr;
+
+	while(itr!=expression.end())
+	{
+		attr_itr=attribs.find(itr->attribute);
+		empty_val=(attr_itr==attribs.end() || attr_itr->second.isEmpty());
+
+		//Appliyng the NOT operator if found
+		attrib_true=(itr->negate ? empty_val : !empty_val);
+
+		//Executing the AND / OR operation with the previous terms
+		if(itr->oper==TOKEN_AND)
+			expr_is_true=(expr_is_true && attrib_true);
+		else if(itr->oper==TOKEN_OR)
+			expr_is_true=(expr_is_true || attrib_true);
+		else
+			expr_is_true=attrib_true;
+
+		itr++;
+	}
 
 	return(expr_is_true);
 }
@@ -550,12 +608,12 @@ QString SchemaParser::getCodeDefinition(const QString & obj_name, attribs_map &a
 
 void SchemaParser::setIgnoreUnkownAttributes(bool ignore)
 {
-	ignore_unk_atribs=ignore;
+	getParser().ignore_unk_atribs=ignore;
 }
 
 void SchemaParser::setIgnoreEmptyAttributes(bool ignore)
 {
-	ignore_empty_atribs=ignore;
+	getParser().ignore_empty_atribs=ignore;
 }
 
 QString SchemaParser::convertCharsToXMLEntities(QString buf)
@@ -646,424 +704,355 @@ QString SchemaParser::convertCharsToXMLEntities(QString buf)
 void SchemaParser::storePgSQLVersion(attribs_map &attribs)
 {
 	vector<QString> vers;
+	QString curr_version=getPgSQLVersion();
+
 	getPgSQLVersions(vers);
 	while(!vers.empty())
 	{
 		//Setting the @{pgsql[VERSION]} attribute in other to know which version is being used
-		attribs[QString("pgsql" + vers.back()).remove(".")]=(vers.back()==pgsql_version ? pgsql_version : "");
+		attribs[QString("pgsql" + vers.back()).remove(".")]=(vers.back()==curr_version ? curr_version : "");
 		vers.pop_back();
 	}
 }
 
-QString SchemaParser::getCodeDefinition(attribs_map &attribs)
+void SchemaParser::addTextInstruction(vector<SchemaInstruction> &instrs, const QString &text)
 {
-	QString object_def;
-	unsigned end_cnt, if_cnt;
-	int if_level, prev_if_level;
-	QString atrib, cond, prev_cond, word, meta, str_aux;
-	bool error, if_expr;
+	//Consecutive texts are merged in a single instruction
+	if(!instrs.empty() && instrs.back().type==INS_TEXT)
+		instrs.back().value+=text;
+	else
+	{
+		SchemaInstruction instr;
+		instr.type=INS_TEXT;
+		instr.value=text;
+		instr.line=line;
+		instr.column=column;
+		instrs.push_back(instr);
+	}
+}
+
+void SchemaParser::compileBuffer(SchemaTemplate &schema_tmpl)
+{
+	QString cond, prev_cond, word, meta, str_aux;
+	vector<SchemaInstruction *> cond_stack;
+	vector<bool> else_stack;
+	vector<SchemaInstruction> *instrs=nullptr;
+	SchemaInstruction instr;
+	bool error=false;
 	char chr;
-	vector<bool> vet_expif, vet_tk_if, vet_tk_then, vet_tk_else;
-	map<int, vector<QString> > if_map, else_map;
-	vector<QString>::iterator itr, itr_end;
-	vector<int> vet_prev_level;
-	vector<QString> *vet_aux;
-
-	//In case the file was successfuly loaded
-	if(buffer.size() > 0)
+
+	schema_tmpl.filename=filename;
+	schema_tmpl.comment_count=comment_count;
+	schema_tmpl.instructions.clear();
+
+	while(line < buffer.size())
 	{
-		//Init the control variables
-		attributes=attribs;
-		error=if_expr=false;
-		if_level=-1;
-		end_cnt=if_cnt=0;
+		/* Selects the instruction list that receives the extracted elements: the template itself
+		 when outside conditionals or the 'if' / 'else' sections of the current conditional.
+		 The conditionals on the stack are never moved while opened since new instructions are only
+		 appended to the innermost one */
+		if(cond_stack.empty())
+			instrs=&schema_tmpl.instructions;
+		else if(else_stack.back())
+			instrs=&cond_stack.back()->else_part;
+		else
+			instrs=&cond_stack.back()->if_part;
 
-		while(line < buffer.size())
+		chr=buffer[line][column].toLatin1();
+		switch(chr)
 		{
-			chr=buffer[line][column].toLatin1();
-			switch(chr)
-			{
-				/* Increments the number of rows causing the parser
-				to get the next line buffer for analysis */
-				case CHR_LINE_END:
-					line++;
-					column=0;
-				break;
-
-				case CHR_TABULATION:
-				case CHR_SPACE:
-					//The parser will ignore the spaces that are not within pure texts
-					while(buffer[line][column]==CHR_SPACE ||
-								buffer[line][column]==CHR_TABULATION) column++;
-				break;
-
-					//Metacharacter extraction
-				case CHR_INI_METACHAR:
-					meta=getMetaCharacter();
-
-					//Checks whether the extracted token is valid metacharacter
-					if(meta!=TOKEN_META_SP && meta!=TOKEN_META_TB &&
-						 meta!=TOKEN_META_BR && meta!=TOKEN_META_OB &&
-						 meta!=TOKEN_META_CB)
-					{
-						str_aux=QString(Exception::getErrorMessage(ERR_INV_METACHARACTER))
-										.arg(meta).arg(filename).arg(line + comment_count +1).arg(column+1);
+			/* Increments the number of rows causing the parser
+			to get the next line buffer for analysis */
+			case CHR_LINE_END:
+				line++;
+				column=0;
+			break;
+
+			case CHR_TABULATION:
+			case CHR_SPACE:
+				//The parser will ignore the spaces that are not within pure texts
+				while(buffer[line][column]==CHR_SPACE ||
+							buffer[line][column]==CHR_TABULATION) column++;
+			break;
+
+				//Metacharacter extraction
+			case CHR_INI_METACHAR:
+				meta=getMetaCharacter();
+
+				//Checks whether the extracted token is valid metacharacter
+				if(meta!=TOKEN_META_SP && meta!=TOKEN_META_TB &&
+					 meta!=TOKEN_META_BR && meta!=TOKEN_META_OB &&
+					 meta!=TOKEN_META_CB)
+				{
+					str_aux=QString(Exception::getErrorMessage(ERR_INV_METACHARACTER))
+									.arg(meta).arg(filename).arg(line + comment_count +1).arg(column+1);
 
+					throw Exception(str_aux,ERR_INV_METACHARACTER,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+				}
 
-						throw Exception(str_aux,ERR_INV_METACHARACTER,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-					}
-					//Checks whether the metacharacter is part of the  'if' expression (this is an error)
-					else if(if_level>=0 && vet_tk_if[if_level] && !vet_tk_then[if_level])
-					{
-						str_aux=QString(Exception::getErrorMessage(ERR_INVALID_SYNTAX))
-										.arg(filename).arg(line + comment_count +1).arg(column+1);
+				//Converting the metacharacter drawn to the character that represents this
+				if(meta==TOKEN_META_SP) chr=CHR_SPACE;
+				else if(meta==TOKEN_META_TB) chr=CHR_TABULATION;
+				else if(meta==TOKEN_META_OB) chr=CHR_INI_PURETEXT; //Currently this constant is used since it returns '[' (open bracket)
+				else if(meta==TOKEN_META_CB) chr=CHR_END_PURETEXT; //Currently this constant is used since it returns ']' (close bracket)
+				else chr=CHR_LINE_END;
+
+				addTextInstruction(*instrs, QString(QChar(chr)));
+			break;
+
+				//Attribute extraction
+			case CHR_INI_ATTRIB:
+			case CHR_MID_ATTRIB:
+			case CHR_END_ATTRIB:
+				instr=SchemaInstruction();
+				instr.type=INS_ATTRIBUTE;
+				instr.value=getAttribute();
+				instr.line=line;
+				instr.column=column;
+				instrs->push_back(instr);
+			break;
+
+				//Conditional instruction extraction
+			case CHR_INI_CONDITIONAL:
+				prev_cond=cond;
+				cond=getConditional();
+
+				//Checks whether the extracted token is a valid conditional
+				if(cond!=TOKEN_IF && cond!=TOKEN_ELSE &&
+					 cond!=TOKEN_THEN && cond!=TOKEN_END &&
+					 cond!=TOKEN_OR && cond!=TOKEN_NOT &&
+					 cond!=TOKEN_AND)
+				{
+					str_aux=QString(Exception::getErrorMessage(ERR_INV_CONDITIONAL))
+									.arg(cond).arg(filename).arg(line + comment_count +1).arg(column+1);
+					throw Exception(str_aux,ERR_INV_CONDITIONAL,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+				}
 
-						throw Exception(str_aux,ERR_INVALID_SYNTAX,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-					}
-					else
+				//If the token is an 'if' a new conditional is opened inside the current section
+				if(cond==TOKEN_IF)
+				{
+					instr=SchemaInstruction();
+					instr.type=INS_CONDITIONAL;
+					instr.line=line;
+					instr.column=column;
+					compileExpression(instr);
+
+					instrs->push_back(instr);
+					cond_stack.push_back(&instrs->back());
+					else_stack.push_back(false);
+				}
+				/* The 'then' token only separates the expression (already compiled together with the 'if')
+				 from the 'if' section, so only 'else' and 'end' changes the current conditional */
+				else if(!cond_stack.empty() &&
+								(cond==TOKEN_THEN || cond==TOKEN_ELSE || cond==TOKEN_END))
+				{
+					//The following elements will be placed on the 'else' section of the current conditional
+					if(cond==TOKEN_ELSE)
+						else_stack.back()=true;
+					//Closes the current conditional returning to the previous one (if any)
+					else if(cond==TOKEN_END)
 					{
-						//Converting the metacharacter drawn to the character that represents this
-						if(meta==TOKEN_META_SP) chr=CHR_SPACE;
-						else if(meta==TOKEN_META_TB) chr=CHR_TABULATION;
-						else if(meta==TOKEN_META_OB) chr=CHR_INI_PURETEXT; //Currently this constant is used since it returns '[' (open bracket)
-						else if(meta==TOKEN_META_CB) chr=CHR_END_PURETEXT; //Currently this constant is used since it returns ']' (close bracket)
-						else chr=CHR_LINE_END;
-
-						meta="";
-						meta+=chr;
-
-						//If the parser is inside an 'if / else' extracting tokens
-						if(if_level>=0)
-						{
-							/* If the parser is in 'if' section,
-								 places the metacharacter on the word map of the current 'if' */
-							if(vet_tk_if[if_level] &&
-								 vet_tk_then[if_level] &&
-								 !vet_tk_else[if_level])
-								if_map[if_level].push_back(meta);
-
-							/* If the parser is in 'else' section,
-								 places the metacharacter on the word map of the current 'else'*/
-							else if(vet_tk_else[if_level])
-								else_map[if_level].push_back(meta);
-						}
-						else
-							/* If the parsers is not in a 'if / else', puts the metacharacter
-								 in the definition sql */
-							object_def+=meta;
+						cond_stack.pop_back();
+						else_stack.pop_back();
 					}
+				}
+				else
+					error=true;
 
-				break;
+				if(!error)
+				{
+					/* Verifying that the conditional words appear in a valid  order if not
+					 the parser generates an error. Correct order means IF before THEN,
+					 ELSE after IF and before END */
+					if((prev_cond==TOKEN_IF && cond!=TOKEN_THEN) ||
+						 (prev_cond==TOKEN_ELSE && cond!=TOKEN_IF && cond!=TOKEN_END) ||
+						 (prev_cond==TOKEN_THEN && cond==TOKEN_THEN))
+						error=true;
+				}
 
-					//Attribute extraction
-				case CHR_INI_ATTRIB:
-				case CHR_MID_ATTRIB:
-				case CHR_END_ATTRIB:
-					atrib=getAttribute();
+				if(error)
+				{
+					str_aux=QString(Exception::getErrorMessage(ERR_INVALID_SYNTAX))
+									.arg(filename).arg(line + comment_count +1).arg(column+1);
+					throw Exception(str_aux,ERR_INVALID_SYNTAX,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+				}
+			break;
 
-					//Checks if the attribute extracted belongs to the passed list of attributes
-					if(attribs.count(atrib)==0)
-					{
-						if(!ignore_unk_atribs)
-						{
-							str_aux=QString(Exception::getErrorMessage(ERR_UNK_ATTRIBUTE))
-											.arg(atrib).arg(filename).arg((line + comment_count +1)).arg((column+1));
-							throw Exception(str_aux,ERR_UNK_ATTRIBUTE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-						}
-						else
-							attribs[atrib]="";
-					}
+				//Extraction of pure text or simple words
+			default:
+				if(chr==CHR_INI_PURETEXT ||
+					 chr==CHR_END_PURETEXT)
+					word=getPureText();
+				else
+					word=getWord();
 
-					//If the parser is inside an 'if / else' extracting tokens
-					if(if_level>=0)
-					{
-						//If the parser evaluated the 'if' conditional and is inside the current if block
-						if(!(!if_expr && vet_tk_if[if_level] && !vet_tk_then[if_level]))
-						{
-							word=atrib;
-							atrib="";
-							atrib+=CHR_INI_ATTRIB;
-							atrib+=CHR_MID_ATTRIB;
-							atrib+=word;
-							atrib+=CHR_END_ATTRIB;
-
-							//If the parser is in the 'if' section
-							if(vet_tk_if[if_level] &&
-								 vet_tk_then[if_level] &&
-								 !vet_tk_else[if_level])
-								//Inserts the attribute value in the map of the words of current the 'if' section
-								if_map[if_level].push_back(atrib);
-							else if(vet_tk_else[if_level])
-								//Inserts the attribute value in the map of the words of current the 'else' section
-								else_map[if_level].push_back(atrib);
-						}
-					}
-					else
-					{
-						/* If the attribute has no value set and parser must not ignore empty values
-						raises an exception */
-						if(attribs[atrib]=="" && !ignore_empty_atribs)
-						{
-							str_aux=QString(Exception::getErrorMessage(ERR_UNDEF_ATTRIB_VALUE))
-											.arg(atrib).arg(filename).arg(line + comment_count +1).arg(column+1);
-
-							throw Exception(str_aux,ERR_UNDEF_ATTRIB_VALUE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-						}
-
-						/* If the parser is not in an if / else, concatenates the value of the attribute
-							directly in definition in sql */
-						object_def+=attribs[atrib];
-					}
-				break;
-
-					//Conditional instruction extraction
-				case CHR_INI_CONDITIONAL:
-					prev_cond=cond;
-					cond=getConditional();
-
-					//Checks whether the extracted token is a valid conditional
-					if(cond!=TOKEN_IF && cond!=TOKEN_ELSE &&
-						 cond!=TOKEN_THEN && cond!=TOKEN_END &&
-						 cond!=TOKEN_OR && cond!=TOKEN_NOT &&
-						 cond!=TOKEN_AND)
-					{
-						str_aux=QString(Exception::getErrorMessage(ERR_INV_CONDITIONAL))
-										.arg(cond).arg(filename).arg(line + comment_count +1).arg(column+1);
-						throw Exception(str_aux,ERR_INV_CONDITIONAL,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-					}
-					else
-					{
-						//If the toke is an 'if'
-						if(cond==TOKEN_IF)
-						{
-							//Evaluates the if expression storing the result on the vector
-							if_expr=true;
-							vet_expif.push_back(evaluateExpression());
-
-							/* Inserts the value of the current 'if' level  in the previous 'if' levels vector.
-							 This vector is used to know which 'if' the parser was in before entering current if */
-							vet_prev_level.push_back(if_level);
-
-							/* Mark the flags indicating that an  'if' was found and a
-							 'then' and 'else' have not been found yet */
-							vet_tk_if.push_back(true);
-							vet_tk_then.push_back(false);
-							vet_tk_else.push_back(false);
-
-							//Defines the current if level as the size of list 'if' tokens found  -1
-							if_level=(vet_tk_if.size()-1);
-
-							//Increases the number of found 'if's
-							if_cnt++;
-						}
-						//If the parser is in 'if / else' and one 'then' token is found
-						else if(cond==TOKEN_THEN && if_level>=0)
-						{
-							//Marks the then thoke flag of the current 'if'
-							vet_tk_then[if_level]=true;
-
-							/* Clears the  expression extracted flag from the 'if - then',
-								 so that the parser does not generate an error when it encounters another
-								 'if - then' with an expression still unextracted */
-							if_expr=false;
-						}
-						//If the parser is in 'if / else' and a 'else' token is found
-						else if(cond==TOKEN_ELSE && if_level>=0)
-							//Mark the  o flag do token else do if atual
-							vet_tk_else[if_level]=true;
-						//Case the parser is in 'if/else' and a 'end' token was found
-						else if(cond==TOKEN_END && if_level>=0)
-						{
-							//Increments the number of 'end' tokes found
-							end_cnt++;
-
-							//Get the level of the previous 'if' where the parser was
-							prev_if_level=vet_prev_level[if_level];
-
-							//In case the current 'if' be internal (nested) (if_level > 0)
-							if(if_level > 0)
-							{
-								//In case the current 'if' doesn't in the 'else' section of the above 'if' (previous if level)
-								if(!vet_tk_else[prev_if_level])
-									//Get the extracted word vector on the above 'if'
-									vet_aux=&if_map[prev_if_level];
-								else
-									//Get the extracted word vector on the above 'else'
-									vet_aux=&else_map[prev_if_level];
-							}
-							else
-								vet_aux=nullptr;
-
-							/* Initializes the iterators to scan
-								 the auxiliary vector if necessary */
-							itr=itr_end=if_map[0].end();
-
-							/* In case the expression of the current 'if' has the value true
-								 then the parser will scan the list of words on the 'if' part of the
-								 current 'if' */
-							if(vet_expif[if_level])
-							{
-								itr=if_map[if_level].begin();
-								itr_end=if_map[if_level].end();
-							}
-							/* Caso a parte else do if atual exista
-								 então o parser varrerá a lista de palavras da parte else
-								 do if atual */
-
-							/* If there is a 'else' part on the current 'if'
-								 then the parser will scan the list of words on the 'else' part */
-							else if(else_map.count(if_level)>0)
-							{
-								itr=else_map[if_level].begin();
-								itr_end=else_map[if_level].end();
-							}
-
-							/* This iteration scans the list of words selected above
-								 inserting them in 'if' part  of the 'if' or 'else' superior to current.
-								 This is done so that only the words extracted based on
-								 ifs expressions of the buffer are embedded in defining sql */
-							while(itr!=itr_end)
-							{
-								//If the auxiliary vector is allocated, inserts the word on above 'if / else'
-								if(vet_aux)
-									vet_aux->push_back((*itr));
-								else
-								{
-									word=(*itr);
-
-									//Check if the work is not an attribute
-									if(word[0]==CHR_INI_ATTRIB)
-									{
-										/* If its an attribute, extracts the name and checks if the same
-										has empty value */
-										atrib=word.mid(2,word.size()-3);
-										word=attribs[atrib];
-
-										/* If the attribute has no value set and parser must not ignore empty values
-										raises an exception */
-										if(word=="" && !ignore_empty_atribs)
-										{
-											str_aux=QString(Exception::getErrorMessage(ERR_UNDEF_ATTRIB_VALUE))
-															.arg(atrib).arg(filename).arg(line + comment_count +1).arg(column+1);
-											throw Exception(str_aux,ERR_UNDEF_ATTRIB_VALUE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-										}
-									}
-
-									//Else, insert the work directly on the object definition
-									object_def+=word;
-								}
-								itr++;
-							}
-
-							//Case the current if is nested (internal)
-							if(if_level > 0)
-								//Causes the parser to return to the earlier 'if'
-								if_level=prev_if_level;
-
-							/* In case the 'if' be the uppermost (level 0) indicates that all
-								 the if's  has already been checked, so the parser will clear the
-								 used auxiliary structures*/
-							else
-							{
-								if_map.clear();
-								else_map.clear();
-								vet_tk_if.clear();
-								vet_tk_then.clear();
-								vet_tk_else.clear();
-								vet_expif.clear();
-								vet_prev_level.clear();
-
-								//Resets the ifs levels
-								if_level=prev_if_level=-1;
-							}
-						}
-						else
-							error=true;
-
-						if(!error)
-						{
-							/* Verifying that the conditional words appear in a valid  order if not
-							 the parser generates an error. Correct order means IF before THEN,
-							 ELSE after IF and before END */
-							if((prev_cond==TOKEN_IF && cond!=TOKEN_THEN) ||
-								 (prev_cond==TOKEN_ELSE && cond!=TOKEN_IF && cond!=TOKEN_END) ||
-								 (prev_cond==TOKEN_THEN && cond==TOKEN_THEN))
-								error=true;
-						}
-
-						if(error)
-						{
-							str_aux=QString(Exception::getErrorMessage(ERR_INVALID_SYNTAX))
-											.arg(filename).arg(line + comment_count +1).arg(column+1);
-							throw Exception(str_aux,ERR_INVALID_SYNTAX,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-						}
-					}
-				break;
+				addTextInstruction(*instrs, word);
+			break;
+		}
+	}
 
-					//Extraction of pure text or simple words
-				default:
-					if(chr==CHR_INI_PURETEXT ||
-						 chr==CHR_END_PURETEXT)
-						word=getPureText();
-					else
-						word=getWord();
+	/* If has more 'if' toknes than  'end' tokens, this indicates that some 'if' in code
+	was not closed thus the parser returns an error */
+	if(!cond_stack.empty())
+	{
+		str_aux=QString(Exception::getErrorMessage(ERR_INVALID_SYNTAX))
+						.arg(filename).arg(line + comment_count +1).arg(column+1);
+		throw Exception(str_aux,ERR_INVALID_SYNTAX,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+	}
+}
 
-					//Case the parser is in 'if/else'
-					if(if_level>=0)
-					{
-						/* In case the word/text be inside 'if' expression, the parser returns an error
-						 because only an attribute must be on the 'if' expression  */
-						if(vet_tk_if[if_level] && !vet_tk_then[if_level])
-						{
-							str_aux=QString(Exception::getErrorMessage(ERR_INVALID_SYNTAX))
-											.arg(filename).arg(line + comment_count +1).arg(column+1);
-							throw Exception(str_aux,ERR_INVALID_SYNTAX,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-						}
-						//Case the parser is in 'if' section
-						else if(vet_tk_if[if_level] &&
-										vet_tk_then[if_level] &&
-										!vet_tk_else[if_level])
-							//Inserts the word on the words map extracted on 'if' section
-							if_map[if_level].push_back(word);
-						else if(vet_tk_else[if_level])
-							//Inserts the word on the words map extracted on 'else' section
-							else_map[if_level].push_back(word);
-					}
-					else
-						//Case the parser is not in 'if/else' concatenates the word/text directly on the object definition
-						object_def+=word;
-				break;
+void SchemaParser::checkAttributes(const SchemaTemplate &schema_tmpl, const vector<SchemaInstruction> &instrs, attribs_map &attribs)
+{
+	vector<SchemaInstruction>::const_iterator itr=instrs.begin();
+	vector<SchemaExprTerm>::const_iterator term_itr;
+	QString str_aux;
+
+	while(itr!=instrs.end())
+	{
+		if(itr->type==INS_ATTRIBUTE && attribs.count(itr->value)==0)
+		{
+			if(!ignore_unk_atribs)
+			{
+				str_aux=QString(Exception::getErrorMessage(ERR_UNK_ATTRIBUTE))
+								.arg(itr->value).arg(schema_tmpl.filename)
+								.arg(itr->line + schema_tmpl.comment_count + 1).arg(itr->column + 1);
+				throw Exception(str_aux,ERR_UNK_ATTRIBUTE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+			}
+			else
+				attribs[itr->value]="";
+		}
+		else if(itr->type==INS_CONDITIONAL)
+		{
+			//Attributes used only on expressions are not created when unknown
+			for(term_itr=itr->expression.begin(); term_itr!=itr->expression.end(); term_itr++)
+			{
+				if(attribs.count(term_itr->attribute)==0 && !ignore_unk_atribs)
+				{
+					str_aux=QString(Exception::getErrorMessage(ERR_UNK_ATTRIBUTE))
+									.arg(term_itr->attribute).arg(schema_tmpl.filename)
+									.arg(term_itr->line + schema_tmpl.comment_count + 1).arg(term_itr->column + 1);
+					throw Exception(str_aux,ERR_UNK_ATTRIBUTE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+				}
 			}
+
+			checkAttributes(schema_tmpl, itr->if_part, attribs);
+			checkAttributes(schema_tmpl, itr->else_part, attribs);
 		}
 
-		/* If has more 'if' toknes than  'end' tokens, this indicates that some 'if' in code
-		was not closed thus the parser returns an error */
-		if(if_cnt!=end_cnt)
+		itr++;
+	}
+}
+
+void SchemaParser::evaluateInstructions(const SchemaTemplate &schema_tmpl, const vector<SchemaInstruction> &instrs,
+																				attribs_map &attribs, QString &code_def)
+{
+	vector<SchemaInstruction>::const_iterator itr=instrs.begin();
+	QString str_aux;
+
+	while(itr!=instrs.end())
+	{
+		if(itr->type==INS_TEXT)
+			code_def+=itr->value;
+		else if(itr->type==INS_ATTRIBUTE)
 		{
-			str_aux=QString(Exception::getErrorMessage(ERR_INVALID_SYNTAX))
-							.arg(filename).arg(line + comment_count +1).arg(column+1);
-			throw Exception(str_aux,ERR_INVALID_SYNTAX,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+			/* If the attribute has no value set and parser must not ignore empty values
+			raises an exception */
+			if(attribs[itr->value].isEmpty() && !ignore_empty_atribs)
+			{
+				str_aux=QString(Exception::getErrorMessage(ERR_UNDEF_ATTRIB_VALUE))
+								.arg(itr->value).arg(schema_tmpl.filename)
+								.arg(itr->line + schema_tmpl.comment_count + 1).arg(itr->column + 1);
+				throw Exception(str_aux,ERR_UNDEF_ATTRIB_VALUE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+			}
+
+			code_def+=attribs[itr->value];
 		}
+		//Only the section selected by the expression is evaluated
+		else if(evaluateExpression(itr->expression, attribs))
+			evaluateInstructions(schema_tmpl, itr->if_part, attribs, code_def);
+		else
+			evaluateInstructions(schema_tmpl, itr->else_part, attribs, code_def);
+
+		itr++;
 	}
+}
+
+QString SchemaParser::evaluateTemplate(const SchemaTemplate &schema_tmpl, attribs_map &attribs)
+{
+	QString object_def;
 
+	checkAttributes(schema_tmpl, schema_tmpl.instructions, attribs);
+	evaluateInstructions(schema_tmpl, schema_tmpl.instructions, attribs, object_def);
 
-	restartParser();
 	ignore_unk_atribs=false;
 	ignore_empty_atribs=false;
 	return(object_def);
 }
 
+QString SchemaParser::getCodeDefinition(attribs_map &attribs)
+{
+	SchemaParser &parser=getParser();
+	SchemaTemplate schema_tmpl;
+
+	//Compiles the loaded buffer (if any) and generates the code from it
+	if(parser.buffer.size() > 0)
+		parser.compileBuffer(schema_tmpl);
+
+	restartParser();
+	return(parser.evaluateTemplate(schema_tmpl, attribs));
+}
+
 QString SchemaParser::getCodeDefinition(const QString &filename, attribs_map &attribs)
 {
 	try
 	{
-		loadFile(filename);
+		SchemaParser &parser=getParser();
+		shared_ptr<const SchemaTemplate> tmpl;
+		shared_ptr<SchemaTemplate> new_tmpl;
+		map<QString, shared_ptr<const SchemaTemplate> >::iterator itr;
+		QString version;
+		bool use_cache;
+
+		{
+			QMutexLocker locker(&cache_mutex);
+
+			version=pgsql_version;
+			use_cache=cache_templates;
+
+			if(use_cache)
+			{
+				itr=templates[version].find(filename);
+
+				if(itr!=templates[version].end())
+					tmpl=itr->second;
+			}
+		}
+
+		/* Loads and compiles the file when it isn't cached. The compilation is done outside the
+		 lock since it uses only the calling thread's parser */
+		if(!tmpl)
+		{
+			new_tmpl=make_shared<SchemaTemplate>();
+			loadFile(filename);
+			parser.compileBuffer(*new_tmpl);
+			restartParser();
+			tmpl=new_tmpl;
+
+			if(use_cache)
+			{
+				QMutexLocker locker(&cache_mutex);
+
+				//Discards the template if the version changed meanwhile (the cache was dropped)
+				if(version==pgsql_version)
+					templates[version][filename]=tmpl;
+			}
+		}
+
 		storePgSQLVersion(attribs);
-		return(getCodeDefinition(attribs));
+		return(parser.evaluateTemplate(*tmpl, attribs));
 	}
 	catch(Exception &e)
 	{
 		throw Exception(e.getErrorMessage(),e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 	}
 }
-
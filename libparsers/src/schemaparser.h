@@ -19,6 +19,8 @@
 /**
 \ingroup libparsers
 \brief ParserEsquema class definition used to create SQL definition for model objects from schemas files (stored on disk).
+\note The parsing state (buffer, position and ignore flags) is stored on instances and each thread uses its own instance
+ behind the static API. The compiled templates and the PostgreSQL version are shared between threads.
 \note <strong>Creation date:</strong> 19/06/2008
 */
 
@@ -31,18 +33,53 @@
 #include <vector>
 #include <QDir>
 #include <QTextStream>
+#include <QThreadStorage>
+#include <QMutex>
+#include <memory>
 #include "xmlparser.h"
 #include "attribsmap.h"
 
+/*! \brief Term of a compiled conditional expression. The 'oper' attribute stores the token (%and / %or)
+ that joins the term to the result of the previous terms (empty for the first one) */
+struct SchemaExprTerm {
+	QString attribute, oper;
+	bool negate;
+	unsigned line, column;
+};
+
+/*! \brief Compiled instruction of a schema file. Words, pure texts and metacharacters are stored as
+ text instructions, attributes references as attribute instructions and %if %then %else %end blocks as
+ conditional instructions which holds the compiled expression and the instructions of each section */
+struct SchemaInstruction {
+	unsigned type;
+	QString value;
+	unsigned line, column;
+	vector<SchemaExprTerm> expression;
+	vector<SchemaInstruction> if_part, else_part;
+};
+
+//! \brief Compiled representation of a schema file (or buffer) ready to be evaluated
+struct SchemaTemplate {
+	QString filename;
+	unsigned comment_count;
+	vector<SchemaInstruction> instructions;
+};
+
 class SchemaParser {
 	private:
+		//! \brief Stores the parser instance of each thread (see getParser())
+		static QThreadStorage<SchemaParser *> parsers;
+
+		//! \brief Serializes the access to the compiled templates cache and the PostgreSQL version
+		static QMutex cache_mutex;
+
 		/*! \brief Indicates that the parser should ignore unknown
 		 attributes avoiding raising exceptions */
-		static bool ignore_unk_atribs;
+		bool ignore_unk_atribs;
 
 		/*! \brief Indicates that the parser should ignore empty
 		 attributes avoiding raising exceptions */
-		static bool ignore_empty_atribs;
+		bool ignore_empty_atribs;
 
 		static const char CHR_COMMENT,			//! \brief Character that starts a comment
 											CHR_LINE_END,			//! \brief Character that indicates end of line
@@ -74,16 +111,17 @@ class SchemaParser {
 
 
 		//! \brief Get an attribute name from the buffer on the current position
-		static QString getAttribute(void);
+		QString getAttribute(void);
 
 		//! \brief Get an conditional instruction from the buffer on the current position
-		static QString getConditional(void);
+		QString getConditional(void);
 
 		//! \brief Get an metacharacter from the buffer on the current position
-		static QString getMetaCharacter(void);
+		QString getMetaCharacter(void);
 
-		/*! \brief Returns the result (true|false) of conditional expression evaluation.
-		The expression is evaluated from the left to the right and not support Polish Notation, so
+		/*! \brief Compiles the conditional expression placed between %if and %then into the passed
+		instruction. The parser is positioned right before the %then token at the end of the process.
+		The compiled expression is evaluated from the left to the right and not support Polish Notation, so
 		as the parser finds an attribute evaluates it and stores the result, when find another one
 		evaluates and compare with previous evaluation, and so on. Example:
 
@@ -95,17 +133,38 @@ class SchemaParser {
 				%if @{a1} %or %not @{a3} %then --> TRUE
 				%if @{a1} %and @{a3} %then --> FALSE
 		*/
-		static bool evaluateExpression(void);
+		void compileExpression(SchemaInstruction &cond_instr);
+
+		//! \brief Returns the result (true|false) of a compiled conditional expression
+		static bool evaluateExpression(const vector<SchemaExprTerm> &expression, attribs_map &attribs);
+
+		/*! \brief Compiles the whole buffer (see loadBuffer()) into the passed template. Syntax errors are
+		 raised at this moment so the compiled template can be evaluated several times without reparsing */
+		void compileBuffer(SchemaTemplate &schema_tmpl);
+
+		/*! \brief Checks if all attributes referenced by the instructions exists on the attributes map
+		 raising errors for unknown attributes (or creating them empty when ignore_unk_atribs is set) */
+		void checkAttributes(const SchemaTemplate &schema_tmpl, const vector<SchemaInstruction> &instrs, attribs_map &attribs);
+
+		//! \brief Appends to 'code_def' the code generated by the compiled instructions
+		void evaluateInstructions(const SchemaTemplate &schema_tmpl, const vector<SchemaInstruction> &instrs,
+																		 attribs_map &attribs, QString &code_def);
+
+		//! \brief Appends a text to the instruction list merging it with the last instruction when it is a text too
+		void addTextInstruction(vector<SchemaInstruction> &instrs, const QString &text);
+
+		//! \brief Generates the code of a compiled template using the provided attributes
+		QString evaluateTemplate(const SchemaTemplate &schema_tmpl, attribs_map &attribs);
 
     //! brief Increments the column counter while blank chars (space and tabs) are found on the line
-    static void ignoreBlankChars(const QString &line);
+    void ignoreBlankChars(const QString &line);
 
 		/*! \brief Get an word from the buffer on the current position (word is any string that isn't
 		 a conditional instruction or comment) */
-		static QString getWord(void);
+		QString getWord(void);
 
 		//! \brief Gets a pure text, ignoring elements of the language
-		static QString getPureText(void);
+		QString getPureText(void);
 
 		/*! \brief Returns whether a character is special i.e. indicators of attributes
 		 or conditional instructions */
@@ -116,19 +175,25 @@ class SchemaParser {
 		static QString convertCharsToXMLEntities(QString buf);
 
 		//! \brief Filename that was loaded by the parser
-		static QString filename;
+		QString filename;
 
 		/*! \brief Vectorial representation of the loaded file. This is the buffer that is
 		 analyzed by de parser */
-		static vector<QString> buffer;
+		vector<QString> buffer;
 
-		static unsigned line, //! \brief Current line where the parser reading is
-										column, //! \brief Current column where the parser reading is
-										/*! \brief Comment line ammout extracted. This attribute is used to make the correct
-										 reference to the line on file that has syntax errors */
-										comment_count;
+		unsigned line, //! \brief Current line where the parser reading is
+						 column, //! \brief Current column where the parser reading is
+						 /*! \brief Comment line ammout extracted. This attribute is used to make the correct
+							reference to the line on file that has syntax errors */
+						 comment_count;
 
-		static attribs_map attributes;
+		/*! \brief Compiled templates cache shared by all threads. The first key is the PostgreSQL version and the
+		second one is the schema file path. The whole cache is dropped when the PostgreSQL version changes. Templates
+		are stored as shared pointers so a template being evaluated by a thread remains valid even if the cache is dropped */
+		static map<QString, map<QString, shared_ptr<const SchemaTemplate> > > templates;
+
+		//! \brief Indicates if the compiled templates must be cached (enabled by default)
+		static bool cache_templates;
 
 		//! \brief PostgreSQL version currently used by the parser
 		static QString pgsql_version;
@@ -137,6 +202,11 @@ class SchemaParser {
 		parser is configured */
 		static void storePgSQLVersion(attribs_map &attribs);
 
+		SchemaParser(void);
+
+		//! \brief Returns the parser instance of the calling thread creating it if necessary
+		static SchemaParser &getParser(void);
+
 	public:
 
 		//! \brief Constants used to refernce PostgreSQL versions.
@@ -145,6 +215,11 @@ class SchemaParser {
 												 PGSQL_VERSION_92,
 												 PGSQL_VERSION_93;
 
+		//! \brief Constants used to identify the type of a compiled instruction
+		static const unsigned INS_TEXT=0,
+															INS_ATTRIBUTE=1,
+															INS_CONDITIONAL=2;
+
 		//! \brief Constants used to get a specific object definition
     static const unsigned SQL_DEFINITION=0,
 															XML_DEFINITION=1;
@@ -186,6 +261,17 @@ class SchemaParser {
 		//! \brief Resets the parser in order to do new analysis
 		static void restartParser(void);
 
+		/*! \brief Enables or disables the compiled templates cache. When disabled, every call to
+		 getCodeDefinition(filename, attribs) loads and compiles the schema file again. Disabling the cache
+		 also drops all compiled templates */
+		static void setTemplateCacheEnabled(bool value);
+
+		//! \brief Returns if the compiled templates cache is enabled
+		static bool isTemplateCacheEnabled(void);
+
+		//! \brief Drops all the compiled templates forcing the schema files to be reloaded
+		static void clearTemplateCache(void);
+
 		//! \brief Set if the parser must ignore unknown attributes avoiding expcetion throwing
 		static void setIgnoreUnkownAttributes(bool ignore);
 
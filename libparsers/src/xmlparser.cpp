@@ -18,14 +18,23 @@
 
 #include "xmlparser.h"
 
-QString XMLParser::xml_doc_filename="";
-QString XMLParser::xml_buffer="";
-QString XMLParser::dtd_decl="";
-QString XMLParser::xml_decl="";
-xmlNode *XMLParser::root_elem=nullptr;
-xmlNode *XMLParser::curr_elem=nullptr;
-xmlDoc *XMLParser::xml_doc=nullptr;
-stack<xmlNode*> XMLParser::elems_stack;
+QThreadStorage<XMLParser *> XMLParser::parsers;
+map<QString, xmlDtd *> XMLParser::dtd_cache;
+QMutex XMLParser::dtd_mutex;
+QAtomicInt XMLParser::dtd_load_count;
+
+//Releases the cached DTDs when the static objects of the application are destroyed
+class DTDCacheReleaser {
+	public:
+		~DTDCacheReleaser(void)
+		{
+			XMLParser::clearDTDCache();
+		}
+};
+
+/* Declared after the DTD cache so it is destroyed before the cache (the static objects
+	 of a translation unit are destroyed in the reverse order of their definition) */
+static DTDCacheReleaser dtd_cache_releaser;
 
 const QString XMLParser::CHAR_AMP="&amp;";
 const QString XMLParser::CHAR_LT="&lt;";
@@ -35,13 +44,26 @@ const QString XMLParser::CHAR_APOS="&apos;";
 
 XMLParser::XMLParser(void)
 {
-  xmlInitParser();
+	xml_doc=nullptr;
+	xml_reader=nullptr;
+	root_elem=curr_elem=nullptr;
+	xmlInitParser();
 }
 
 XMLParser::~XMLParser(void)
 {
-	restartParser();
-  xmlCleanupParser();
+	/* The libxml2 global state is not cleaned up here (xmlCleanupParser) since
+	 other threads can still be using their parsers */
+	resetParser();
+}
+
+XMLParser &XMLParser::getParser(void)
+{
+	//The instance is destroyed by QThreadStorage when the thread finishes
+	if(!parsers.hasLocalData())
+		parsers.setLocalData(new XMLParser);
+
+	return(*parsers.localData());
 }
 
 void XMLParser::removeDTD(void)
@@ -87,7 +109,7 @@ void XMLParser::loadXMLFile(const QString &filename)
 			buffer=input.readAll();
 			input.close();
 
-			xml_doc_filename=filename;
+			getParser().xml_doc_filename=filename;
 			loadXMLBuffer(buffer);
 		}
 	}
@@ -101,6 +123,7 @@ void XMLParser::loadXMLBuffer(const QString &xml_buf)
 {
 	try
 	{
+		XMLParser &parser=getParser();
 		int pos1=-1, pos2=-1, tam=0;
 
 		if(xml_buf.isEmpty())
@@ -108,19 +131,19 @@ void XMLParser::loadXMLBuffer(const QString &xml_buf)
 
 		pos1=xml_buf.indexOf("<?xml");
 		pos2=xml_buf.indexOf("?>");
-		xml_buffer=xml_buf;
+		parser.xml_buffer=xml_buf;
 
 		if(pos1 >= 0 && pos2 >= 0)
 		{
 			tam=(pos2-pos1)+3;
-			xml_decl=xml_buffer.mid(pos1, tam);
-			xml_buffer.replace(pos1,tam,"");
+			parser.xml_decl=parser.xml_buffer.mid(pos1, tam);
+			parser.xml_buffer.replace(pos1,tam,"");
 		}
 		else
-			xml_decl="<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+			parser.xml_decl="<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
 
-		removeDTD();
-		readBuffer();
+		parser.removeDTD();
+		parser.readBuffer();
 	}
 	catch(Exception &e)
 	{
@@ -128,6 +151,160 @@ void XMLParser::loadXMLBuffer(const QString &xml_buf)
 	}
 }
 
+void XMLParser::openXMLFile(const QString &filename)
+{
+	XMLParser &parser=getParser();
+	QByteArray head;
+	QString dtd_decl=parser.dtd_decl, dtd_filename=parser.dtd_filename, dtd_name=parser.dtd_name;
+	int pos=-1, root_pos=-1, tam=0, parser_opt, ret=0;
+
+	//Releases the previous document keeping the configured DTD
+	parser.resetParser();
+	parser.dtd_decl=dtd_decl;
+	parser.dtd_filename=dtd_filename;
+	parser.dtd_name=dtd_name;
+
+	parser.xml_file.setFileName(filename);
+	parser.xml_file.open(QFile::ReadOnly);
+
+	if(!parser.xml_file.isOpen())
+		throw Exception(QString(Exception::getErrorMessage(ERR_FILE_DIR_NOT_ACCESSED)).arg(filename),
+										ERR_FILE_DIR_NOT_ACCESSED,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	//Reads the document's prolog (the contents before the root element)
+	while(root_pos < 0 && !parser.xml_file.atEnd())
+	{
+		head+=parser.xml_file.read(4096);
+
+		for(pos=head.indexOf('<'); pos >= 0 && pos < head.size()-1 && root_pos < 0; pos=head.indexOf('<', pos+1))
+		{
+			if(isalpha(head.at(pos+1)) || head.at(pos+1)=='_')
+				root_pos=pos;
+		}
+	}
+
+	if(root_pos < 0)
+		root_pos=head.size();
+
+	if(head.trimmed().isEmpty())
+	{
+		parser.resetParser();
+		throw Exception(ERR_ASG_EMPTY_XML_BUFFER,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+	}
+
+	//Replaces the xml and DTD declarations of the prolog in the same way loadXMLBuffer() does
+	parser.xml_buffer=QString::fromUtf8(head.left(root_pos));
+	pos=parser.xml_buffer.indexOf("<?xml");
+	tam=parser.xml_buffer.indexOf("?>");
+
+	if(pos >= 0 && tam >= 0)
+	{
+		tam=(tam-pos)+3;
+		parser.xml_decl=parser.xml_buffer.mid(pos, tam);
+		parser.xml_buffer.replace(pos,tam,"");
+	}
+	else
+		parser.xml_decl="<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+
+	parser.removeDTD();
+
+	parser_opt=( XML_PARSE_NOBLANKS | XML_PARSE_NONET | XML_PARSE_NOENT );
+	parser.stream_head=parser.xml_decl.toUtf8();
+
+	/* The reader validates the elements as they are read so it loads the DTD by itself instead
+	 of using the cached one (this happens only once per file) */
+	if(!parser.dtd_decl.isEmpty())
+	{
+		parser.stream_head+=parser.dtd_decl.toUtf8();
+		parser_opt=(parser_opt | XML_PARSE_DTDLOAD | XML_PARSE_DTDVALID);
+		dtd_load_count.ref();
+	}
+
+	parser.stream_head+=parser.xml_buffer.toUtf8() + head.mid(root_pos);
+	parser.xml_buffer.clear();
+	parser.xml_doc_filename=filename;
+
+	parser.xml_reader=xmlReaderForIO(readStream, nullptr, &parser, nullptr, nullptr, parser_opt);
+
+	//Positioning the reader on the root element
+	do
+	{
+		ret=xmlTextReaderRead(parser.xml_reader);
+	}
+	while(ret==1 && xmlTextReaderNodeType(parser.xml_reader)!=XML_READER_TYPE_ELEMENT);
+
+	if(ret!=1 || xmlGetLastError())
+		parser.raiseParserError(xmlGetLastError());
+
+	parser.root_elem=parser.curr_elem=xmlTextReaderCurrentNode(parser.xml_reader);
+}
+
+bool XMLParser::readNextElement(void)
+{
+	XMLParser &parser=getParser();
+	int ret=0;
+	xmlNode *node=nullptr;
+
+	if(!parser.xml_reader)
+		throw Exception(ERR_OPR_NOT_ALOC_ELEM_TREE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	parser.root_elem=parser.curr_elem=nullptr;
+
+	while(!parser.elems_stack.empty())
+		parser.elems_stack.pop();
+
+	/* Enters the root element on the first call, otherwise skips the subtree of the
+	 previous element, which is released by the reader */
+	if(xmlTextReaderDepth(parser.xml_reader)==0)
+		ret=xmlTextReaderRead(parser.xml_reader);
+	else
+		ret=xmlTextReaderNext(parser.xml_reader);
+
+	while(ret==1 && (xmlTextReaderDepth(parser.xml_reader)!=1 ||
+									 xmlTextReaderNodeType(parser.xml_reader)!=XML_READER_TYPE_ELEMENT))
+		ret=xmlTextReaderNext(parser.xml_reader);
+
+	if(ret==1)
+		node=xmlTextReaderExpand(parser.xml_reader);
+
+	if(ret < 0 || (ret==1 && !node) || xmlGetLastError())
+		parser.raiseParserError(xmlGetLastError());
+
+	//The read element becomes the root of the element tree
+	parser.root_elem=parser.curr_elem=node;
+	return(node!=nullptr);
+}
+
+int XMLParser::readStream(void *context, char *buffer, int len)
+{
+	XMLParser *parser=reinterpret_cast<XMLParser *>(context);
+	int size=0;
+
+	//The document's head is sent to the reader before the remaining contents of the file
+	if(!parser->stream_head.isEmpty())
+	{
+		size=qMin(len, parser->stream_head.size());
+		memcpy(buffer, parser->stream_head.constData(), size);
+		parser->stream_head.remove(0, size);
+	}
+	else
+		size=static_cast<int>(parser->xml_file.read(buffer, len));
+
+	return(size);
+}
+
+qint64 XMLParser::getStreamPosition(void)
+{
+	XMLParser &parser=getParser();
+	return(parser.xml_file.isOpen() ? parser.xml_file.pos() : 0);
+}
+
+qint64 XMLParser::getStreamSize(void)
+{
+	XMLParser &parser=getParser();
+	return(parser.xml_file.isOpen() ? parser.xml_file.size() : 0);
+}
+
 void XMLParser::setDTDFile(const QString &dtd_file, const QString &dtd_name)
 {
 	QString fmt_dtd_file;
@@ -145,14 +322,15 @@ void XMLParser::setDTDFile(const QString &dtd_file, const QString &dtd_name)
 	#endif
 
 	//Formats the dtd file path in order to replace spaces by %20 (url format)
-	fmt_dtd_file+=QFileInfo(dtd_file).absoluteFilePath();
-	dtd_decl="<!DOCTYPE " + dtd_name + " SYSTEM " + "\"" +  fmt_dtd_file.replace(QString(" "),QString("%20")) + "\">\n";
+	getParser().dtd_name=dtd_name;
+	getParser().dtd_filename=QFileInfo(dtd_file).absoluteFilePath();
+	fmt_dtd_file+=getParser().dtd_filename;
+	getParser().dtd_decl="<!DOCTYPE " + dtd_name + " SYSTEM " + "\"" +  fmt_dtd_file.replace(QString(" "),QString("%20")) + "\">\n";
 }
 
 void XMLParser::readBuffer(void)
 {
 	QByteArray buffer;
-	QString msg, file;
 	xmlError *xml_error=nullptr;
 	int parser_opt;
 
@@ -161,124 +339,223 @@ void XMLParser::readBuffer(void)
 		//Inserts the XML declaration
 		buffer+=xml_decl;
 
-		//Configures the parser, initially, to not validate the document against the dtd
+		/* The document is not validated while parsed (which would read the DTD files again for each buffer),
+		 instead it is validated afterwards against the cached DTD (see validateDocument()) */
 		parser_opt=( XML_PARSE_NOBLANKS | XML_PARSE_NONET | XML_PARSE_NOENT );
-
-		//If the dtd declarions is setup
-		if(!dtd_decl.isEmpty())
-		{
-			//Inserts the default software DTD declarion into XML buffer
-			buffer+=dtd_decl;
-
-			//Now configures the parser to validate the buffer against the DTD
-			parser_opt=(parser_opt | XML_PARSE_DTDLOAD | XML_PARSE_DTDVALID);
-		}
-
 		buffer+=xml_buffer;
 
 		//Create an xml document from the buffer
 		xml_doc=xmlReadMemory(buffer.data(), buffer.size(),	nullptr, nullptr, parser_opt);
 
-		//In case the document criation fails, gets the last xml parser error
+		//In case the document criation fails, gets the last xml parser error (libxml2 stores it per thread)
 		xml_error=xmlGetLastError();
 
 		//If some error is set
 		if(xml_error)
-		{
-			//Formats the error
-			msg=xml_error->message;
-			file=xml_error->file;
-			if(!file.isEmpty()) file="("+file+")";
-			msg.replace("\n"," ");
-
-			//Restarts the parser
-			if(xml_doc) restartParser();
-
-			//Raise an exception with the error massege from the parser xml
-			throw Exception(QString(Exception::getErrorMessage(ERR_LIBXMLERR))
-											.arg(xml_error->line).arg(xml_error->int2).arg(msg).arg(file),
-											ERR_LIBXMLERR,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-		}
+			raiseParserError(xml_error);
+
+		if(!dtd_filename.isEmpty())
+			validateDocument();
 
 		//Gets the referênce to the root element on the document
 		root_elem=curr_elem=xmlDocGetRootElement(xml_doc);
 	}
 }
 
+void XMLParser::validateDocument(void)
+{
+	xmlValidCtxt *valid_ctxt=nullptr;
+	xmlDtd *dtd=nullptr;
+	xmlNode *root=xmlDocGetRootElement(xml_doc);
+	QString root_name;
+	int valid=0;
+
+	/* The cached DTDs are parsed without a name so the validation against them doesn't check the root element,
+		 which is done here like the validation made while parsing with the DTD declaration does */
+	if(root)
+		root_name=QString::fromUtf8(reinterpret_cast<const char *>(root->name));
+
+	if(root_name!=dtd_name)
+	{
+		resetParser();
+		throw Exception(QString(Exception::getErrorMessage(ERR_LIBXMLERR))
+										.arg(root ? root->line : 0).arg(0)
+										.arg(QString("root and DTD name do not match '%1' and '%2'").arg(root_name).arg(dtd_name))
+										.arg(QString()),
+										ERR_LIBXMLERR,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+	}
+
+	QMutexLocker locker(&dtd_mutex);
+
+	if(dtd_cache.count(dtd_filename))
+		dtd=dtd_cache[dtd_filename];
+	else
+	{
+		QByteArray dtd_file=dtd_filename.toUtf8();
+
+		dtd=xmlParseDTD(nullptr, reinterpret_cast<const xmlChar *>(dtd_file.constData()));
+		dtd_load_count.ref();
+
+		if(!dtd)
+		{
+			locker.unlock();
+			raiseParserError(xmlGetLastError());
+		}
+
+		dtd_cache[dtd_filename]=dtd;
+	}
+
+	//The validation errors are retrieved through xmlGetLastError() instead of being printed
+	valid_ctxt=xmlNewValidCtxt();
+	valid_ctxt->error=nullptr;
+	valid_ctxt->warning=nullptr;
+	valid=xmlValidateDtd(valid_ctxt, xml_doc, dtd);
+	xmlFreeValidCtxt(valid_ctxt);
+	locker.unlock();
+
+	if(!valid)
+		raiseParserError(xmlGetLastError());
+}
+
+void XMLParser::clearDTDCache(void)
+{
+	QMutexLocker locker(&dtd_mutex);
+
+	for(auto &itr : dtd_cache)
+		xmlFreeDtd(itr.second);
+
+	dtd_cache.clear();
+}
+
+unsigned XMLParser::getDTDLoadCount(void)
+{
+	return(dtd_load_count.load());
+}
+
+void XMLParser::raiseParserError(xmlError *xml_error)
+{
+	QString msg, file;
+	int line=0, column=0;
+
+	//Formats the error
+	if(xml_error)
+	{
+		msg=xml_error->message;
+		file=xml_error->file;
+		line=xml_error->line;
+		column=xml_error->int2;
+		if(!file.isEmpty()) file="("+file+")";
+		msg.replace("\n"," ");
+	}
+
+	//Restarts the parser
+	resetParser();
+
+	//Raise an exception with the error massege from the parser xml
+	throw Exception(QString(Exception::getErrorMessage(ERR_LIBXMLERR))
+									.arg(line).arg(column).arg(msg).arg(file),
+									ERR_LIBXMLERR,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+}
+
 void XMLParser::savePosition(void)
 {
-	if(!root_elem)
+	XMLParser &parser=getParser();
+
+	if(!parser.root_elem)
 		throw Exception(ERR_OPR_NOT_ALOC_ELEM_TREE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-	elems_stack.push(curr_elem);
+	parser.elems_stack.push(parser.curr_elem);
 }
 
 void XMLParser::restorePosition(void)
 {
-	if(!root_elem)
+	XMLParser &parser=getParser();
+
+	if(!parser.root_elem)
 		throw Exception(ERR_OPR_NOT_ALOC_ELEM_TREE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-	if(elems_stack.empty())
-		curr_elem=root_elem;
+	if(parser.elems_stack.empty())
+		parser.curr_elem=parser.root_elem;
 	else
 	{
-		curr_elem=elems_stack.top();
-		elems_stack.pop();
+		parser.curr_elem=parser.elems_stack.top();
+		parser.elems_stack.pop();
 	}
 }
 
 void XMLParser::restorePosition(const xmlNode *elem)
 {
+	XMLParser &parser=getParser();
+
 	if(!elem)
 		throw Exception(ERR_OPR_NOT_ALOC_ELEMENT,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-	else if(elem->doc!=xml_doc)
+	else if(elem->doc!=(parser.xml_reader && parser.root_elem ? parser.root_elem->doc : parser.xml_doc))
 		throw Exception(ERR_OPR_INEXIST_ELEMENT,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
 	restartNavigation();
-	curr_elem=const_cast<xmlNode *>(elem);
+	parser.curr_elem=const_cast<xmlNode *>(elem);
 }
 
 void XMLParser::restartNavigation(void)
 {
-	if(!root_elem)
+	XMLParser &parser=getParser();
+
+	if(!parser.root_elem)
 		throw Exception(ERR_OPR_NOT_ALOC_ELEM_TREE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-	curr_elem=root_elem;
+	parser.curr_elem=parser.root_elem;
 
-	while(!elems_stack.empty())
-		elems_stack.pop();
+	while(!parser.elems_stack.empty())
+		parser.elems_stack.pop();
 }
 
-void XMLParser::restartParser(void)
+void XMLParser::resetParser(void)
 {
 	root_elem=curr_elem=nullptr;
 
-  if(xml_doc)
+	if(xml_doc)
 	{
 		xmlFreeDoc(xml_doc);
 		xml_doc=nullptr;
 	}
-	dtd_decl=xml_buffer=xml_decl="";
+
+	if(xml_reader)
+	{
+		xmlFreeTextReader(xml_reader);
+		xml_reader=nullptr;
+	}
+
+	if(xml_file.isOpen())
+		xml_file.close();
+
+	stream_head.clear();
+	dtd_decl=dtd_filename=dtd_name=xml_buffer=xml_decl="";
 
 	while(!elems_stack.empty())
 		elems_stack.pop();
 
 	xml_doc_filename="";
-  xmlResetLastError();
+	xmlResetLastError();
+}
+
+void XMLParser::restartParser(void)
+{
+	getParser().resetParser();
 }
 
 bool XMLParser::accessElement(unsigned elem_type)
 {
+	XMLParser &parser=getParser();
 	bool has_elem;
 	xmlNode *elems[4];
 
-	if(!root_elem)
+	if(!parser.root_elem)
 		throw Exception(ERR_OPR_NOT_ALOC_ELEM_TREE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-	elems[ROOT_ELEMENT]=curr_elem->parent;
-	elems[CHILD_ELEMENT]=curr_elem->children;
-	elems[NEXT_ELEMENT]=curr_elem->next;
-	elems[PREVIOUS_ELEMENT]=curr_elem->prev;
+	elems[ROOT_ELEMENT]=parser.curr_elem->parent;
+	elems[CHILD_ELEMENT]=parser.curr_elem->children;
+	elems[NEXT_ELEMENT]=parser.curr_elem->next;
+	elems[PREVIOUS_ELEMENT]=parser.curr_elem->prev;
 
 	/* Checks whether the current element has the element that
 		is to  be accessed. The flag 'has_elem' is also used
@@ -287,88 +564,104 @@ bool XMLParser::accessElement(unsigned elem_type)
 	has_elem=hasElement(elem_type);
 
 	if(has_elem)
-		curr_elem=elems[elem_type];
+		parser.curr_elem=elems[elem_type];
 
 	return(has_elem);
 }
 
 bool XMLParser::hasElement(unsigned tipo_elem)
 {
-	if(!root_elem)
+	XMLParser &parser=getParser();
+
+	if(!parser.root_elem)
 		throw Exception(ERR_OPR_NOT_ALOC_ELEM_TREE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-	if(tipo_elem==ROOT_ELEMENT)
+	/* When reading a file element by element the siblings of the current root
+	 element are not available (see readNextElement()) */
+	if(parser.xml_reader && parser.curr_elem==parser.root_elem &&
+		 (tipo_elem==NEXT_ELEMENT || tipo_elem==PREVIOUS_ELEMENT))
+		return(false);
+	else if(tipo_elem==ROOT_ELEMENT)
 		/* Returns the verification if the current element has a parent.
 		 The element must be different from the root, because the root element
 		 is not connected to a parent */
-		return(curr_elem!=root_elem && curr_elem->parent!=nullptr);
+		return(parser.curr_elem!=parser.root_elem && parser.curr_elem->parent!=nullptr);
 	else if(tipo_elem==CHILD_ELEMENT)
 		//Returns the verification if the current element has children
-		return(curr_elem->children!=nullptr);
+		return(parser.curr_elem->children!=nullptr);
 	else if(tipo_elem==NEXT_ELEMENT)
-		return(curr_elem->next!=nullptr);
+		return(parser.curr_elem->next!=nullptr);
 	else
 		/* The second comparison in the expression is made for the root element
 		 because libxml2 places the previous element as the root itself */
-		return(curr_elem->prev!=nullptr && curr_elem->prev!=root_elem);
+		return(parser.curr_elem->prev!=nullptr && parser.curr_elem->prev!=parser.root_elem);
 }
 
 bool XMLParser::hasAttributes(void)
 {
-	if(!root_elem)
+	XMLParser &parser=getParser();
+
+	if(!parser.root_elem)
 		throw Exception(ERR_OPR_NOT_ALOC_ELEM_TREE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-	return(curr_elem->properties!=nullptr);
+	return(parser.curr_elem->properties!=nullptr);
 }
 
 QString XMLParser::getElementContent(void)
 {
-	if(!root_elem)
+	XMLParser &parser=getParser();
+
+	if(!parser.root_elem)
 		throw Exception(ERR_OPR_NOT_ALOC_ELEM_TREE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
 	/* If the current element has  <![CDATA[]]> node returns the content of the CDATA instead
 	of return the content of the element itself */
-	if(curr_elem->next && curr_elem->next->type == XML_CDATA_SECTION_NODE)
-		return(QString(reinterpret_cast<char *>(curr_elem->next->content)));
+	if(parser.curr_elem->next && parser.curr_elem->next->type == XML_CDATA_SECTION_NODE)
+		return(QString(reinterpret_cast<char *>(parser.curr_elem->next->content)));
 	else
 		//Return the content of the element when is not a CDATA node
-		return(QString(reinterpret_cast<char *>(curr_elem->content)));
+		return(QString(reinterpret_cast<char *>(parser.curr_elem->content)));
 }
 
 QString XMLParser::getElementName(void)
 {
-	if(!root_elem)
+	XMLParser &parser=getParser();
+
+	if(!parser.root_elem)
 		throw Exception(ERR_OPR_NOT_ALOC_ELEM_TREE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-	return(QString(reinterpret_cast<const char *>(curr_elem->name)));
+	return(QString(reinterpret_cast<const char *>(parser.curr_elem->name)));
 }
 
 xmlElementType XMLParser::getElementType(void)
 {
-	if(!root_elem)
+	XMLParser &parser=getParser();
+
+	if(!parser.root_elem)
 		throw Exception(ERR_OPR_NOT_ALOC_ELEM_TREE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-	return(curr_elem->type);
+	return(parser.curr_elem->type);
 }
 
 const xmlNode *XMLParser::getCurrentElement(void)
 {
-	return(curr_elem);
+	return(getParser().curr_elem);
 }
 
 void XMLParser::getElementAttributes(attribs_map &attributes)
 {
+	XMLParser &parser=getParser();
 	xmlAttr *elem_attribs=nullptr;
 	QString attrib, value;
 
-	if(!root_elem)
+	if(!parser.root_elem)
 		throw Exception(ERR_OPR_NOT_ALOC_ELEM_TREE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
 	//Always clears the passed attributes maps
 	attributes.clear();
 
 	//Gets the references to the element properties
-	elem_attribs=curr_elem->properties;
+	elem_attribs=parser.curr_elem->properties;
 
 	while(elem_attribs)
 	{
@@ -388,30 +681,33 @@ void XMLParser::getElementAttributes(attribs_map &attributes)
 
 QString XMLParser::getLoadedFilename(void)
 {
-	return(xml_doc_filename);
+	return(getParser().xml_doc_filename);
 }
 
 QString XMLParser::getXMLBuffer(void)
 {
-	return(xml_buffer);
+	return(getParser().xml_buffer);
 }
 
 int XMLParser::getCurrentBufferLine(void)
 {
-	if(curr_elem)
-		return(curr_elem->line);
+	XMLParser &parser=getParser();
+
+	if(parser.curr_elem)
+		return(parser.curr_elem->line);
 	else
 		return(0);
 }
 
 int XMLParser::getBufferLineCount(void)
 {
-	if(xml_doc)
+	XMLParser &parser=getParser();
+
+	if(parser.xml_doc)
 		/* To get the very last line of the document is necessary to call
 		the last element of the last because xml_doc->last->line stores the
 		last line of the root element */
-		return(xml_doc->last->last->line);
+		return(parser.xml_doc->last->last->line);
 	else
 		return(0);
 }
-
@@ -20,6 +20,8 @@
 \ingroup libparsers
 \class XMLParser
 \brief This class implements basic operations of a xml analyzer encapsulating some functions implemented by libxml2 library
+\note The parser state (document, navigation position and buffers) is stored on instances and each thread uses its own
+ instance behind the static API, so distinct threads can load and navigate through different documents at the same time.
 \note <strong>Creation date:</strong> 02/04/2008
 */
 
@@ -28,52 +30,106 @@
 
 #include <libxml/parser.h>
 #include <libxml/tree.h>
+#include <libxml/xmlreader.h>
+#include <libxml/valid.h>
+#include <QFile>
 #include "schemaparser.h"
 #include "exception.h"
 #include <stack>
+#include <QThreadStorage>
+#include <QMutex>
+#include <QAtomicInt>
+#include <map>
 #include <iostream>
 #include "attribsmap.h"
 
 using namespace std;
 
-
 class XMLParser {
 	private:
+		//! \brief Stores the parser instance of each thread (see getParser())
+		static QThreadStorage<XMLParser *> parsers;
+
+		/*! \brief Stores the DTDs already parsed (the key is the DTD file path). The DTDs are shared by
+		 all the parser instances so the DTD files are read only once no matter how many buffers are validated.
+		 The cached DTDs are released at application shutdown (see clearDTDCache()) */
+		static map<QString, xmlDtd *> dtd_cache;
+
+		//! \brief Serializes the access to the DTD cache and the validations made against the cached DTDs
+		static QMutex dtd_mutex;
+
+		//! \brief Amount of times a DTD was read from the disk (see getDTDLoadCount())
+		static QAtomicInt dtd_load_count;
+
+		//! \brief Path to the DTD file configured by setDTDFile()
+		QString dtd_filename,
+
+		//! \brief Name of the DTD configured by setDTDFile() which must match the document's root element name
+		dtd_name;
+
 		/*! \brief Stores the name of the file that generated the xml buffer when
 		 loadXMLFile() method is called */
-		static QString xml_doc_filename;
+		QString xml_doc_filename;
 
 		//! \brief Stores the xml document (element tree) generated after the buffer reading
-		static xmlDoc *xml_doc;
+		xmlDoc *xml_doc;
+
+		/*! \brief Reader used to parse the file opened by openXMLFile(). In this mode the
+		 element tree contains only the element returned by readNextElement() */
+		xmlTextReader *xml_reader;
+
+		//! \brief File read by the xml reader (see openXMLFile())
+		QFile xml_file;
+
+		/*! \brief Stores the document's head (xml and DTD declarations) to be sent
+		 to the xml reader before the contents of the file */
+		QByteArray stream_head;
 
 		//! \brief Stores the reference to the root element of the element tree
-		static xmlNode	*root_elem,
-										//! \brief Stores the current element that parser is analyzing
-										*curr_elem;
+		xmlNode	*root_elem,
+						//! \brief Stores the current element that parser is analyzing
+						*curr_elem;
 
 		/*! \brief Stores the elements that marks the position in the tree before do
 		 a subsequent operation. To configure this element it is necessary
 		 call the method savePosition() and to return the navigation to the saved
 		 position is necessary call restorePosition() */
-		static stack<xmlNode *> elems_stack;
+		stack<xmlNode *> elems_stack;
 
 		//! \brief Stores the document DTD declaration
-		static QString	dtd_decl,
-										//! \brief Stores XML document to be analyzed
-										xml_buffer,
-										/*! \brief Stores the declaration <?xml?>. If this isn't exists it will be
-										 a default declaration. */
-										xml_decl;
+		QString	dtd_decl,
+						//! \brief Stores XML document to be analyzed
+						xml_buffer,
+						/*! \brief Stores the declaration <?xml?>. If this isn't exists it will be
+						 a default declaration. */
+						xml_decl;
+
+		XMLParser(void);
+
+		//! \brief Returns the parser instance of the calling thread creating it if necessary
+		static XMLParser &getParser(void);
 
 		/*! \brief Remove the original DTD from the document. This is done to evit that
 		 the user insert some external dtd in the model file that is not valid for pgModeler */
-		static void removeDTD(void);
+		void removeDTD(void);
 
 		/*! \brief Makes the interpretation of XML inside the buffer validating it according to
 		 DTD defined configured (by the parser) to the buffer. Initializes
 		 the necessary attributes to make possible the navigation through the element tree
 		 generated from the XML document read. */
-		static void readBuffer(void);
+		void readBuffer(void);
+
+		//! \brief Releases the element tree and resets the instance's attributes
+		void resetParser(void);
+
+		//! \brief Raises an exception containing the last error of the libxml2 parser
+		void raiseParserError(xmlError *xml_error);
+
+		//! \brief Validates the loaded document against the DTD file configured, parsing the DTD only on its first use
+		void validateDocument(void);
+
+		//! \brief Sends the document's head and the file contents to the xml reader (see openXMLFile())
+		static int readStream(void *context, char *buffer, int len);
 
 	public:
 		//! \brief Constants used to referência the elements on the element tree
@@ -88,7 +144,6 @@ class XMLParser {
 		static const QString CHAR_QUOT; //! \brief  < = &quot;
 		static const QString CHAR_APOS; //! \brief  < = &apos;
 
-		XMLParser(void);
 		~XMLParser(void);
 
 		//! \brief Loads the XML buffer from a file
@@ -97,9 +152,34 @@ class XMLParser {
 		//! \brief Loads the XML buffer from a string
 		static void loadXMLBuffer(const QString &xml_buf);
 
+		/*! \brief Opens a XML file to be read element by element without loading the whole document in memory.
+		 The navigation is positioned on the root element (only its attributes are available) and the children of
+		 the root are retrieved with readNextElement(). The document is validated while it is read when a DTD file
+		 is configured (see setDTDFile()) */
+		static void openXMLFile(const QString &filename);
+
+		/*! \brief Reads the next child of the root element of the file opened by openXMLFile(). The element
+		 (and its children) becomes the root of the element tree releasing the previous one. Returns false
+		 when there are no more elements to be read */
+		static bool readNextElement(void);
+
+		//! \brief Returns the amount of bytes already read from the file opened by openXMLFile()
+		static qint64 getStreamPosition(void);
+
+		//! \brief Returns the size of the file opened by openXMLFile()
+		static qint64 getStreamSize(void);
+
 		//! \brief Informs the DTD file used to make element validations
 		static void setDTDFile(const QString &dtd_file, const QString &dtd_name);
 
+		//! \brief Releases the cached DTDs. The next validations will read the DTD files again
+		static void clearDTDCache(void);
+
+		/*! \brief Returns the amount of times a DTD file (including the ones it includes) was read from the disk
+		 since the application started. The buffers are validated against cached DTDs so this number grows only
+		 when a new DTD is used or when a file is read element by element (see openXMLFile()) */
+		static unsigned getDTDLoadCount(void);
+
 		//! \brief Saves to stack the current navigation position on the element tree
 		static void savePosition(void);
 
@@ -10,6 +10,9 @@ LIBS += $$PGSQL_LIB \
 	$$DESTDIR/$$LIBPGMODELER \
 	$$DESTDIR/$$LIBPARSERS
 
+#Winsock is used to wait for the commands results (select)
+windows:LIBS += -lws2_32
+
 HEADERS += src/resultset.h \
 	   src/connection.h \
 	   src/catalog.h
@@ -24,6 +24,76 @@ const QString Catalog::PGSQL_TRUE="t";
 const QString Catalog::PGSQL_FALSE="f";
 const QString Catalog::BOOL_FIELD="_bool";
 
+/* Converts the tuples streamed by a catalog query into attributes maps in the same way
+	 Catalog::changeAttributeNames() does and passes each map to the attributes handler.
+	 The attributes names are translated once for all tuples */
+class CatalogAttributesHandler: public TupleHandler {
+	private:
+		ObjectType obj_type;
+		ObjectAttributesHandler *attr_handler;
+		QStringList attr_names;
+		vector<bool> bool_fields;
+
+	public:
+		CatalogAttributesHandler(ObjectType obj_type, ObjectAttributesHandler &attr_handler)
+		{
+			this->obj_type=obj_type;
+			this->attr_handler=&attr_handler;
+		}
+
+		void handleTuple(ResultSet &res)
+		{
+			attribs_map tuple;
+			QString attr_name;
+			char *value=nullptr;
+			int col_cnt=res.getColumnCount();
+
+			if(attr_names.isEmpty())
+			{
+				for(int col=0; col < col_cnt; col++)
+				{
+					attr_name=res.getColumnName(col);
+					bool_fields.push_back(attr_name.endsWith(Catalog::BOOL_FIELD));
+					attr_name.remove(Catalog::BOOL_FIELD);
+					attr_names.push_back(attr_name.replace("_","-"));
+				}
+			}
+
+			for(int col=0; col < col_cnt; col++)
+			{
+				value=res.getColumnValue(col);
+
+				if(!bool_fields[col])
+					tuple[attr_names[col]]=value;
+				else
+					tuple[attr_names[col]]=(value==Catalog::PGSQL_FALSE ? "" : "1");
+			}
+
+			/* Insert the object type as an attribute of the query result to facilitate the
+			import process on the classes that uses the Catalog */
+			tuple[ParsersAttributes::OBJECT_TYPE]=QString("%1").arg(obj_type);
+			attr_handler->handleAttributes(tuple);
+		}
+};
+
+//Stores the attributes of all the retrieved objects (used by the methods that return the attributes at once)
+class ObjectAttributesCollector: public ObjectAttributesHandler {
+	private:
+		vector<attribs_map> *obj_attribs;
+
+	public:
+		ObjectAttributesCollector(vector<attribs_map> &obj_attribs)
+		{
+			this->obj_attribs=&obj_attribs;
+		}
+
+		void handleAttributes(attribs_map &attribs)
+		{
+			obj_attribs->push_back(attribs_map());
+			obj_attribs->back().swap(attribs);
+		}
+};
+
 map<ObjectType, QString> Catalog::oid_fields=
 { {OBJ_DATABASE, "oid"}, {OBJ_ROLE, "oid"}, {OBJ_SCHEMA,"oid"},
 	{OBJ_LANGUAGE, "oid"}, {OBJ_TABLESPACE, "oid"}, {OBJ_EXTENSION, "ex.oid"},
@@ -38,8 +108,9 @@ map<ObjectType, QString> Catalog::oid_fields=
 Catalog::Catalog(void)
 {
 	exclude_sys_objs=exclude_ext_objs=true;
-	list_only_sys_objs=false;
+	list_only_sys_objs=exclude_array_types=false;
 	last_sys_oid=0;
+	query_count=0;
 }
 
 void Catalog::setConnection(Connection &conn)
@@ -64,6 +135,8 @@ void Catalog::setConnection(Connection &conn)
 
 		//Retrieving the list of objects created by extensions
 		this->connection.executeDMLCommand("SELECT objid AS oid FROM pg_depend WHERE objid > 0 AND refobjid > 0 AND deptype='e'", res);
+		query_count++;
+
 		if(res.accessTuple(ResultSet::FIRST_TUPLE))
 		{
 			do
@@ -112,7 +185,83 @@ bool Catalog::isExtensionObject(unsigned oid)
 	return(ext_obj_oids.contains(QString::number(oid)));
 }
 
-void Catalog::executeCatalogQuery(const QString &qry_type, ObjectType obj_type, ResultSet &result, bool single_result, attribs_map attribs)
+QString Catalog::exportSnapshot(void)
+{
+	try
+	{
+		ResultSet res;
+		QString snapshot_id;
+
+		connection.executeDDLCommand("BEGIN TRANSACTION ISOLATION LEVEL REPEATABLE READ");
+		query_count++;
+
+		try
+		{
+			connection.executeDMLCommand("SELECT pg_export_snapshot() AS snapshot", res);
+			query_count++;
+
+			if(res.accessTuple(ResultSet::FIRST_TUPLE))
+				snapshot_id=res.getColumnValue("snapshot");
+		}
+		catch(Exception &e)
+		{
+			//Finishing the transaction when the snapshot can't be exported (e.g. PostgreSQL 9.1 or below)
+			connection.executeDDLCommand("ROLLBACK");
+			query_count++;
+			throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+		}
+
+		return(snapshot_id);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void Catalog::importSnapshot(const QString &snapshot_id)
+{
+	try
+	{
+		connection.executeDDLCommand("BEGIN TRANSACTION ISOLATION LEVEL REPEATABLE READ");
+		connection.executeDDLCommand(QString("SET TRANSACTION SNAPSHOT '%1'").arg(snapshot_id));
+		query_count+=2;
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void Catalog::endTransaction(void)
+{
+	try
+	{
+		connection.executeDDLCommand("COMMIT");
+		query_count++;
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void Catalog::cancelQuery(void)
+{
+	connection.cancelCommand();
+}
+
+unsigned Catalog::getQueryCount(void)
+{
+	return(query_count);
+}
+
+void Catalog::resetQueryCount(void)
+{
+	query_count=0;
+}
+
+QString Catalog::getCatalogQuery(const QString &qry_type, ObjectType obj_type, bool single_result, attribs_map attribs)
 {
 	try
 	{
@@ -150,7 +299,33 @@ void Catalog::executeCatalogQuery(const QString &qry_type, ObjectType obj_type,
 			sql+=" LIMIT 1";
 		}
 
-		connection.executeDMLCommand(sql, result);
+		return(sql);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void Catalog::executeCatalogQuery(const QString &qry_type, ObjectType obj_type, ResultSet &result, bool single_result, attribs_map attribs)
+{
+	try
+	{
+		connection.executeDMLCommand(getCatalogQuery(qry_type, obj_type, single_result, attribs), result);
+		query_count++;
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void Catalog::executeCatalogQuery(const QString &qry_type, ObjectType obj_type, TupleHandler &handler, attribs_map attribs)
+{
+	try
+	{
+		connection.executeDMLCommand(getCatalogQuery(qry_type, obj_type, false, attribs), handler);
+		query_count++;
 	}
 	catch(Exception &e)
 	{
@@ -235,28 +410,26 @@ vector<attribs_map> Catalog::getMultipleAttributes(ObjectType obj_type, attribs_
 {
 	try
 	{
-		ResultSet res;
-		attribs_map tuple;
 		vector<attribs_map> obj_attribs;
+		ObjectAttributesCollector collector(obj_attribs);
 
-		executeCatalogQuery(QUERY_ATTRIBS, obj_type, res, false, extra_attribs);
-		if(res.accessTuple(ResultSet::FIRST_TUPLE))
-		{
-			do
-			{
-				tuple=changeAttributeNames(res.getTupleValues());
-
-				/* Insert the object type as an attribute of the query result to facilitate the
-				import process on the classes that uses the Catalog */
-				tuple[ParsersAttributes::OBJECT_TYPE]=QString("%1").arg(obj_type);
+		getMultipleAttributes(obj_type, collector, extra_attribs);
+		return(obj_attribs);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
 
-				obj_attribs.push_back(tuple);
-				tuple.clear();
-			}
-			while(res.accessTuple(ResultSet::NEXT_TUPLE));
-		}
+void Catalog::getMultipleAttributes(ObjectType obj_type, ObjectAttributesHandler &handler, attribs_map extra_attribs)
+{
+	try
+	{
+		CatalogAttributesHandler tuple_handler(obj_type, handler);
 
-		return(obj_attribs);
+		//The tuples are converted and handed over as they arrive so the whole result isn't held in memory
+		executeCatalogQuery(QUERY_ATTRIBS, obj_type, tuple_handler, extra_attribs);
 	}
 	catch(Exception &e)
 	{
@@ -340,6 +513,15 @@ QString Catalog::createOidFilter(const vector<unsigned> &oids)
 }
 
 vector<attribs_map> Catalog::getObjectsAttributes(ObjectType obj_type, const QString &schema, const QString &table, const vector<unsigned> &filter_oids, attribs_map extra_attribs)
+{
+	vector<attribs_map> obj_attribs;
+	ObjectAttributesCollector collector(obj_attribs);
+
+	getObjectsAttributes(obj_type, collector, schema, table, filter_oids, extra_attribs);
+	return(obj_attribs);
+}
+
+void Catalog::getObjectsAttributes(ObjectType obj_type, ObjectAttributesHandler &handler, const QString &schema, const QString &table, const vector<unsigned> &filter_oids, attribs_map extra_attribs)
 {
 	try
 	{
@@ -355,7 +537,7 @@ vector<attribs_map> Catalog::getObjectsAttributes(ObjectType obj_type, const QSt
 		if(!TableObject::isTableObject(obj_type))
 			extra_attribs[ParsersAttributes::COMMENT]=getCommentQuery(oid_fields[obj_type], is_shared_obj);
 
-		return(getMultipleAttributes(obj_type, extra_attribs));
+		getMultipleAttributes(obj_type, handler, extra_attribs);
 	}
 	catch(Exception &e)
 	{
@@ -363,3 +545,23 @@ vector<attribs_map> Catalog::getObjectsAttributes(ObjectType obj_type, const QSt
 										QApplication::translate("Catalog","Object type: %1","", -1).arg(BaseObject::getSchemaName(obj_type)));
 	}
 }
+
+void Catalog::operator = (Catalog &catalog)
+{
+	try
+	{
+		this->ext_obj_oids=catalog.ext_obj_oids;
+		this->last_sys_oid=catalog.last_sys_oid;
+		this->exclude_sys_objs=catalog.exclude_sys_objs;
+		this->exclude_ext_objs=catalog.exclude_ext_objs;
+		this->exclude_array_types=catalog.exclude_array_types;
+		this->list_only_sys_objs=catalog.list_only_sys_objs;
+		this->query_count=0;
+		this->connection=catalog.connection;
+		this->connection.connect();
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
@@ -32,6 +32,17 @@ This class is the basis for the reverse engineering feature.
 #include <QTextStream>
 #include <QApplication>
 
+/*! \brief Interface implemented by the classes that consume the objects attributes retrieved by
+ Catalog::getObjectsAttributes(ObjectType, ObjectAttributesHandler &, ...) */
+class ObjectAttributesHandler {
+	public:
+		virtual ~ObjectAttributesHandler(void) {}
+
+		/*! \brief Receives the attributes of each object as soon as its tuple arrives from the server. The attributes
+		are discarded after the call so they can be swapped by the handler instead of being copied */
+		virtual void handleAttributes(attribs_map &attribs)=0;
+};
+
 class Catalog {
 	private:
 		static const QString QUERY_LIST,	//! \brief Executes a list command on catalog
@@ -55,6 +66,9 @@ class Catalog {
 		//! \brief Stores the last system object identifier. This is used to filter system objects
 		unsigned last_sys_oid;
 
+		//! \brief Stores the amount of queries (round trips) executed on the catalog since the last counter reset
+		unsigned query_count;
+
 		//! \brief Indicates if the catalog must filter system objects
 		bool exclude_sys_objs,
 
@@ -73,6 +87,12 @@ class Catalog {
 		void executeCatalogQuery(const QString &qry_type, ObjectType obj_type, ResultSet &result,
                                  bool single_result=false, attribs_map attribs=attribs_map());
 
+		//! \brief Executes a query on the catalog streaming the returned tuples to the handler (see Connection::executeDMLCommand())
+		void executeCatalogQuery(const QString &qry_type, ObjectType obj_type, TupleHandler &handler, attribs_map attribs=attribs_map());
+
+		//! \brief Returns the catalog query code for the specified object type (see executeCatalogQuery())
+		QString getCatalogQuery(const QString &qry_type, ObjectType obj_type, bool single_result, attribs_map attribs);
+
 		/*! \brief Recreates the attribute map in such way that attribute names that have
 		underscores have this char replaced by dashes. Another special operation made is to replace
 		the values of fiels which suffix is _bool to '1' when 't' and to empty when 'f', this is because
@@ -124,6 +144,28 @@ class Catalog {
 		//! \brief Returns if the specified oid is amongst the extension created objects' oids
 		bool isExtensionObject(unsigned oid);
 
+		/*! \brief Starts a repeatable read transaction on the catalog connection and exports its snapshot returning the
+		snapshot identifier. Other catalogs can use the identifier in importSnapshot() in order to see the same data.
+		The transaction stays open until endTransaction() is called (requires PostgreSQL 9.2 or above) */
+		QString exportSnapshot(void);
+
+		/*! \brief Starts a repeatable read transaction on the catalog connection using the snapshot exported by
+		another catalog. The transaction stays open until endTransaction() is called */
+		void importSnapshot(const QString &snapshot_id);
+
+		//! \brief Finishes the transaction started by exportSnapshot() or importSnapshot()
+		void endTransaction(void);
+
+		/*! \brief Requests the cancellation of the query being executed by the catalog. This method is intended
+		to be called from a thread other than the one running the query, which raises an error when cancelled */
+		void cancelQuery(void);
+
+		//! \brief Returns the amount of queries executed on the catalog since the last call to resetQueryCount()
+		unsigned getQueryCount(void);
+
+		//! \brief Resets the executed queries counter
+		void resetQueryCount(void);
+
 		/*! \brief Returns the count for the specified object type. A schema name can be specified
 		in order to filter only objects of the specifed schema */
 		unsigned getObjectCount(ObjectType obj_type, const QString &sch_name="", const QString &tab_name="", attribs_map extra_attribs=attribs_map());
@@ -135,10 +177,25 @@ class Catalog {
 		//! \brief Returns a set of multiple attributes (several tuples) for the specified object type
 		vector<attribs_map> getMultipleAttributes(ObjectType obj_type, attribs_map extra_attribs=attribs_map());
 
+		/*! \brief Passes the attributes of each tuple retrieved for the specified object type to the handler as soon as
+		the tuple arrives, so the whole result is never held in memory */
+		void getMultipleAttributes(ObjectType obj_type, ObjectAttributesHandler &handler, attribs_map extra_attribs=attribs_map());
+
 		/*! \brief Retrieve all available objects attributes for the specified type. Internally this method calls the get method for the
 		specified type. User can filter items by oids (except for table child objects), by schema (in the object type is suitable to accept schema)
 		and by table name (only when retriving child objects for a specific table) */
 		vector<attribs_map> getObjectsAttributes(ObjectType obj_type, const QString &schema="", const QString &table="", const vector<unsigned> &filter_oids={}, attribs_map extra_attribs=attribs_map());
+
+		/*! \brief Retrieves the objects attributes in the same way as the method above but each object's attributes are passed
+		to the handler as soon as they arrive from the server instead of being returned all at once */
+		void getObjectsAttributes(ObjectType obj_type, ObjectAttributesHandler &handler, const QString &schema="", const QString &table="", const vector<unsigned> &filter_oids={}, attribs_map extra_attribs=attribs_map());
+
+		/*! \brief Copies the connection parameters, the filter and the system/extension objects information from the
+		specified catalog and opens a new connection to the same database. This is used to create additional catalog
+		connections without querying again the information retrieved by setConnection() */
+		void operator = (Catalog &catalog);
+
+	friend class CatalogAttributesHandler;
 };
 
 #endif
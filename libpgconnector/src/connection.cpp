@@ -18,6 +18,12 @@
 
 #include "connection.h"
 
+#ifdef Q_OS_WIN
+	#include <winsock2.h>
+#else
+	#include <sys/select.h>
+#endif
+
 const QString Connection::SSL_DESABLE="disable";
 const QString Connection::SSL_ALLOW="allow";
 const QString Connection::SSL_PREFER="prefer";
@@ -42,14 +48,19 @@ const QString Connection::PARAM_LIB_GSSAPI="gsslib";
 
 bool Connection::notice_enabled=false;
 bool Connection::print_sql=false;
+QMutex Connection::cancel_mutex;
 
 Connection::Connection(void)
 {
 	connection=nullptr;
+	cmd_timeout=0;
 }
 
 Connection::Connection(const QString &server_fqdn, const QString &port, const QString &user, const QString &passwd, const QString &db_name)
 {
+	connection=nullptr;
+	cmd_timeout=0;
+
 	//Configures the basic connection params
 	setConnectionParam(PARAM_SERVER_FQDN, server_fqdn);
 	setConnectionParam(PARAM_PORT, port);
@@ -128,6 +139,16 @@ bool Connection::isSQLPrinted(void)
 	return(print_sql);
 }
 
+void Connection::setCommandTimeout(int msecs)
+{
+	cmd_timeout=(msecs > 0 ? msecs : 0);
+}
+
+int Connection::getCommandTimeout(void)
+{
+	return(cmd_timeout);
+}
+
 void Connection::connect(void)
 {
 	/* If the connection string is not established indicates that the user
@@ -196,6 +217,17 @@ bool Connection::isStablished(void)
 	return(connection!=nullptr);
 }
 
+bool Connection::isTransactionOpen(void)
+{
+	PGTransactionStatusType status;
+
+	if(!connection)
+		return(false);
+
+	status=PQtransactionStatus(connection);
+	return(status==PQTRANS_INTRANS || status==PQTRANS_INERROR);
+}
+
 QString  Connection::getPgSQLVersion(void)
 {
 	QString version;
@@ -211,31 +243,188 @@ QString  Connection::getPgSQLVersion(void)
 				 .arg(version.mid(4,1).toInt()));
 }
 
-void Connection::executeDMLCommand(const QString &sql, ResultSet &result)
+PGresult *Connection::executeCommand(const QString &sql, TupleHandler *handler)
 {
-	ResultSet *new_res=nullptr;
-	PGresult *sql_res=nullptr;
+	PGresult *sql_res=nullptr, *next_res=nullptr;
+	QElapsedTimer elapsed;
+	QString sql_state;
+	Exception error;
+	bool timed_out=false, failed=false;
 
-	//Raise an error in case the user try to close a not opened connection
+	//Raise an error in case the user try to execute a command in a not opened connection
 	if(!connection)
 		throw Exception(ERR_OPR_NOT_ALOC_CONN, __PRETTY_FUNCTION__, __FILE__, __LINE__);
 
-	//Alocates a new result to receive the resultset returned by the sql command
-	sql_res=PQexec(connection, sql.toStdString().c_str());
-
 	//Prints the SQL to stdout when the flag is active
 	if(print_sql)
 		cout << "\n---\n" << sql.toStdString() << endl;
 
+	if(!PQsendQuery(connection, sql.toStdString().c_str()))
+	{
+		throw Exception(QString(Exception::getErrorMessage(ERR_CMD_SQL_NOT_EXECUTED))
+										.arg(PQerrorMessage(connection)),
+										ERR_CMD_SQL_NOT_EXECUTED, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+	}
+
+	//The tuples are delivered one at a time to the handler
+	if(handler)
+		PQsetSingleRowMode(connection);
+
+	cancel_mutex.lock();
+	cancel_handle=QSharedPointer<PGcancel>(PQgetCancel(connection), PQfreeCancel);
+	cancel_requested.store(0);
+	cancel_mutex.unlock();
+
+	elapsed.start();
+
+	try
+	{
+		/* Collecting all the results of the command. Like PQexec() only the last result is returned
+		 unless one of the commands fails, in that case the error result is returned */
+		do
+		{
+			waitForResult(elapsed, timed_out);
+			next_res=PQgetResult(connection);
+
+			if(next_res && PQresultStatus(next_res)==PGRES_SINGLE_TUPLE)
+			{
+				ResultSet tuple(next_res);
+
+				tuple.accessTuple(ResultSet::FIRST_TUPLE);
+				handler->handleTuple(tuple);
+			}
+			else if(next_res)
+			{
+				if(sql_res && PQresultStatus(sql_res)==PGRES_FATAL_ERROR)
+					PQclear(next_res);
+				else
+				{
+					if(sql_res) PQclear(sql_res);
+					sql_res=next_res;
+				}
+			}
+		}
+		while(next_res);
+	}
+	catch(Exception &e)
+	{
+		//Stops the streaming of the remaining tuples when the handler fails
+		if(handler)
+			cancelCommand();
+
+		//Discarding any pending result so the connection can be used again (if it wasn't closed meanwhile)
+		while(connection && (next_res=PQgetResult(connection)))
+			PQclear(next_res);
+
+		if(sql_res) PQclear(sql_res);
+		sql_res=nullptr;
+		error=e;
+		failed=true;
+	}
+
+	cancel_mutex.lock();
+	cancel_handle.clear();
+	cancel_mutex.unlock();
+
+	//When the connection was closed the error raised by the wait is the one returned
+	if(timed_out && connection)
+	{
+		if(sql_res) PQclear(sql_res);
+		throw Exception(QString(Exception::getErrorMessage(ERR_CMD_SQL_TIMEOUT)).arg(cmd_timeout),
+										ERR_CMD_SQL_TIMEOUT, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, "57014");
+	}
+
+	if(failed)
+		throw Exception(error.getErrorMessage(), error.getErrorType(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &error);
+
 	//Raise an error in case the command sql execution is not sucessful
-	if(strlen(PQerrorMessage(connection))>0)
+	if(strlen(PQerrorMessage(connection)) > 0)
 	{
+		if(sql_res)
+		{
+			sql_state=PQresultErrorField(sql_res, PG_DIAG_SQLSTATE);
+			PQclear(sql_res);
+		}
+
 		throw Exception(QString(Exception::getErrorMessage(ERR_CMD_SQL_NOT_EXECUTED))
 										.arg(PQerrorMessage(connection)),
-										ERR_CMD_SQL_NOT_EXECUTED, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr,
-										QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE)));
+										ERR_CMD_SQL_NOT_EXECUTED, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, sql_state);
 	}
 
+	return(sql_res);
+}
+
+void Connection::waitForResult(QElapsedTimer &elapsed, bool &timed_out)
+{
+	int sock=PQsocket(connection);
+	qint64 remaining=0, cancel_time=-1;
+	fd_set read_fds;
+	timeval wait_time;
+
+	if(!PQconsumeInput(connection))
+	{
+		throw Exception(QString(Exception::getErrorMessage(ERR_CMD_SQL_NOT_EXECUTED))
+										.arg(PQerrorMessage(connection)),
+										ERR_CMD_SQL_NOT_EXECUTED, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+	}
+
+	while(PQisBusy(connection))
+	{
+		//The command is cancelled and the loop keeps waiting for the error returned by the server
+		if(cmd_timeout > 0 && !timed_out && elapsed.elapsed() >= cmd_timeout)
+		{
+			timed_out=true;
+			cancelCommand();
+		}
+
+		//Starts counting the time the server takes to answer the cancel request (due to the timeout or made by other threads)
+		if(cancel_time < 0 && cancel_requested.load())
+			cancel_time=elapsed.elapsed();
+
+		if(cancel_time >= 0)
+		{
+			remaining=CANCEL_WAIT_TIMEOUT - (elapsed.elapsed() - cancel_time);
+
+			//The server is unreachable, the connection is closed since it can't be used to run other commands
+			if(remaining <= 0)
+			{
+				close();
+				throw Exception(QString(Exception::getErrorMessage(ERR_CMD_CANCEL_NOT_ANSWERED)).arg(CANCEL_WAIT_TIMEOUT),
+												ERR_CMD_CANCEL_NOT_ANSWERED, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+			}
+		}
+		else if(cmd_timeout > 0)
+			remaining=cmd_timeout - elapsed.elapsed();
+		else
+			remaining=WAIT_INTERVAL;
+
+		remaining=qBound<qint64>(1, remaining, WAIT_INTERVAL);
+		wait_time.tv_sec=remaining / 1000;
+		wait_time.tv_usec=(remaining % 1000) * 1000;
+
+		FD_ZERO(&read_fds);
+		FD_SET(sock, &read_fds);
+
+		/* Errors on select() (e.g. interrupted by a signal) are ignored here, if the socket is
+		broken the error is reported by PQconsumeInput() */
+		select(sock + 1, &read_fds, nullptr, nullptr, &wait_time);
+
+		if(!PQconsumeInput(connection))
+		{
+			throw Exception(QString(Exception::getErrorMessage(ERR_CMD_SQL_NOT_EXECUTED))
+											.arg(PQerrorMessage(connection)),
+											ERR_CMD_SQL_NOT_EXECUTED, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+		}
+	}
+}
+
+void Connection::executeDMLCommand(const QString &sql, ResultSet &result)
+{
+	ResultSet *new_res=nullptr;
+	PGresult *sql_res=nullptr;
+
+	sql_res=executeCommand(sql);
+
 	//Generates the resultset based on the sql result descriptor
 	new_res=new ResultSet(sql_res);
 
@@ -246,28 +435,36 @@ void Connection::executeDMLCommand(const QString &sql, ResultSet &result)
 	delete(new_res);
 }
 
-void Connection::executeDDLCommand(const QString &sql)
+void Connection::executeDMLCommand(const QString &sql, TupleHandler &handler)
 {
-	PGresult *sql_res=nullptr;
-
-	//Raise an error in case the user try to close a not opened connection
-	if(!connection)
-		throw Exception(ERR_OPR_NOT_ALOC_CONN, __PRETTY_FUNCTION__, __FILE__, __LINE__);
-
-	sql_res=PQexec(connection, sql.toStdString().c_str());
-
-	//Prints the SQL to stdout when the flag is active
-	if(print_sql)
-		cout << "\n---\n" << sql.toStdString() << endl;
+	PQclear(executeCommand(sql, &handler));
+}
 
-	//Raise an error in case the command sql execution is not sucessful
-	if(strlen(PQerrorMessage(connection)) > 0)
+bool Connection::cancelCommand(void)
+{
+	char err_msg[256];
+	bool dispatched=false;
+	QSharedPointer<PGcancel> handle;
+
+	/* Only the reference to the descriptor is copied while the lock is held since PQcancel() connects to the server
+	and may take long. The descriptor is kept alive by the copy even if the command finishes in the meantime */
+	cancel_mutex.lock();
+	handle=cancel_handle;
+	cancel_mutex.unlock();
+
+	//The cancel descriptor exists only while a command is running
+	if(handle)
 	{
-		throw Exception(QString(Exception::getErrorMessage(ERR_CMD_SQL_NOT_EXECUTED))
-										.arg(PQerrorMessage(connection)),
-										ERR_CMD_SQL_NOT_EXECUTED, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr,
-										QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE)));
+		cancel_requested.store(1);
+		dispatched=(PQcancel(handle.data(), err_msg, sizeof(err_msg))==1);
 	}
+
+	return(dispatched);
+}
+
+void Connection::executeDDLCommand(const QString &sql)
+{
+	PQclear(executeCommand(sql));
 }
 
 void Connection::switchToDatabase(const QString &dbname)
@@ -303,5 +500,6 @@ void Connection::operator = (Connection &conn)
 
 	this->connection_params=conn.connection_params;
 	this->connection_str=conn.connection_str;
+	this->cmd_timeout=conn.cmd_timeout;
 }
 
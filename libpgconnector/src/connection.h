@@ -29,10 +29,25 @@
 #include "resultset.h"
 #include "attribsmap.h"
 #include <QRegExp>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QSharedPointer>
+#include <QAtomicInt>
 #include <iostream>
 
 using namespace std;
 
+/*! \brief Interface implemented by the classes that consume the tuples streamed by
+ Connection::executeDMLCommand(const QString &, TupleHandler &) */
+class TupleHandler {
+	public:
+		virtual ~TupleHandler(void) {}
+
+		/*! \brief Receives each tuple as soon as it arrives from the server. The result set holds only that
+		tuple (already accessed) and is destroyed after the call, so values must be copied if needed later */
+		virtual void handleTuple(ResultSet &res)=0;
+};
+
 class Connection {
 	private:
 		//! \brief Database connection descriptor
@@ -44,9 +59,40 @@ class Connection {
 		//! \brief Formated connection string
 		QString connection_str;
 
+		/*! \brief Descriptor used to cancel the command being executed. It's created when a command is
+		sent to the server and released when the command finishes. The descriptor is shared with the threads
+		requesting the cancellation so it's only destroyed after the last PQcancel() call using it returns */
+		QSharedPointer<PGcancel> cancel_handle;
+
+		//! \brief Indicates that the cancellation of the running command was requested
+		QAtomicInt cancel_requested;
+
+		//! \brief Maximum time (in milliseconds) a command can run before being cancelled (zero means no timeout)
+		int cmd_timeout;
+
+		/*! \brief Guards the cancel descriptors since they are used by threads other than the ones running the commands.
+		The lock is held only while the descriptor reference is copied, never during PQcancel() */
+		static QMutex cancel_mutex;
+
+		//! \brief Maximum time (in milliseconds) the server has to answer a cancel request before the connection is closed
+		static const int CANCEL_WAIT_TIMEOUT=5000;
+
+		//! \brief Maximum time (in milliseconds) the socket is waited at once, so cancel requests made by other threads are noticed
+		static const int WAIT_INTERVAL=250;
+
 		//! \brief Generates the connection string based on the parameter map
 		void generateConnectionString(void);
 
+		/*! \brief Sends the command to the server without blocking and waits for its results returning the last one
+		(the same way PQexec() does). Raises an error if the command fails or exceeds the timeout. When a tuple handler
+		is specified the command runs in single-row mode and each tuple is passed to the handler as soon as it arrives */
+		PGresult *executeCommand(const QString &sql, TupleHandler *handler=nullptr);
+
+		/*! \brief Waits until the result of the running command is available by polling the connection socket (select())
+		against the command's deadline. The 'timed_out' parameter is set when the command is cancelled due to the timeout.
+		If the server doesn't answer a cancel request within CANCEL_WAIT_TIMEOUT the connection is closed and an error is raised */
+		void waitForResult(QElapsedTimer &elapsed, bool &timed_out);
+
 		/*! \brief This static method disable the notice messages when executing commands.
 		By default all connections are created with notice disabled. To enable it the user
 		must call Connection::setNoticeEnabled(). Note: connections already stablished
@@ -100,6 +146,13 @@ class Connection {
 		//! \brief Returns the current state for sql output
 		static bool isSQLPrinted(void);
 
+		/*! \brief Defines the maximum time (in milliseconds) a command can run. Commands that exceed the timeout are
+		cancelled and raise an error. Zero disables the timeout (default) */
+		void setCommandTimeout(int msecs);
+
+		//! \brief Returns the current command timeout
+		int getCommandTimeout(void);
+
 		/*! \brief Sets one connection parameter. This method can only be called before
 		 the connection to the database */
 		void setConnectionParam(const QString &param, const QString &value);
@@ -134,15 +187,31 @@ class Connection {
 		//! \brief Returns if the connections is stablished
 		bool isStablished(void);
 
+		/*! \brief Returns if there is a transaction block open on the connection (idle or aborted), e.g.,
+		a transaction started by the user via BEGIN */
+		bool isTransactionOpen(void);
+
 		/*! \brief Executes a DML command on the server using the opened connection.
 		 Its mandatory to specify the object to receive the returned resultset. */
 		void executeDMLCommand(const QString &sql, ResultSet &result);
 
+		/*! \brief Executes a DML command streaming the returned tuples one by one to the handler instead of
+		buffering the whole result in memory */
+		void executeDMLCommand(const QString &sql, TupleHandler &handler);
+
 		/*! \brief Executes a DDL command on the server using the opened connection.
 		 The user don't need to specify the resultset since the commando executed is intended
 		 to be an data definition one  */
 		void executeDDLCommand(const QString &sql);
 
+		/*! \brief Requests the server to cancel the command currently being executed by the connection.
+		This method is intended to be called from a thread other than the one that is running the command.
+		Returns true when the cancel request was successfully dispatched (this doesn't mean that the
+		command was effectively aborted, in that case the command returns an error as usual). When there
+		is no command running the method does nothing and returns false. If the server doesn't answer the
+		request in time the connection is closed by the thread running the command */
+		bool cancelCommand(void);
+
 		//! \brief Makes an copy between two connections
 		void operator = (Connection &conn);
 };
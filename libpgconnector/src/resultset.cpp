@@ -55,10 +55,11 @@ ResultSet::ResultSet(PGresult *sql_result)
 			//In case of sucess states the result will be created
 		case PGRES_COMMAND_OK:
 		case PGRES_TUPLES_OK:
+		case PGRES_SINGLE_TUPLE:
 		case PGRES_COPY_OUT:
 		case PGRES_COPY_IN:
 		default:
-			empty_result=(res_state!=PGRES_TUPLES_OK && res_state!=PGRES_EMPTY_QUERY);
+			empty_result=(res_state!=PGRES_TUPLES_OK && res_state!=PGRES_SINGLE_TUPLE && res_state!=PGRES_EMPTY_QUERY);
 			current_tuple=-1;
 			is_res_copied=false;
 		break;
@@ -302,6 +303,18 @@ bool ResultSet::accessTuple(unsigned tuple_type)
   }
 }
 
+bool ResultSet::seekTuple(int tuple_idx)
+{
+	if(empty_result)
+		throw Exception(ERR_REF_TUPLE_INEXISTENT, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	if(tuple_idx < 0 || tuple_idx >= getTupleCount())
+		return(false);
+
+	current_tuple=tuple_idx;
+	return(true);
+}
+
 bool ResultSet::isEmpty(void)
 {
   return(empty_result);
@@ -108,6 +108,10 @@ class ResultSet {
   //! \brief Access on tuple on result set via navigation constants
   bool accessTuple(unsigned tuple_type);
 
+  /*! \brief Moves the navigation directly to the tuple at the specified index. Returns false
+     if the index is out of the tuple range (in this case the current tuple is not changed) */
+  bool seekTuple(int tuple_idx);
+
   //! \brief Returns if the result set is empty due a DML command that does not returned any data
   bool isEmpty(void);
 
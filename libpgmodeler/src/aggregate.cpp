@@ -34,6 +34,8 @@ Aggregate::Aggregate(void)
 
 void Aggregate::setFunction(unsigned func_idx, Function *func)
 {
+	invalidateReferences();
+
 	//Case the function index is invalid raises an error
 	if(func_idx!=FINAL_FUNC && func_idx!=TRANSITION_FUNC)
 		throw Exception(ERR_REF_FUNCTION_INV_TYPE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -94,6 +96,8 @@ void Aggregate::setInitialCondition(const QString &cond)
 
 void Aggregate::setSortOperator(Operator *sort_op)
 {
+	invalidateReferences();
+
 	if(sort_op)
 	{
 		Function *func=nullptr;
@@ -142,6 +146,8 @@ void Aggregate::setTypesAttribute(unsigned def_type)
 
 void Aggregate::addDataType(PgSQLType type)
 {
+	invalidateReferences();
+
 	//Case the data type already exists in the aggregate raise an exception
 	if(isDataTypeExist(type))
 		throw Exception(Exception::getErrorMessage(ERR_INS_DUPLIC_TYPE)
@@ -154,6 +160,8 @@ void Aggregate::addDataType(PgSQLType type)
 
 void Aggregate::removeDataType(unsigned type_idx)
 {
+	invalidateReferences();
+
 	//Raises an exception if the type index is out of bound
 	if(type_idx >= data_types.size())
 		throw Exception(ERR_REF_TYPE_INV_INDEX,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -165,6 +173,7 @@ void Aggregate::removeDataType(unsigned type_idx)
 void Aggregate::removeDataTypes(void)
 {
 	data_types.clear();
+	invalidateReferences();
 }
 
 bool Aggregate::isDataTypeExist(PgSQLType type)
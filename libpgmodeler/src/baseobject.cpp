@@ -17,6 +17,7 @@
 */
 
 #include "baseobject.h"
+#include "tableobject.h"
 #include <QApplication>
 
 /* CAUTION: If both amount and order of the enumerations are modified
@@ -64,6 +65,10 @@ QString BaseObject::objs_sql[OBJECT_TYPE_COUNT]={
    DatabaseModel, Tag */
 unsigned BaseObject::global_id=40000;
 
+map<BaseObject *, set<BaseObject *>> BaseObject::invalidated_refs;
+
+QMutex BaseObject::invalidated_refs_mutex;
+
 BaseObject::BaseObject(void)
 {
 	object_id=BaseObject::global_id++;
@@ -87,11 +92,44 @@ BaseObject::BaseObject(void)
 	this->setName(QApplication::translate("BaseObject","new_object","", -1));
 }
 
+BaseObject::~BaseObject(void)
+{
+	QMutexLocker locker(&invalidated_refs_mutex);
+
+	for(auto &itr : invalidated_refs)
+		itr.second.erase(this);
+
+	invalidated_refs.erase(this);
+}
+
 unsigned BaseObject::getGlobalId(void)
 {
 	return(global_id);
 }
 
+void BaseObject::updateNameVersion(void)
+{
+	if(database)
+		database->incrementNameVersion();
+}
+
+void BaseObject::incrementNameVersion(void)
+{
+}
+
+void BaseObject::invalidateReferences(void)
+{
+	BaseObject *db=database;
+	TableObject *tab_obj=dynamic_cast<TableObject *>(this);
+
+	//Table objects belong to the database of their parent tables
+	if(!db && tab_obj && tab_obj->getParentTable())
+		db=tab_obj->getParentTable()->getDatabase();
+
+	QMutexLocker locker(&invalidated_refs_mutex);
+	invalidated_refs[db].insert(this);
+}
+
 QString BaseObject::getTypeName(ObjectType obj_type)
 {
 	if(obj_type!=BASE_OBJECT)
@@ -325,6 +363,7 @@ void BaseObject::setName(const QString &name)
 		{
 			aux_name.remove('\"');
 			this->obj_name=aux_name;
+			updateNameVersion();
 		}
 	}
 }
@@ -411,6 +450,8 @@ bool BaseObject::acceptsAppendedSQL(void)
 
 void BaseObject::setSchema(BaseObject *schema)
 {
+	invalidateReferences();
+
 	if(!schema)
 		throw Exception(Exception::getErrorMessage(ERR_ASG_NOT_ALOC_SCHEMA)
 										.arg(Utf8String::create(this->obj_name)).arg(this->getTypeName()),
@@ -421,10 +462,13 @@ void BaseObject::setSchema(BaseObject *schema)
 		throw Exception(ERR_ASG_INV_SCHEMA_OBJECT,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
 	this->schema=schema;
+	updateNameVersion();
 }
 
 void BaseObject::setOwner(BaseObject *owner)
 {
+	invalidateReferences();
+
 	if(owner && owner->getObjectType()!=OBJ_ROLE)
 		throw Exception(ERR_ASG_INV_ROLE_OBJECT,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 	else if(!acceptsOwner())
@@ -435,6 +479,8 @@ void BaseObject::setOwner(BaseObject *owner)
 
 void BaseObject::setTablespace(BaseObject *tablespace)
 {
+	invalidateReferences();
+
 	if(tablespace && tablespace->getObjectType()!=OBJ_TABLESPACE)
 		throw Exception(ERR_ASG_INV_TABLESPACE_OBJECT,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 	else if(!acceptsTablespace())
@@ -445,6 +491,8 @@ void BaseObject::setTablespace(BaseObject *tablespace)
 
 void BaseObject::setCollation(BaseObject *collation)
 {
+	invalidateReferences();
+
 	if(collation && !acceptsCollation())
 		throw Exception(ERR_ASG_INV_COLLATION_OBJECT,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 	if(collation && collation->getObjectType()!=OBJ_COLLATION)
@@ -844,6 +892,8 @@ vector<ObjectType> BaseObject::getChildObjectTypes(ObjectType obj_type)
 
 void BaseObject::operator = (BaseObject &obj)
 {
+	invalidateReferences();
+
 	this->owner=obj.owner;
 	this->schema=obj.schema;
 	this->tablespace=obj.tablespace;
@@ -854,4 +904,5 @@ void BaseObject::operator = (BaseObject &obj)
 	this->is_protected=obj.is_protected;
 	this->sql_disabled=obj.sql_disabled;
   this->system_obj=obj.system_obj;
+	updateNameVersion();
 }
@@ -31,6 +31,8 @@
 #include "schemaparser.h"
 #include "xmlparser.h"
 #include <map>
+#include <set>
+#include <QMutex>
 #include <QRegExp>
 #include <QStringList>
 #include <QTextStream>
@@ -85,6 +87,16 @@ class BaseObject {
 		 used each with a custom different numbering range (see cited classes declaration). */
 		static unsigned global_id;
 
+		/*! \brief Stores the objects that had some of their references (schema, owner, data types, functions,
+		 columns, etc.) changed since the last time DatabaseModel updated its references graph. The objects are
+		 grouped by the database they belong to when invalidated (nullptr for the ones that doesn't belong to a
+		 database yet) so each model only updates the nodes of its own objects */
+		static map<BaseObject *, set<BaseObject *>> invalidated_refs;
+
+		/*! \brief Guards the invalidated_refs map since objects are created and changed by worker threads
+		 (import, validation, code generation) while the model updates its references graph */
+		static QMutex invalidated_refs_mutex;
+
 		/*! \brief Stores the unique identifier for the object. This id is nothing else
 		 than the current value of global_id. This identifier is used
 		 to know the chronological order of the creation of each object in the model
@@ -173,13 +185,25 @@ class BaseObject {
     //! \brief Clears all the attributes used by the SchemaParser
     void clearAttributes(void);
 
+		/*! \brief Notifies the database which the object belongs to that the object had its name, schema or signature
+		 changed, so the database can discard its outdated name indexes (see incrementNameVersion()) */
+		void updateNameVersion(void);
+
+		/*! \brief Increments the version of the names of the objects that belong to this object. Does nothing by default,
+		 it's reimplemented by DatabaseModel which is the only object that others can belong to (see setDatabase()) */
+		virtual void incrementNameVersion(void);
+
+		/*! \brief Marks the object as having its references changed. This method must be called by the setters that
+		 change the objects referenced by the instance so DatabaseModel can update its references graph */
+		void invalidateReferences(void);
+
 	public:
 		//! \brief Maximum number of characters that an object name on PostgreSQL can have
 		static const int OBJECT_NAME_MAX_LENGTH=63;
 
 		BaseObject(void);
 		BaseObject(bool system_obj);
-		virtual ~BaseObject(void){}
+		virtual ~BaseObject(void);
 
 		//! \brief Returns the reference to the database that owns the object
 		BaseObject *getDatabase(void);
@@ -28,6 +28,7 @@ BaseTable::BaseTable(void)
 void BaseTable::setTag(Tag *tag)
 {
   this->tag=tag;
+  invalidateReferences();
 }
 
 Tag *BaseTable::getTag(void)
@@ -33,6 +33,8 @@ Cast::Cast(void)
 
 void Cast::setDataType(unsigned type_idx, PgSQLType type)
 {
+	invalidateReferences();
+
 	//Check if the type index is valid
 	if(type_idx<=DST_TYPE)
 	{
@@ -52,6 +54,7 @@ void Cast::setDataType(unsigned type_idx, PgSQLType type)
 
 	//Configures the cast name (in form of signature: cast(src_type, dst_type) )
 	this->obj_name=QString("cast(%1,%2)").arg(~types[SRC_TYPE]).arg(~types[DST_TYPE]);
+	updateNameVersion();
 }
 
 void Cast::setCastType(unsigned cast_type)
@@ -73,6 +76,8 @@ void Cast::setCastFunction(Function *cast_func)
 	unsigned param_count;
 	bool error=false;
 
+	invalidateReferences();
+
 	if(!cast_func)
 		throw Exception(Exception::getErrorMessage(ERR_ASG_NOT_ALOC_FUNCTION)
 										.arg(Utf8String::create(this->getName()))
@@ -54,6 +54,8 @@ void Column::setName(const QString &name)
 
 void Column::setType(PgSQLType type)
 {
+	invalidateReferences();
+
 	//An error is raised if the column receive a pseudo-type as data type.
 	if(type.isPseudoType())
 		throw Exception(ERR_ASG_PSDTYPE_COLUMN,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -58,6 +58,7 @@ Constraint::~Constraint(void)
 void Constraint::setConstraintType(ConstraintType constr_type)
 {
 	this->constr_type=constr_type;
+	invalidateReferences();
 }
 
 void Constraint::setActionType(ActionType action_type, unsigned act_id)
@@ -138,6 +139,8 @@ bool Constraint::isColumnReferenced(Column *column, bool search_only_ref_cols)
 
 void Constraint::addColumn(Column *column, unsigned col_type)
 {
+	invalidateReferences();
+
 	//Raises an error if the column is not allocated
 	if(!column)
 		throw Exception(Exception::getErrorMessage(ERR_ASG_NOT_ALOC_COLUMN)
@@ -220,6 +223,7 @@ void Constraint::setColumnsAttribute(unsigned col_type, unsigned def_type, bool
 void Constraint::setReferencedTable(BaseTable *tab_ref)
 {
 	this->ref_table=tab_ref;
+	invalidateReferences();
 }
 
 void Constraint::setDeferralType(DeferralType deferral_type)
@@ -323,6 +327,7 @@ void Constraint::removeColumns(void)
 {
 	columns.clear();
 	ref_columns.clear();
+	invalidateReferences();
 }
 
 void Constraint::removeColumn(const QString &name, unsigned col_type)
@@ -331,6 +336,8 @@ void Constraint::removeColumn(const QString &name, unsigned col_type)
 	vector<Column *> *cols=nullptr;
 	Column *col=nullptr;
 
+	invalidateReferences();
+
 	//Gets the column list using the specified internal list type
 	if(col_type==REFERENCED_COLS)
 		cols=&ref_columns;
@@ -440,6 +447,8 @@ void Constraint::addExcludeElements(vector<ExcludeElement> &elems)
 {
 	vector<ExcludeElement> elems_bkp=excl_elements;
 
+	invalidateReferences();
+
 	try
 	{
 		excl_elements.clear();
@@ -456,6 +465,8 @@ void Constraint::addExcludeElements(vector<ExcludeElement> &elems)
 
 void Constraint::addExcludeElement(ExcludeElement elem)
 {
+	invalidateReferences();
+
 	if(getExcludeElementIndex(elem) >= 0)
 		throw Exception(ERR_INS_DUPLIC_ELEMENT,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 	else if(elem.getExpression().isEmpty() && !elem.getColumn())
@@ -466,6 +477,8 @@ void Constraint::addExcludeElement(ExcludeElement elem)
 
 void Constraint::addExcludeElement(const QString &expr, Operator *oper, OperatorClass *op_class, bool use_sorting, bool asc_order, bool nulls_first)
 {
+	invalidateReferences();
+
 	try
 	{
 		ExcludeElement elem;
@@ -495,6 +508,8 @@ void Constraint::addExcludeElement(const QString &expr, Operator *oper, Operator
 
 void Constraint::addExcludeElement(Column *column, Operator *oper, OperatorClass *op_class, bool use_sorting, bool asc_order, bool nulls_first)
 {
+	invalidateReferences();
+
 	try
 	{
 		ExcludeElement elem;
@@ -526,6 +541,8 @@ void Constraint::addExcludeElement(Column *column, Operator *oper, OperatorClass
 
 void Constraint::removeExcludeElement(unsigned elem_idx)
 {
+	invalidateReferences();
+
 	if(elem_idx >= excl_elements.size())
 		throw Exception(ERR_REF_ELEM_INV_INDEX,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
@@ -535,6 +552,7 @@ void Constraint::removeExcludeElement(unsigned elem_idx)
 void Constraint::removeExcludeElements(void)
 {
 	excl_elements.clear();
+	invalidateReferences();
 }
 
 ExcludeElement Constraint::getExcludeElement(unsigned elem_idx)
@@ -51,6 +51,8 @@ void Conversion::setEncoding(unsigned encoding_idx, EncodingType encoding_type)
 
 void Conversion::setConversionFunction(Function *conv_func)
 {
+	invalidateReferences();
+
 	//Raises an error in case the passed conversion function is null
 	if(!conv_func)
 		throw Exception(Exception::getErrorMessage(ERR_ASG_NOT_ALOC_FUNCTION)
@@ -17,6 +17,115 @@
 */
 
 #include "databasemodel.h"
+#include <QThreadPool>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QSaveFile>
+#include "dependencygraph.h"
+
+/* Stores the SQL code of an object generated by a CodeGenerationTask. The slots are
+	 kept in creation order so DatabaseModel::getCodeDefinition() can concatenate them
+	 in the same order used by the serial generation */
+struct CodeGenerationSlot {
+	BaseObject *object;
+	QString code_def;
+	bool done, failed;
+	Exception error;
+
+	CodeGenerationSlot(void) : object(nullptr), done(false), failed(false) {}
+};
+
+/* Generates on a pool thread the SQL code of a group of objects. Objects that share
+	 child objects (e.g. a table and the relationships that add constraints to it)
+	 are placed in the same group since the code generation changes the attributes
+	 of those child objects. */
+class CodeGenerationTask: public QRunnable {
+	private:
+		vector<CodeGenerationSlot *> gen_slots;
+		QMutex *mutex;
+		QWaitCondition *slot_done;
+
+	public:
+		CodeGenerationTask(QMutex *mutex, QWaitCondition *slot_done)
+		{
+			this->mutex=mutex;
+			this->slot_done=slot_done;
+		}
+
+		void addSlot(CodeGenerationSlot *slot)
+		{
+			gen_slots.push_back(slot);
+		}
+
+		void run(void)
+		{
+			vector<CodeGenerationSlot *>::iterator itr=gen_slots.begin();
+			CodeGenerationSlot *slot=nullptr;
+
+			while(itr!=gen_slots.end())
+			{
+				slot=(*itr);
+
+				try
+				{
+					if(slot->object->getObjectType()==OBJ_CONSTRAINT)
+						slot->code_def=dynamic_cast<Constraint *>(slot->object)->getCodeDefinition(SchemaParser::SQL_DEFINITION, true);
+					else
+						slot->code_def=slot->object->getCodeDefinition(SchemaParser::SQL_DEFINITION);
+				}
+				catch(Exception &e)
+				{
+					slot->error=e;
+					slot->failed=true;
+				}
+
+				mutex->lock();
+				slot->done=true;
+				slot_done->wakeAll();
+				mutex->unlock();
+				itr++;
+			}
+		}
+};
+
+//! \brief Writes the statements generated by DatabaseModel::getSQLStatements() on a file as they are received
+class SQLFileWriter: public SQLStatementHandler {
+	private:
+		QIODevice *output;
+
+	public:
+		SQLFileWriter(QIODevice *output)
+		{
+			this->output=output;
+		}
+
+		void handleStatement(const SQLStatement &stmt)
+		{
+			output->write(stmt.sql.toUtf8());
+		}
+};
+
+SQLStatement::SQLStatement(BaseObject *object, const QString &sql)
+{
+	obj_type=object->getObjectType();
+	obj_id=object->getObjectId();
+	name=object->getName(true);
+	this->sql=sql;
+}
+
+QString SQLStatement::getCommand(void) const
+{
+	QStringList lines=sql.split('\n', QString::SkipEmptyParts);
+	QString cmd;
+
+	for(auto &line : lines)
+	{
+		if(!line.startsWith("--") && !line.trimmed().isEmpty())
+			cmd+=line + "\n";
+	}
+
+	return(cmd);
+}
 
 unsigned DatabaseModel::dbmodel_id=20000;
 
@@ -29,13 +138,17 @@ DatabaseModel::DatabaseModel(void)
 	BaseObject::setName(QObject::trUtf8("new_database").toUtf8());
 
 	conn_limit=-1;
-	loading_model=invalidated=append_at_eod=false;
+	loading_model=invalidated=append_at_eod=parallel_code_gen=false;
+	name_indexes_version=name_version.load();
 	attributes[ParsersAttributes::ENCODING]="";
 	attributes[ParsersAttributes::TEMPLATE_DB]="";
 	attributes[ParsersAttributes::CONN_LIMIT]="";
 	attributes[ParsersAttributes::_LC_COLLATE_]="";
 	attributes[ParsersAttributes::_LC_CTYPE_]="";
 	attributes[ParsersAttributes::APPEND_AT_EOD]="";
+
+	//The model itself is a node of the references graph since it references its owner and tablespace
+	updateNodeReferences(this);
 }
 
 DatabaseModel::~DatabaseModel(void)
@@ -400,7 +513,18 @@ void DatabaseModel::__addObject(BaseObject *object, int obj_idx)
 	obj_list=getObjectList(object->getObjectType());
 
 	if(obj_idx < 0 || obj_idx >= static_cast<int>(obj_list->size()))
+	{
+		QHash<QString, unsigned> &name_idx=getNameIndex(obj_type);
+		QString key=getNameIndexKey(object);
+
 		obj_list->push_back(object);
+
+		//Appending the object to the name index avoiding its rebuilding on the next search
+		if(!name_idx.contains(key))
+			name_idx[key]=obj_list->size()-1;
+
+		name_indexes_size[obj_type]=obj_list->size();
+	}
 	else
 	{
 		if(obj_idx >=0 && idx < 0)
@@ -415,6 +539,8 @@ void DatabaseModel::__addObject(BaseObject *object, int obj_idx)
 	}
 
 	object->setDatabase(this);
+	updateNodeReferences(object);
+
 	emit s_objectAdded(object);
 	this->setInvalidated(true);
 }
@@ -486,7 +612,22 @@ void DatabaseModel::__removeObject(BaseObject *object, int obj_idx, bool check_r
 			if(obj_idx >= 0)
 			{
 				removePermissions(object);
+
+				/* When removing the last object of the list (e.g. when destroying the model objects)
+				the name index is updated instead of being rebuilt on the next search */
+				if(obj_idx==static_cast<int>(obj_list->size())-1)
+				{
+					QHash<QString, unsigned> &name_idx=getNameIndex(obj_type);
+					QString key=getNameIndexKey(object);
+
+					if(name_idx.contains(key) && name_idx[key]==static_cast<unsigned>(obj_idx))
+						name_idx.remove(key);
+
+					name_indexes_size[obj_type]=obj_idx;
+				}
+
 				obj_list->erase(obj_list->begin() + obj_idx);
+				removeNodeReferences(object);
 			}
 		}
 
@@ -550,9 +691,9 @@ BaseObject *DatabaseModel::getObject(const QString &name, ObjectType obj_type, i
 {
 	BaseObject *object=nullptr;
 	vector<BaseObject *> *obj_list=nullptr;
-	vector<BaseObject *>::iterator itr, itr_end;
-	bool found=false; //, formatted=false;
-	QString aux_name, aux_name1;
+	QHash<QString, unsigned> *name_idx=nullptr;
+	QHash<QString, unsigned>::iterator itr;
+	QString aux_name;
 
 	obj_list=getObjectList(obj_type);
 
@@ -560,51 +701,82 @@ BaseObject *DatabaseModel::getObject(const QString &name, ObjectType obj_type, i
 		throw Exception(ERR_OBT_OBJ_INVALID_TYPE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 	else
 	{
-		itr=obj_list->begin();
-		itr_end=obj_list->end();
-		obj_idx=-1;
-
-		//formatted=name.contains("\"") || name.contains(".");
-		aux_name1=QString(name).remove("\"");
+		/* Special case for functions/operators: the index stores the signature of
+		 these objects so the duplicity is checked against it and not only the name */
+		aux_name=QString(name).remove("\"");
+		name_idx=&getNameIndex(obj_type);
+		itr=name_idx->find(aux_name);
 
-		if(obj_type!=OBJ_FUNCTION && obj_type!=OBJ_OPERATOR)
+		/* If the object list was reordered without changing its size the object found
+		 will not match the searched name. In that case the index is rebuilt */
+		if(itr!=name_idx->end() && getNameIndexKey(obj_list->at(itr.value()))!=aux_name)
 		{
-			//if(!formatted)
-			//	aux_name1=BaseObject::formatName(aux_name1);
-			while(itr!=itr_end && !found)
-			{
-				aux_name=(*itr)->getName(true).remove("\"");
-				found=(aux_name==aux_name1);
-				if(!found) itr++;
-			}
+			name_indexes.erase(obj_type);
+			name_idx=&getNameIndex(obj_type);
+			itr=name_idx->find(aux_name);
 		}
-		else
+
+		if(itr!=name_idx->end())
 		{
-			QString signature;
+			obj_idx=itr.value();
+			object=obj_list->at(obj_idx);
+		}
+		else obj_idx=-1;
+	}
 
-			while(itr!=itr_end && !found)
-			{
-				/* Special case for functions/operators: to check duplicity the signature must be
-			 compared and not only the name */
-				if(obj_type==OBJ_FUNCTION)
-					signature=dynamic_cast<Function *>(*itr)->getSignature().remove("\"");
-				else
-					signature=dynamic_cast<Operator *>(*itr)->getSignature().remove("\"");
+	return(object);
+}
 
-				found=(signature==aux_name1);
-				if(!found) itr++;
-			}
-		}
+void DatabaseModel::incrementNameVersion(void)
+{
+	name_version.ref();
+}
 
-		if(found)
+QHash<QString, unsigned> &DatabaseModel::getNameIndex(ObjectType obj_type)
+{
+	vector<BaseObject *> *obj_list=getObjectList(obj_type);
+
+	//Discards all the indexes when some object had its name changed
+	if(name_indexes_version!=name_version.load())
+	{
+		name_indexes.clear();
+		name_indexes_size.clear();
+		name_indexes_version=name_version.load();
+	}
+
+	if(name_indexes.count(obj_type)==0 || name_indexes_size[obj_type]!=obj_list->size())
+	{
+		QHash<QString, unsigned> &name_idx=name_indexes[obj_type];
+		QString key;
+		unsigned i, count=obj_list->size();
+
+		name_idx.clear();
+		name_idx.reserve(count);
+
+		/* When there are objects with the same name (e.g. after a rename) the
+		 first one on the list is indexed, as done by the former linear search */
+		for(i=0; i < count; i++)
 		{
-			object=(*itr);
-			obj_idx=(itr-obj_list->begin());
+			key=getNameIndexKey(obj_list->at(i));
+
+			if(!name_idx.contains(key))
+				name_idx[key]=i;
 		}
-		else obj_idx=-1;
+
+		name_indexes_size[obj_type]=count;
 	}
 
-	return(object);
+	return(name_indexes[obj_type]);
+}
+
+QString DatabaseModel::getNameIndexKey(BaseObject *object)
+{
+	if(object->getObjectType()==OBJ_FUNCTION)
+		return(dynamic_cast<Function *>(object)->getSignature().remove("\""));
+	else if(object->getObjectType()==OBJ_OPERATOR)
+		return(dynamic_cast<Operator *>(object)->getSignature().remove("\""));
+	else
+		return(object->getName(true).remove("\""));
 }
 
 BaseObject *DatabaseModel::getObject(unsigned obj_idx, ObjectType obj_type)
@@ -761,6 +933,11 @@ void DatabaseModel::destroyObjects(void)
 	}
 
 	PgSQLType::removeUserTypes(this);
+
+	//Some objects are destroyed without being removed by __removeObject so the graph is recreated
+	node_refs.clear();
+	obj_referrers.clear();
+	updateNodeReferences(this);
 }
 
 void DatabaseModel::addTable(Table *table, int obj_idx)
@@ -1197,7 +1374,95 @@ void DatabaseModel::disconnectRelationships(void)
 	}
 }
 
+void DatabaseModel::disconnectRelationships(vector<BaseObject *> &rels)
+{
+	try
+	{
+		vector<BaseObject *>::reverse_iterator ritr_rel=rels.rbegin(), ritr_rel_end=rels.rend();
+
+		//The relationships must be disconnected from the last to the first
+		while(ritr_rel!=ritr_rel_end)
+		{
+			dynamic_cast<Relationship *>(*ritr_rel)->disconnectRelationship();
+			ritr_rel++;
+		}
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(),e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
+	}
+}
+
+void DatabaseModel::getAffectedRelationships(set<Table *> &changed_tabs, vector<BaseObject *> &valid_rels, vector<BaseObject *> &inv_rels)
+{
+	Relationship *rel=nullptr;
+	set<BaseObject *> affected;
+	bool found=true;
+
+	valid_rels.clear();
+	inv_rels.clear();
+
+	//The invalidated relationships are the starting point of the revalidation
+	for(auto obj : relationships)
+	{
+		rel=dynamic_cast<Relationship *>(obj);
+
+		if(rel->isInvalidated())
+		{
+			affected.insert(rel);
+
+			if(rel->getReceiverTable())
+				changed_tabs.insert(rel->getReceiverTable());
+		}
+	}
+
+	/* Any relationship that copies columns from a changed table is affected too, and the
+	 table that receives its columns is considered changed. This is done until no more
+	 relationships are found (columns propagated through several relationships) */
+	while(found)
+	{
+		found=false;
+
+		for(auto obj : relationships)
+		{
+			rel=dynamic_cast<Relationship *>(obj);
+
+			if(affected.count(rel)==0 &&
+				 ((rel->getRelationshipType()==BaseRelationship::RELATIONSHIP_NN &&
+					 (changed_tabs.count(dynamic_cast<Table *>(rel->getTable(BaseRelationship::SRC_TABLE))) ||
+						changed_tabs.count(dynamic_cast<Table *>(rel->getTable(BaseRelationship::DST_TABLE))))) ||
+					(rel->getRelationshipType()!=BaseRelationship::RELATIONSHIP_NN &&
+					 changed_tabs.count(rel->getReferenceTable()))))
+			{
+				affected.insert(rel);
+				found=true;
+
+				if(rel->getReceiverTable())
+					changed_tabs.insert(rel->getReceiverTable());
+			}
+		}
+	}
+
+	//The relationships are returned in the same order they are on the model
+	for(auto obj : relationships)
+	{
+		if(affected.count(obj))
+		{
+			if(dynamic_cast<Relationship *>(obj)->isInvalidated())
+				inv_rels.push_back(obj);
+			else
+				valid_rels.push_back(obj);
+		}
+	}
+}
+
 void DatabaseModel::validateRelationships(void)
+{
+	set<Table *> changed_tabs;
+	revalidateRelationships(changed_tabs);
+}
+
+void DatabaseModel::revalidateRelationships(set<Table *> &changed_tabs)
 {
 	vector<BaseObject *>::iterator itr, itr_end, itr_ant;
 	Relationship *rel=nullptr;
@@ -1234,52 +1499,25 @@ void DatabaseModel::validateRelationships(void)
 			rels_gen_pk++;
 	}
 
-	itr=relationships.begin();
-	itr_end=relationships.end();
+	if(!loading_model)
+	{
+		for(auto obj : relationships)
+			dynamic_cast<Relationship *>(obj)->saveObjectsIndexes();
+	}
 
 	do
 	{
-		//Initializes the flag that indicates that some invalid relatioship was found.
-		found_inval_rel=false;
-
-		while(itr!=itr_end)
-		{
-			base_rel=dynamic_cast<BaseRelationship *>(*itr);
-			itr++;
-
-			//Validates only table-table relationships
-			if(base_rel->getObjectType()==OBJ_RELATIONSHIP)
-			{
-				//Makes a cast to the correct object class
-				rel=dynamic_cast<Relationship *>(base_rel);
-
-				if(!loading_model)
-					rel->saveObjectsIndexes();
-
-				//If the relationships is invalid
-				if(rel->isInvalidated())
-				{
-					//Inserts it to the invalid relationship vector
-					vet_rel_inv.push_back(base_rel);
-
-					//Marks the flag indicating the at least one relationship was found invalidated
-					found_inval_rel=true;
-				}
-				else
-					//Otherwise inserts the relationship on the valid relationships
-					vet_rel.push_back(base_rel);
-			}
-		}
+		/* Only the invalidated relationships and the ones affected by them (or by the changed tables)
+		 are reconnected. The flag indicates that at least one of them was found */
+		getAffectedRelationships(changed_tabs, vet_rel, vet_rel_inv);
+		found_inval_rel=(!vet_rel.empty() || !vet_rel_inv.empty());
 
 		//If there is some invalidated relationship or special objects to be recreated
 		if(found_inval_rel || !xml_special_objs.empty())
 		{
-			//Stores the special objects definition if there is some invalidated relationships
+			//Stores the definition of the special objects related to the changed tables
 			if(!loading_model && xml_special_objs.empty())
-				storeSpecialObjectsXML();
-
-			//Disconnects all the relationship
-			disconnectRelationships();
+				storeSpecialObjectsXML(&changed_tabs);
 
 			/* Merges the two lists (valid and invalid relationships),
 			taking care to insert the invalid ones at the end of the list */
@@ -1288,6 +1526,10 @@ void DatabaseModel::validateRelationships(void)
 			vet_rel.clear();
 			vet_rel_inv.clear();
 
+			//Disconnects only the affected relationships
+			disconnectRelationships(rels);
+			changed_tabs.clear();
+
 			//Walking through the created list connecting the relationships
 			itr=rels.begin();
 			itr_end=rels.end();
@@ -1306,6 +1548,11 @@ void DatabaseModel::validateRelationships(void)
 					//Try to connect the relationship
 					rel->connectRelationship();
 
+					/* Notifies the table that received the columns and constraints of the relationship so the views
+					can update only its items. The table generated by n-n relationships is not part of the model */
+					if(rel->getRelationshipType()!=BaseRelationship::RELATIONSHIP_NN)
+						notifyObjectModified(rel->getReceiverTable());
+
 					//Storing the schemas on a auxiliary vector to update them later
 					tab1=rel->getTable(BaseRelationship::SRC_TABLE);
 					tab2=rel->getTable(BaseRelationship::DST_TABLE);
@@ -1593,6 +1840,11 @@ void DatabaseModel::checkRelationshipRedundancy(Relationship *rel)
 }
 
 void DatabaseModel::storeSpecialObjectsXML(void)
+{
+	storeSpecialObjectsXML(nullptr);
+}
+
+void DatabaseModel::storeSpecialObjectsXML(set<Table *> *changed_tabs)
 {
 	unsigned count, i, type_id;
 	vector<BaseObject *>::iterator itr, itr_end;
@@ -1629,12 +1881,16 @@ void DatabaseModel::storeSpecialObjectsXML(void)
 				for(i=0; i < count; i++)
 				{
 					tab_obj=dynamic_cast<TableObject *>(table->getObject(i, tab_obj_type[type_id]));
+					constr=dynamic_cast<Constraint *>(tab_obj);
 					found=false;
 
+					//Only the objects related to the changed tables are stored when they are specified
+					if(changed_tabs && changed_tabs->count(table)==0 &&
+						 (!constr || changed_tabs->count(dynamic_cast<Table *>(constr->getReferencedTable()))==0))
+						continue;
+
 					if(tab_obj_type[type_id]==OBJ_CONSTRAINT)
 					{
-						constr=dynamic_cast<Constraint *>(tab_obj);
-
 						/* A constraint is considered special in this case when it is referencing
 				 relationship added column and the constraint itself was not added by
 				 relationship (created manually by the user) */
@@ -1685,7 +1941,8 @@ void DatabaseModel::storeSpecialObjectsXML(void)
 			sequence=dynamic_cast<Sequence *>(*itr);
 			itr++;
 
-			if(sequence->isReferRelationshipAddedColumn())
+			if(sequence->isReferRelationshipAddedColumn() &&
+				 (!changed_tabs || changed_tabs->count(dynamic_cast<Table *>(sequence->getOwnerColumn()->getParentTable()))))
 			{
 				xml_special_objs[sequence->getObjectId()]=sequence->getCodeDefinition(SchemaParser::XML_DEFINITION);
 				removeSequence(sequence);
@@ -1701,7 +1958,7 @@ void DatabaseModel::storeSpecialObjectsXML(void)
 			view=dynamic_cast<View *>(*itr);
 			itr++;
 
-			if(view->isReferRelationshipAddedColumn())
+			if(view->isReferRelationshipAddedColumn() && (!changed_tabs || isViewReferencingTables(view, *changed_tabs)))
 			{
 				xml_special_objs[view->getObjectId()]=view->getCodeDefinition(SchemaParser::XML_DEFINITION);
 
@@ -1743,7 +2000,7 @@ void DatabaseModel::storeSpecialObjectsXML(void)
 			tab_obj=dynamic_cast<TableObject *>(permission->getObject());
 			itr++;
 
-			if(tab_obj)
+			if(tab_obj && (!changed_tabs || changed_tabs->count(dynamic_cast<Table *>(tab_obj->getParentTable()))))
 			{
 				xml_special_objs[permission->getObjectId()]=permission->getCodeDefinition(SchemaParser::XML_DEFINITION);
 				removePermission(permission);
@@ -1757,6 +2014,20 @@ void DatabaseModel::storeSpecialObjectsXML(void)
 	}
 }
 
+bool DatabaseModel::isViewReferencingTables(View *view, set<Table *> &tables)
+{
+	set<Table *>::iterator itr=tables.begin();
+	bool found=false;
+
+	while(itr!=tables.end() && !found)
+	{
+		found=view->isReferencingTable(*itr);
+		itr++;
+	}
+
+	return(found);
+}
+
 void DatabaseModel::createSpecialObject(const QString &xml_def, unsigned obj_id)
 {
 	ObjectType obj_type;
@@ -2467,6 +2738,7 @@ void DatabaseModel::addPermission(Permission *perm)
 
 		permissions.push_back(perm);
 		perm->setDatabase(this);
+		updateNodeReferences(perm);
 	}
 	catch(Exception &e)
 	{
@@ -2512,6 +2784,7 @@ void DatabaseModel::removePermissions(BaseObject *object)
 
 		if(perm->getObject()==object)
 		{
+			removeNodeReferences(perm);
 			permissions.erase(itr);
 			itr=itr_end=permissions.end();
 
@@ -2607,6 +2880,12 @@ int DatabaseModel::getObjectIndex(const QString &name, ObjectType obj_type)
 	return(idx);
 }
 
+void DatabaseModel::notifyObjectModified(BaseObject *object)
+{
+	if(object)
+		emit s_objectModified(object);
+}
+
 int DatabaseModel::getObjectIndex(BaseObject *object)
 {
 	if(!object)
@@ -2655,7 +2934,7 @@ void DatabaseModel::configureDatabase(attribs_map &attribs)
 	setBasicAttributes(this);
 }
 
-void DatabaseModel::loadModel(const QString &filename)
+void DatabaseModel::loadModel(const QString &filename, bool validate)
 {
 	if(filename!="")
 	{
@@ -2679,12 +2958,14 @@ void DatabaseModel::loadModel(const QString &filename)
 			XMLParser::restartParser();
 
 			//Loads the root DTD
-			XMLParser::setDTDFile(dtd_file + GlobalAttributes::ROOT_DTD +
-														GlobalAttributes::OBJECT_DTD_EXT,
-														GlobalAttributes::ROOT_DTD);
+			if(validate)
+				XMLParser::setDTDFile(dtd_file + GlobalAttributes::ROOT_DTD +
+															GlobalAttributes::OBJECT_DTD_EXT,
+															GlobalAttributes::ROOT_DTD);
 
-			//Loads the file validating it against the root DTD
-			XMLParser::loadXMLFile(filename);
+			/* Opens the file to be read element by element (validating it against the root DTD),
+			 so the objects are created as their elements are read without loading the whole document */
+			XMLParser::openXMLFile(filename);
 
 			//Gets the basic model information
 			XMLParser::getElementAttributes(attribs);
@@ -2692,55 +2973,54 @@ void DatabaseModel::loadModel(const QString &filename)
 			this->author=attribs[ParsersAttributes::MODEL_AUTHOR];
 			protected_model=(attribs[ParsersAttributes::PROTECTED]==ParsersAttributes::_TRUE_);
 
-			if(XMLParser::accessElement(XMLParser::CHILD_ELEMENT))
+			while(XMLParser::readNextElement())
 			{
-				do
+				if(XMLParser::getElementType()==XML_ELEMENT_NODE)
 				{
-					if(XMLParser::getElementType()==XML_ELEMENT_NODE)
-					{
-						elem_name=XMLParser::getElementName();
+					elem_name=XMLParser::getElementName();
 
-							//Indentifies the object type to be load according to the current element on the parser
-							obj_type=getObjectType(elem_name);
+						//Indentifies the object type to be load according to the current element on the parser
+						obj_type=getObjectType(elem_name);
 
-							if(obj_type==OBJ_DATABASE)
-							{
-								XMLParser::getElementAttributes(attribs);
-								configureDatabase(attribs);
-							}
-							else
+						if(obj_type==OBJ_DATABASE)
+						{
+							XMLParser::getElementAttributes(attribs);
+							configureDatabase(attribs);
+						}
+						else
+						{
+							try
 							{
-								try
-								{
-									//Saves the current position of the parser before create any object
-									XMLParser::savePosition();
-									object=createObject(obj_type);
-
-									if(object)
-									{
-										if(!dynamic_cast<TableObject *>(object) && obj_type!=OBJ_RELATIONSHIP && obj_type!=BASE_RELATIONSHIP)
-											addObject(object);
-
-										emit s_objectLoaded((XMLParser::getCurrentBufferLine()/static_cast<float>(XMLParser::getBufferLineCount()))*100,
-																				trUtf8("Loading: `%1' `(%2)'")
-																				.arg(Utf8String::create(object->getName()))
-																				.arg(object->getTypeName()),
-																				obj_type);
-									}
+								//Saves the current position of the parser before create any object
+								XMLParser::savePosition();
+								object=createObject(obj_type);
 
-									XMLParser::restorePosition();
-								}
-								catch(Exception &e)
+								if(object)
 								{
-									QString info_adicional=QString(QObject::trUtf8("%1 (line: %2)")).arg(XMLParser::getLoadedFilename()).arg(XMLParser::getCurrentElement()->line);
-									throw Exception(e.getErrorMessage(),e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, info_adicional);
+									if(!dynamic_cast<TableObject *>(object) && obj_type!=OBJ_RELATIONSHIP && obj_type!=BASE_RELATIONSHIP)
+										addObject(object);
+
+									emit s_objectLoaded((XMLParser::getStreamPosition()/static_cast<float>(XMLParser::getStreamSize()))*100,
+																			trUtf8("Loading: `%1' `(%2)'")
+																			.arg(Utf8String::create(object->getName()))
+																			.arg(object->getTypeName()),
+																			obj_type);
 								}
+
+								XMLParser::restorePosition();
 							}
-					}
+							catch(Exception &e)
+							{
+								QString info_adicional=QString(QObject::trUtf8("%1 (line: %2)")).arg(XMLParser::getLoadedFilename()).arg(XMLParser::getCurrentElement()->line);
+								throw Exception(e.getErrorMessage(),e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, info_adicional);
+							}
+						}
 				}
-				while(XMLParser::accessElement(XMLParser::NEXT_ELEMENT));
 			}
 
+			//Releases the reader before validating the relationships
+			XMLParser::restartParser();
+
 			this->BaseObject::setProtected(protected_model);
 			loading_model=false;
 			this->validateRelationships();
@@ -5850,10 +6130,13 @@ void DatabaseModel::validateRelationships(TableObject *object, Table *parent_tab
 				}
 			}
 
+			/* Only the relationships that copy columns from the parent table (directly or
+			 through other relationships) are reconnected */
 			if(revalidate_rels || ref_tab_inheritance)
 			{
-				disconnectRelationships();
-				validateRelationships();
+				set<Table *> changed_tabs;
+				changed_tabs.insert(parent_tab);
+				revalidateRelationships(changed_tabs);
 			}
 		}
 	}
@@ -6315,18 +6598,33 @@ QString DatabaseModel::getCodeDefinition(unsigned def_type)
 } */
 
 QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file)
+{
+  return(this->getCodeDefinition(def_type, export_file, nullptr));
+}
+
+QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file, SQLStatementHandler *handler)
 {
   attribs_map attribs_aux;
   float general_obj_cnt, gen_defs_count;
-  bool sql_disabled=false;
   BaseObject *object=nullptr;
   QString def, search_path="pg_catalog,public",
       msg=trUtf8("Generating %1 of the object `%2' `(%3)'"),
-      attrib=ParsersAttributes::OBJECTS, attrib_aux,
+      attrib=ParsersAttributes::OBJECTS,
       def_type_str=(def_type==SchemaParser::SQL_DEFINITION ? "SQL" : "XML");
   Type *usr_type=nullptr;
   map<unsigned, BaseObject *> objects_map;
   ObjectType obj_type;
+  vector<CodeGenerationSlot> gen_slots;
+  unsigned slot_idx=0;
+  bool base_types_gen=false;
+  QMutex slots_mutex;
+  QWaitCondition slot_done;
+  //The pool is declared after the slots so it is destroyed (waiting the running tasks) before them
+  QThreadPool pool;
+
+  //The statements are streamed only for SQL definition
+  if(def_type!=SchemaParser::SQL_DEFINITION)
+    handler=nullptr;
 
   try
   {
@@ -6339,6 +6637,10 @@ QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file)
     attribs_aux[ParsersAttributes::SCHEMA]="";
     attribs_aux[ParsersAttributes::TABLESPACE]="";
     attribs_aux[ParsersAttributes::ROLE]="";
+    attribs_aux[BaseObject::getSchemaName(OBJ_DATABASE)]="";
+    attribs_aux[ParsersAttributes::MODEL_AUTHOR]=author;
+    attribs_aux[ParsersAttributes::PGMODELER_VERSION]=GlobalAttributes::PGMODELER_VERSION;
+    attribs_aux[ParsersAttributes::EXPORT_TO_FILE]=(export_file ? "1" : "");
 
     if(def_type==SchemaParser::SQL_DEFINITION)
     {
@@ -6351,105 +6653,159 @@ QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file)
       }
     }
 
-    for(auto obj_itr : objects_map)
+    /* In parallel mode, the SQL code of the objects that don't change the state of other objects
+       is generated by the thread pool. The remaining ones (database, tablespaces, roles, schemas, types
+       and system objects) are generated serially on the loop below, which also collects the code generated
+       by the pool in creation order and emits the progress of the generation */
+    if(parallel_code_gen && def_type==SchemaParser::SQL_DEFINITION)
     {
-      object=obj_itr.second;
-      obj_type=object->getObjectType();
+      map<BaseObject *, CodeGenerationTask *> tasks;
+      vector<CodeGenerationTask *> tasks_order;
+      BaseObject *group_obj=nullptr;
+      TableObject *tab_obj=nullptr;
+      Relationship *rel=nullptr;
 
-      if(obj_type==OBJ_TYPE && def_type==SchemaParser::SQL_DEFINITION)
-      {
-        usr_type=dynamic_cast<Type *>(object);
+      gen_slots.resize(objects_map.size());
 
-        //Generating the shell type declaration (only for base types)
-        if(usr_type->getConfiguration()==Type::BASE_TYPE)
-          attribs_aux[ParsersAttributes::SHELL_TYPES]+=usr_type->getCodeDefinition(def_type, true);
-        else
-          attribs_aux[attrib]+=usr_type->getCodeDefinition(def_type);
-      }
-      else if(obj_type==OBJ_DATABASE)
+      for(auto obj_itr : objects_map)
       {
-        if(def_type==SchemaParser::SQL_DEFINITION)
-        {
-          /* The Database has the SQL code definition disabled when generating the
-          code of the entire model because this object cannot be created from a multiline sql command */
-
-          //Saving the sql disabled state
-          sql_disabled=this->isSQLDisabled();
+        object=obj_itr.second;
+        obj_type=object->getObjectType();
 
-          //Disables the sql to generate a commented code
-          this->setSQLDisabled(true);
-          attribs_aux[this->getSchemaName()]+=this->__getCodeDefinition(def_type);
+        if(!object->isSystemObject() &&
+           obj_type!=OBJ_TYPE && obj_type!=OBJ_DATABASE && obj_type!=OBJ_ROLE &&
+           obj_type!=OBJ_TABLESPACE && obj_type!=OBJ_SCHEMA)
+        {
+          tab_obj=dynamic_cast<TableObject *>(object);
+          rel=dynamic_cast<Relationship *>(object);
+
+          /* Table objects and relationships are grouped with the table that owns / receives
+             their constraints since these constraints have the code generated by both objects */
+          if(tab_obj && tab_obj->getParentTable())
+            group_obj=tab_obj->getParentTable();
+          else if(rel && rel->getReceiverTable())
+            group_obj=rel->getReceiverTable();
+          else
+            group_obj=object;
+
+          if(tasks.count(group_obj)==0)
+          {
+            tasks[group_obj]=new CodeGenerationTask(&slots_mutex, &slot_done);
+            tasks_order.push_back(tasks[group_obj]);
+          }
 
-          //Restore the original sql disabled state
-          this->setSQLDisabled(sql_disabled);
+          gen_slots[slot_idx].object=object;
+          tasks[group_obj]->addSlot(&gen_slots[slot_idx]);
         }
-        else
-          attribs_aux[attrib]+=this->__getCodeDefinition(def_type);
-      }
-      else if(obj_type==OBJ_PERMISSION)
-      {
-        attribs_aux[ParsersAttributes::PERMISSION]+=dynamic_cast<Permission *>(object)->getCodeDefinition(def_type);
-      }
-      else if(obj_type==OBJ_CONSTRAINT)
-      {
-        attribs_aux[attrib]+=dynamic_cast<Constraint *>(object)->getCodeDefinition(def_type, true);
+
+        slot_idx++;
       }
-      else if(obj_type==OBJ_ROLE || obj_type==OBJ_TABLESPACE ||  obj_type==OBJ_SCHEMA)
+
+      for(auto task : tasks_order)
+        pool.start(task);
+
+      slot_idx=0;
+    }
+
+    /* When streaming the statements the objects placed before the others on the model's code are generated first:
+       roles, tablespaces and the database (only when exporting to file) are rendered together with the model's header,
+       and the schemas, the search path and the shell types are streamed right after. The main loop skips these objects */
+    if(handler)
+    {
+      for(auto obj_itr : objects_map)
       {
-        //The "public" schema does not have the SQL code definition generated
-        if(def_type==SchemaParser::SQL_DEFINITION)
+        object=obj_itr.second;
+        obj_type=object->getObjectType();
+
+        if(export_file && (obj_type==OBJ_ROLE || obj_type==OBJ_TABLESPACE || obj_type==OBJ_DATABASE))
         {
-          attrib_aux=BaseObject::getSchemaName(obj_type);
-          attribs_aux[attrib_aux]="";
+          getObjectCodeDefinition(object, def_type, attribs_aux, nullptr, search_path);
+          emitGenerationProgress(object, ++gen_defs_count/general_obj_cnt, msg.arg(def_type_str));
         }
-        else
-          attrib_aux=attrib;
+      }
 
-        /* The Tablespace has the SQL code definition disabled when generating the
-          code of the entire model because this object cannot be created from a multiline sql command */
-        if(obj_type==OBJ_TABLESPACE && !object->isSystemObject() && def_type==SchemaParser::SQL_DEFINITION)
-        {
-          //Saving the sql disabled state
-          sql_disabled=object->isSQLDisabled();
+      attribs_aux[ParsersAttributes::SEARCH_PATH]="";
+      attribs_aux[ParsersAttributes::OBJECTS]="";
+      emitStatements(*handler, this, SchemaParser::getCodeDefinition(ParsersAttributes::DB_MODEL, attribs_aux, def_type));
+      attribs_aux.clear();
 
-          //Disables the sql to generate a commented code
-          object->setSQLDisabled(true);
-          attribs_aux[attrib_aux]+=object->getCodeDefinition(def_type);
+      for(auto obj_itr : objects_map)
+      {
+        object=obj_itr.second;
 
-          //Restore the original sql disabled state
-          object->setSQLDisabled(sql_disabled);
-        }
-        //System object doesn't has the XML generated (the only exception is for public schema)
-        else if((obj_type!=OBJ_SCHEMA && !object->isSystemObject()) ||
-                (obj_type==OBJ_SCHEMA &&
-                 ((object->getName()=="public" && def_type==SchemaParser::XML_DEFINITION) ||
-                  (object->getName()!="public" && object->getName()!="pg_catalog"))))
+        if(object->getObjectType()==OBJ_SCHEMA)
         {
-          if(object->getObjectType()==OBJ_SCHEMA)
-            search_path+="," + object->getName(true);
-
-          //Generates the code definition and concatenates to the others
-          attribs_aux[attrib_aux]+=object->getCodeDefinition(def_type);
+          getObjectCodeDefinition(object, def_type, attribs_aux, handler, search_path);
+          emitGenerationProgress(object, ++gen_defs_count/general_obj_cnt, msg.arg(def_type_str));
         }
       }
-      else
-      {
-        if(object->isSystemObject())
-          attribs_aux[attrib]+="";
-        else
-          attribs_aux[attrib]+=object->getCodeDefinition(def_type);
-      }
 
-      gen_defs_count++;
+      //The search path is configured right after the schemas creation (only when user schemas were created)
+      if(search_path!="pg_catalog,public")
+        emitStatements(*handler, this, QString("SET search_path TO %1;\n%2\n\n").arg(search_path).arg(ParsersAttributes::DDL_END_TOKEN));
 
-      emit s_objectLoaded((gen_defs_count/general_obj_cnt) * 100,
-                            msg.arg(def_type_str)
-                            .arg(Utf8String::create(object->getName()))
-                            .arg(object->getTypeName()),
-                            object->getObjectType());
-    }
+      for(auto obj_itr : objects_map)
+      {
+        object=obj_itr.second;
 
-    attribs_aux[ParsersAttributes::SEARCH_PATH]=search_path;
+        if(object->getObjectType()==OBJ_TYPE && isPrecedingObject(object))
+        {
+          getObjectCodeDefinition(object, def_type, attribs_aux, handler, search_path);
+          emitGenerationProgress(object, ++gen_defs_count/general_obj_cnt, msg.arg(def_type_str));
+        }
+      }
+    }
+
+    for(auto obj_itr : objects_map)
+    {
+      object=obj_itr.second;
+      obj_type=object->getObjectType();
+
+      /* The complete definition of the base types is placed at the end of the objects section, before the permissions,
+         so the statements sent to the handler are in the same order as the code generated as a single string */
+      if(handler && !base_types_gen && obj_type==OBJ_PERMISSION)
+      {
+        //The permissions being generated by the pool can reference the functions changed by the base types
+        pool.waitForDone();
+        appendBaseTypesDefinition(attribs_aux, handler);
+        base_types_gen=true;
+      }
+
+      if(handler && isPrecedingObject(object))
+      {
+        //Objects already generated before the loop
+        if(!export_file && (obj_type==OBJ_ROLE || obj_type==OBJ_TABLESPACE || obj_type==OBJ_DATABASE))
+          emitGenerationProgress(object, ++gen_defs_count/general_obj_cnt, msg.arg(def_type_str));
+
+        slot_idx++;
+        continue;
+      }
+
+      if(!gen_slots.empty() && gen_slots[slot_idx].object)
+      {
+        CodeGenerationSlot &slot=gen_slots[slot_idx];
+
+        slots_mutex.lock();
+        while(!slot.done)
+          slot_done.wait(&slots_mutex);
+        slots_mutex.unlock();
+
+        if(slot.failed)
+          throw Exception(slot.error.getErrorMessage(), slot.error.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &slot.error);
+
+        appendCodeDefinition(attribs_aux, handler, (obj_type==OBJ_PERMISSION ? ParsersAttributes::PERMISSION : attrib), object, slot.code_def);
+
+        //Releasing the code already consumed
+        slot.code_def.clear();
+      }
+      else
+        getObjectCodeDefinition(object, def_type, attribs_aux, handler, search_path);
+
+      slot_idx++;
+      emitGenerationProgress(object, ++gen_defs_count/general_obj_cnt, msg.arg(def_type_str));
+    }
+
+    attribs_aux[ParsersAttributes::SEARCH_PATH]=search_path;
     attribs_aux[ParsersAttributes::MODEL_AUTHOR]=author;
     attribs_aux[ParsersAttributes::PGMODELER_VERSION]=GlobalAttributes::PGMODELER_VERSION;
 
@@ -6457,36 +6813,31 @@ QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file)
     {
       attribs_aux[ParsersAttributes::PROTECTED]=(this->is_protected ? "1" : "");
     }
-    else
+    else if(!base_types_gen)
     {
-      for(auto type : types)
-      {
-        usr_type=dynamic_cast<Type *>(type);
-        if(usr_type->getConfiguration()==Type::BASE_TYPE)
-        {
-          attribs_aux[attrib]+=usr_type->getCodeDefinition(def_type);
-          usr_type->convertFunctionParameters(true);
-        }
-      }
+      appendBaseTypesDefinition(attribs_aux, handler);
+      base_types_gen=true;
     }
   }
   catch(Exception &e)
   {
-    if(def_type==SchemaParser::SQL_DEFINITION)
-    {
-      for(auto type : types)
-      {
-        usr_type=dynamic_cast<Type *>(type);
-        if(usr_type->getConfiguration()==Type::BASE_TYPE)
-        {
-          attribs_aux[attrib]+=usr_type->getCodeDefinition(def_type);
-          usr_type->convertFunctionParameters(true);
-        }
-      }
-    }
+    //Waiting the running tasks before restoring the functions' parameters changed by the base types
+    pool.waitForDone();
+
+    if(def_type==SchemaParser::SQL_DEFINITION && !base_types_gen)
+      appendBaseTypesDefinition(attribs_aux, nullptr);
+
     throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
   }
 
+  if(handler)
+  {
+    if(append_at_eod && !appended_sql.isEmpty())
+      handler->handleStatement(SQLStatement(this, "-- Appended SQL commands --\n" + this->appended_sql + "\n"));
+
+    return("");
+  }
+
   attribs_aux[ParsersAttributes::EXPORT_TO_FILE]=(export_file ? "1" : "");
   def=SchemaParser::getCodeDefinition(ParsersAttributes::DB_MODEL, attribs_aux, def_type);
 
@@ -6496,29 +6847,193 @@ QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file)
   return(def);
 }
 
-map<unsigned, BaseObject *> DatabaseModel::getCreationOrder(unsigned def_type)
+void DatabaseModel::appendBaseTypesDefinition(attribs_map &attribs, SQLStatementHandler *handler)
+{
+  Type *usr_type=nullptr;
+
+  for(auto type : types)
+  {
+    usr_type=dynamic_cast<Type *>(type);
+
+    if(usr_type->getConfiguration()==Type::BASE_TYPE)
+    {
+      appendCodeDefinition(attribs, handler, ParsersAttributes::OBJECTS, usr_type, usr_type->getCodeDefinition(SchemaParser::SQL_DEFINITION));
+      usr_type->convertFunctionParameters(true);
+    }
+  }
+}
+
+void DatabaseModel::getObjectCodeDefinition(BaseObject *object, unsigned def_type, attribs_map &attribs, SQLStatementHandler *handler, QString &search_path)
+{
+  ObjectType obj_type=object->getObjectType();
+  QString attrib=ParsersAttributes::OBJECTS, attrib_aux;
+  Type *usr_type=nullptr;
+  bool sql_disabled=false;
+
+  if(obj_type==OBJ_TYPE && def_type==SchemaParser::SQL_DEFINITION)
+  {
+    usr_type=dynamic_cast<Type *>(object);
+
+    //Generating the shell type declaration (only for base types)
+    if(usr_type->getConfiguration()==Type::BASE_TYPE)
+      appendCodeDefinition(attribs, handler, ParsersAttributes::SHELL_TYPES, usr_type, usr_type->getCodeDefinition(def_type, true));
+    else
+      appendCodeDefinition(attribs, handler, attrib, usr_type, usr_type->getCodeDefinition(def_type));
+  }
+  else if(obj_type==OBJ_DATABASE)
+  {
+    if(def_type==SchemaParser::SQL_DEFINITION)
+    {
+      /* The Database has the SQL code definition disabled when generating the
+      code of the entire model because this object cannot be created from a multiline sql command */
+
+      //Saving the sql disabled state
+      sql_disabled=this->isSQLDisabled();
+
+      //Disables the sql to generate a commented code
+      this->setSQLDisabled(true);
+      appendCodeDefinition(attribs, handler, this->getSchemaName(), this, this->__getCodeDefinition(def_type));
+
+      //Restore the original sql disabled state
+      this->setSQLDisabled(sql_disabled);
+    }
+    else
+      appendCodeDefinition(attribs, handler, attrib, this, this->__getCodeDefinition(def_type));
+  }
+  else if(obj_type==OBJ_PERMISSION)
+  {
+    appendCodeDefinition(attribs, handler, ParsersAttributes::PERMISSION, object, dynamic_cast<Permission *>(object)->getCodeDefinition(def_type));
+  }
+  else if(obj_type==OBJ_CONSTRAINT)
+  {
+    appendCodeDefinition(attribs, handler, attrib, object, dynamic_cast<Constraint *>(object)->getCodeDefinition(def_type, true));
+  }
+  else if(obj_type==OBJ_ROLE || obj_type==OBJ_TABLESPACE ||  obj_type==OBJ_SCHEMA)
+  {
+    //The "public" schema does not have the SQL code definition generated
+    if(def_type==SchemaParser::SQL_DEFINITION)
+      attrib_aux=BaseObject::getSchemaName(obj_type);
+    else
+      attrib_aux=attrib;
+
+    /* The Tablespace has the SQL code definition disabled when generating the
+      code of the entire model because this object cannot be created from a multiline sql command */
+    if(obj_type==OBJ_TABLESPACE && !object->isSystemObject() && def_type==SchemaParser::SQL_DEFINITION)
+    {
+      //Saving the sql disabled state
+      sql_disabled=object->isSQLDisabled();
+
+      //Disables the sql to generate a commented code
+      object->setSQLDisabled(true);
+      appendCodeDefinition(attribs, handler, attrib_aux, object, object->getCodeDefinition(def_type));
+
+      //Restore the original sql disabled state
+      object->setSQLDisabled(sql_disabled);
+    }
+    //System object doesn't has the XML generated (the only exception is for public schema)
+    else if((obj_type!=OBJ_SCHEMA && !object->isSystemObject()) ||
+            (obj_type==OBJ_SCHEMA &&
+             ((object->getName()=="public" && def_type==SchemaParser::XML_DEFINITION) ||
+              (object->getName()!="public" && object->getName()!="pg_catalog"))))
+    {
+      if(object->getObjectType()==OBJ_SCHEMA)
+        search_path+="," + object->getName(true);
+
+      //Generates the code definition and concatenates to the others
+      appendCodeDefinition(attribs, handler, attrib_aux, object, object->getCodeDefinition(def_type));
+    }
+  }
+  else
+  {
+    if(!object->isSystemObject())
+      appendCodeDefinition(attribs, handler, attrib, object, object->getCodeDefinition(def_type));
+  }
+}
+
+bool DatabaseModel::isPrecedingObject(BaseObject *object)
+{
+  ObjectType obj_type=object->getObjectType();
+
+  return(obj_type==OBJ_ROLE || obj_type==OBJ_TABLESPACE || obj_type==OBJ_DATABASE || obj_type==OBJ_SCHEMA ||
+         (obj_type==OBJ_TYPE && dynamic_cast<Type *>(object)->getConfiguration()==Type::BASE_TYPE));
+}
+
+void DatabaseModel::emitGenerationProgress(BaseObject *object, float progress, const QString &msg)
+{
+  emit s_objectLoaded(progress * 100,
+                      QString(msg)
+                      .arg(Utf8String::create(object->getName()))
+                      .arg(object->getTypeName()),
+                      object->getObjectType());
+}
+
+void DatabaseModel::appendCodeDefinition(attribs_map &attribs, SQLStatementHandler *handler,
+                                         const QString &attrib, BaseObject *object, const QString &code)
+{
+  if(handler)
+    emitStatements(*handler, object, code);
+  else
+    attribs[attrib]+=code;
+}
+
+void DatabaseModel::emitStatements(SQLStatementHandler &handler, BaseObject *object, const QString &code)
+{
+  int start=0, pos=0, token_len=ParsersAttributes::DDL_END_TOKEN.size();
+
+  /* Each command generated by the schema files ends with the ddl end token. The text between
+     two tokens (including the comments and the token itself) is handled as a single statement */
+  while(start < code.size())
+  {
+    pos=code.indexOf(ParsersAttributes::DDL_END_TOKEN, start);
+
+    //The remaining text after the last token (usually line breaks) is part of the last statement
+    if(pos < 0 || code.indexOf(ParsersAttributes::DDL_END_TOKEN, pos + token_len) < 0)
+      pos=code.size();
+    else
+      pos+=token_len;
+
+    handler.handleStatement(SQLStatement(object, code.mid(start, pos - start)));
+    start=pos;
+  }
+}
+
+void DatabaseModel::getSQLStatements(SQLStatementHandler &handler, bool export_file)
+{
+  getCodeDefinition(SchemaParser::SQL_DEFINITION, export_file, &handler);
+}
+
+map<unsigned, BaseObject *> DatabaseModel::getCreationOrder(unsigned def_type, vector<vector<BaseObject *> > *cycles)
 {
   unsigned i, count;
-  BaseObject *object=nullptr;
   vector<BaseObject *> fkeys;
   vector<BaseObject *> fk_rels;
   vector<BaseObject *> *obj_list=nullptr;
-  vector<BaseObject *>::iterator itr, itr_end;
+  vector<BaseObject *> nodes, deps;
+  vector<unsigned> order;
+  vector<vector<unsigned> > node_cycles;
+  map<BaseObject *, unsigned> node_idxs;
+  map<BaseObject *, vector<BaseObject *> > recv_rels;
   map<unsigned, BaseObject *> objects_map;
+  DependencyGraph graph;
+  BaseObject *dep=nullptr, *parent=nullptr;
   Table *table=nullptr;
+  TableObject *tab_obj=nullptr;
   Index *index=nullptr;
   Trigger *trigger=nullptr;
   Constraint *constr=nullptr;
   Relationship *rel=nullptr;
+  BaseRelationship *base_rel=nullptr;
+  View *view=nullptr;
   ObjectType aux_obj_types[]={ OBJ_ROLE, OBJ_TABLESPACE, OBJ_SCHEMA, OBJ_TAG },
       obj_types[]={ OBJ_COLLATION, OBJ_LANGUAGE, OBJ_FUNCTION, OBJ_TYPE,
                     OBJ_CAST, OBJ_CONVERSION, OBJ_EXTENSION,
                     OBJ_OPERATOR, OBJ_OPFAMILY, OBJ_OPCLASS,
                     OBJ_AGGREGATE, OBJ_DOMAIN, OBJ_TEXTBOX, BASE_RELATIONSHIP,
                     OBJ_RELATIONSHIP, OBJ_TABLE, OBJ_VIEW, OBJ_SEQUENCE };
-  unsigned aux_obj_cnt=sizeof(aux_obj_types)/sizeof(ObjectType);
+  unsigned aux_obj_cnt=sizeof(aux_obj_types)/sizeof(ObjectType),
+      obj_type_cnt=sizeof(obj_types)/sizeof(ObjectType);
 
-  //The first objects on the map will be roles, tablespaces, schemas and tags
+  //Roles, tablespaces, schemas and tags (XML only) and the database model itself are the first objects
   for(i=0; i < aux_obj_cnt; i++)
   {
     if(aux_obj_types[i]!=OBJ_TAG || def_type==SchemaParser::XML_DEFINITION)
@@ -6526,59 +7041,49 @@ map<unsigned, BaseObject *> DatabaseModel::getCreationOrder(unsigned def_type)
       obj_list=getObjectList(aux_obj_types[i]);
 
       for(auto object : (*obj_list))
-         objects_map[object->getObjectId()]=object;
+        objects_map[object->getObjectId()]=object;
     }
   }
 
-  //Includes the database model on the objects map permitting to create the code in a correct order
   objects_map[this->getObjectId()]=this;
 
-  if(def_type==SchemaParser::XML_DEFINITION)
-    count=18;
-  else
-    count=14;
-
-  for(i=0; i < count; i++)
+  for(i=0; i < obj_type_cnt; i++)
   {
     //For SQL definition, only the textbox and base relationship does not enters to the code generation list
     if(def_type==SchemaParser::SQL_DEFINITION &&
        (obj_types[i]==OBJ_TEXTBOX || obj_types[i]==BASE_RELATIONSHIP))
-      obj_list=nullptr;
-    else
-      obj_list=getObjectList(obj_types[i]);
+      continue;
 
-    if(obj_list)
+    obj_list=getObjectList(obj_types[i]);
+
+    for(auto object : (*obj_list))
     {
-      for(auto object : (*obj_list))
-      {
-        /* If the object is a FK relationship it's stored in a separeted list in order to have the
-             code generated at end of whole definition (after foreign keys definition) */
-        if(object->getObjectType()==BASE_RELATIONSHIP &&
-           dynamic_cast<BaseRelationship *>(object)->getRelationshipType()==BaseRelationship::RELATIONSHIP_FK)
-        {
-          fk_rels.push_back(object);
-        }
-        else
-          objects_map[object->getObjectId()]=object;
-      }
+      /* If the object is a FK relationship it's stored in a separeted list in order to have the
+         code generated at end of whole definition (after foreign keys definition) */
+      if(object->getObjectType()==BASE_RELATIONSHIP &&
+         dynamic_cast<BaseRelationship *>(object)->getRelationshipType()==BaseRelationship::RELATIONSHIP_FK)
+        fk_rels.push_back(object);
+      else
+        objects_map[object->getObjectId()]=object;
+
+      //Storing the relationships that add columns / constraints to each table
+      rel=dynamic_cast<Relationship *>(object);
+      if(rel && rel->getReceiverTable())
+        recv_rels[rel->getReceiverTable()].push_back(rel);
     }
   }
 
   /* Getting and storing the special objects (which reference columns of tables added for relationships)
-      on the map of objects. */
+     on the map of objects. Foreign keys are generated at the end of the definition */
   for(auto obj : tables)
   {
     table=dynamic_cast<Table *>(obj);
-    itr++;
 
     count=table->getConstraintCount();
     for(i=0; i < count; i++)
     {
       constr=table->getConstraint(i);
 
-      /* Case the constraint is a special object stores it on the objects map. Independently to the
-        configuration, foreign keys are discarded in this iteration because on the end of the method
-        they have the definition generated */
       if(constr->getConstraintType()!=ConstraintType::foreign_key &&  !constr->isAddedByLinking() &&
          ((constr->getConstraintType()!=ConstraintType::primary_key && constr->isReferRelationshipAddedColumn())))
         objects_map[constr->getObjectId()]=constr;
@@ -6605,68 +7110,91 @@ map<unsigned, BaseObject *> DatabaseModel::getCreationOrder(unsigned def_type)
     }
   }
 
-  /* SPECIAL CASE: Generating the correct order for tables, views, relationships and sequences
+  /* The objects ordered by id are the nodes of the dependency graph. The id order is used as the preferred
+     order of creation, so the objects that don't depend on each other keep the order in which they were created */
+  for(auto obj_itr : objects_map)
+  {
+    node_idxs[obj_itr.second]=nodes.size();
+    nodes.push_back(obj_itr.second);
+  }
+
+  graph.reset(nodes.size() + fkeys.size() + fk_rels.size() + permissions.size());
 
-     This generations is made in the following way:
-     1) Based on the relationship list, participant tables comes before the relationship itself.
-     2) Other tables came after the objects on the step 1.
-     3) The sequences must have its code generated after the tables
-     4) View are the last objects in the list avoiding table/column reference breaking */
-  if(def_type==SchemaParser::SQL_DEFINITION)
+  for(i=0; i < nodes.size(); i++)
   {
-    BaseObject *objs[3]={nullptr, nullptr, nullptr};
-    vector<BaseObject *> vet_aux;
+    deps.clear();
+    getObjectDependecies(nodes[i], deps, false);
 
-    vet_aux=relationships;
-    vet_aux.insert(vet_aux.end(), tables.begin(),tables.end());
-    vet_aux.insert(vet_aux.end(), sequences.begin(),sequences.end());
-    vet_aux.insert(vet_aux.end(), views.begin(),views.end());;
-    itr=vet_aux.begin();
-    itr_end=vet_aux.end();
+    tab_obj=dynamic_cast<TableObject *>(nodes[i]);
+    base_rel=dynamic_cast<BaseRelationship *>(nodes[i]);
+    view=dynamic_cast<View *>(nodes[i]);
 
-    while(itr!=itr_end)
+    //Special objects are created after their parent tables and the relationships that add columns to them
+    if(tab_obj && tab_obj->getParentTable())
     {
-      object=(*itr);
-      itr++;
-
-      if(object->getObjectType()==OBJ_RELATIONSHIP)
+      parent=tab_obj->getParentTable();
+      deps.push_back(parent);
+      deps.insert(deps.end(), recv_rels[parent].begin(), recv_rels[parent].end());
+    }
+    //Relationships are created after the tables they connect
+    else if(base_rel)
+    {
+      deps.push_back(base_rel->getTable(BaseRelationship::SRC_TABLE));
+      deps.push_back(base_rel->getTable(BaseRelationship::DST_TABLE));
+    }
+    //Views are created after the relationships that add columns to the tables they reference
+    else if(view)
+    {
+      count=view->getReferenceCount();
+      for(unsigned ref=0; ref < count; ref++)
       {
-        rel=dynamic_cast<Relationship *>(object);
-        objs[0]=rel->getTable(Relationship::SRC_TABLE);
-        objs[1]=rel->getTable(Relationship::DST_TABLE);
-        objs[2]=rel;
+        parent=view->getReference(ref).getTable();
 
-        for(i=0; i < 3; i++)
-        {
-          if(objects_map.count(objs[i]->getObjectId())==0)
-            objects_map[objs[i]->getObjectId()]=objs[i];
-        }
-      }
-      else
-      {
-        if(objects_map.count(object->getObjectId())==0)
-          objects_map[object->getObjectId()]=object;
+        if(parent)
+          deps.insert(deps.end(), recv_rels[parent].begin(), recv_rels[parent].end());
       }
     }
-  }
 
-  //Adding fk relationships and foreign keys at end of objects map
-  i=BaseObject::getGlobalId() + 1;
-  fkeys.insert(fkeys.end(), fk_rels.begin(), fk_rels.end());
+    if(def_type==SchemaParser::XML_DEFINITION && dynamic_cast<BaseTable *>(nodes[i]))
+      deps.push_back(dynamic_cast<BaseTable *>(nodes[i])->getTag());
 
-  for(auto obj : fkeys)
-  {
-    objects_map[i]=obj;
-    i++;
+    for(auto dep_obj : deps)
+    {
+      dep=dep_obj;
+
+      //Dependencies to columns and other table objects are translated to their parent tables
+      tab_obj=dynamic_cast<TableObject *>(dep);
+      if(tab_obj && node_idxs.count(dep)==0)
+        dep=tab_obj->getParentTable();
+
+      if(dep && node_idxs.count(dep))
+        graph.addDependency(i, node_idxs[dep]);
+    }
   }
 
-  //Adding permissions at the very end of object map
-  i=BaseObject::getGlobalId() + fkeys.size() + 1;
+  /* Foreign keys, fk relationships and permissions depend only on objects of the graph so they stay at the
+     end of the order, which also avoids the circular references between tables linked by foreign keys */
+  nodes.insert(nodes.end(), fkeys.begin(), fkeys.end());
+  nodes.insert(nodes.end(), fk_rels.begin(), fk_rels.end());
+  nodes.insert(nodes.end(), permissions.begin(), permissions.end());
+
+  graph.getCreationOrder(order, node_cycles);
+  objects_map.clear();
+
+  for(i=0; i < order.size(); i++)
+    objects_map[i]=nodes[order[i]];
 
-  for(auto obj : permissions)
+  if(cycles)
   {
-    objects_map[i]=obj;
-    i++;
+    cycles->clear();
+
+    for(auto &cycle : node_cycles)
+    {
+      cycles->push_back(vector<BaseObject *>());
+
+      for(auto node : cycle)
+        cycles->back().push_back(nodes[node]);
+    }
   }
 
   return(objects_map);
@@ -6674,7 +7202,8 @@ map<unsigned, BaseObject *> DatabaseModel::getCreationOrder(unsigned def_type)
 
 void DatabaseModel::saveModel(const QString &filename, unsigned def_type)
 {
-	QFile output(filename);
+	//The code is written on a temporary file which replaces the output file only when the generation succeeds
+	QSaveFile output(filename);
 	QByteArray buf;
 
 	output.open(QFile::WriteOnly);
@@ -6685,13 +7214,25 @@ void DatabaseModel::saveModel(const QString &filename, unsigned def_type)
 
 	try
 	{
-		buf.append(this->getCodeDefinition(def_type));
-		output.write(buf.data(),buf.size());
-		output.close();
+		//The SQL code is written on the file as it is generated
+		if(def_type==SchemaParser::SQL_DEFINITION)
+		{
+			SQLFileWriter writer(&output);
+			getSQLStatements(writer, true);
+		}
+		else
+		{
+			buf.append(this->getCodeDefinition(def_type));
+			output.write(buf.data(),buf.size());
+		}
+
+		if(!output.commit())
+			throw Exception(Exception::getErrorMessage(ERR_FILE_NOT_WRITTEN).arg(filename),
+											ERR_FILE_NOT_WRITTEN,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 	}
 	catch(Exception &e)
 	{
-		if(output.isOpen()) output.close();
+		output.cancelWriting();
 		throw Exception(Exception::getErrorMessage(ERR_FILE_NOT_WRITTER_INV_DEF).arg(filename),
 										ERR_FILE_NOT_WRITTER_INV_DEF,__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 	}
@@ -7112,10 +7653,566 @@ void DatabaseModel::getObjectDependecies(BaseObject *object, vector<BaseObject *
 	}
 }
 
+BaseObject *DatabaseModel::getUserTypeObject(PgSQLType type)
+{
+	void *ptype=type.getUserTypeReference();
+
+	if(!ptype)
+		return(nullptr);
+
+	switch(type.getUserTypeConfig())
+	{
+		case UserTypeConfig::BASE_TYPE:
+			return(static_cast<Type *>(ptype));
+		break;
+
+		case UserTypeConfig::DOMAIN_TYPE:
+			return(static_cast<Domain *>(ptype));
+		break;
+
+		case UserTypeConfig::TABLE_TYPE:
+			return(static_cast<Table *>(ptype));
+		break;
+
+		case UserTypeConfig::VIEW_TYPE:
+			return(static_cast<View *>(ptype));
+		break;
+
+		case UserTypeConfig::SEQUENCE_TYPE:
+			return(static_cast<Sequence *>(ptype));
+		break;
+
+		case UserTypeConfig::EXTENSION_TYPE:
+			return(static_cast<Extension *>(ptype));
+		break;
+
+		default:
+			return(nullptr);
+		break;
+	}
+}
+
+void DatabaseModel::addReference(vector<pair<BaseObject *, BaseObject *>> &refs, BaseObject *referrer, BaseObject *ref_obj)
+{
+	pair<BaseObject *, BaseObject *> ref=make_pair(referrer, ref_obj);
+
+	if(ref_obj && find(refs.begin(), refs.end(), ref)==refs.end())
+		refs.push_back(ref);
+}
+
+void DatabaseModel::addConstraintReferences(vector<pair<BaseObject *, BaseObject *>> &refs, BaseObject *referrer, Constraint *constr)
+{
+	ConstraintType constr_type=constr->getConstraintType();
+	unsigned i, count;
+
+	if(constr_type==ConstraintType::primary_key ||
+		 constr_type==ConstraintType::unique ||
+		 constr_type==ConstraintType::foreign_key)
+	{
+		count=constr->getColumnCount(Constraint::SOURCE_COLS);
+		for(i=0; i < count; i++)
+			addReference(refs, referrer, constr->getColumn(i, Constraint::SOURCE_COLS));
+
+		if(constr_type==ConstraintType::foreign_key)
+		{
+			count=constr->getColumnCount(Constraint::REFERENCED_COLS);
+			for(i=0; i < count; i++)
+				addReference(refs, referrer, constr->getColumn(i, Constraint::REFERENCED_COLS));
+		}
+	}
+	else if(constr_type==ConstraintType::exclude)
+	{
+		count=constr->getExcludeElementCount();
+		for(i=0; i < count; i++)
+			addReference(refs, referrer, constr->getExcludeElement(i).getColumn());
+	}
+}
+
+void DatabaseModel::getNodeReferences(BaseObject *node, vector<pair<BaseObject *, BaseObject *>> &refs)
+{
+	ObjectType obj_type=node->getObjectType();
+	unsigned i, i1, count;
+
+	refs.clear();
+
+	if(obj_type==OBJ_FUNCTION || obj_type==OBJ_TABLE || obj_type==OBJ_VIEW ||
+		 obj_type==OBJ_DOMAIN || obj_type==OBJ_AGGREGATE || obj_type==OBJ_OPERATOR ||
+		 obj_type==OBJ_SEQUENCE || obj_type==OBJ_CONVERSION ||
+		 obj_type==OBJ_TYPE || obj_type==OBJ_OPFAMILY || obj_type==OBJ_OPCLASS)
+		addReference(refs, node, node->getSchema());
+
+	if(obj_type==OBJ_DATABASE || obj_type==OBJ_FUNCTION || obj_type==OBJ_TABLE ||
+		 obj_type==OBJ_DOMAIN || obj_type==OBJ_AGGREGATE || obj_type==OBJ_SCHEMA ||
+		 obj_type==OBJ_OPERATOR || obj_type==OBJ_SEQUENCE || obj_type==OBJ_CONVERSION ||
+		 obj_type==OBJ_LANGUAGE || obj_type==OBJ_TABLESPACE || obj_type==OBJ_TYPE ||
+		 obj_type==OBJ_OPFAMILY || obj_type==OBJ_OPCLASS)
+		addReference(refs, node, node->getOwner());
+
+	if(obj_type==OBJ_DATABASE)
+		addReference(refs, node, this->BaseObject::getTablespace());
+
+	if(obj_type==OBJ_DOMAIN || obj_type==OBJ_COLLATION || obj_type==OBJ_TYPE)
+		addReference(refs, node, node->getCollation());
+
+	if(obj_type==OBJ_TABLE || obj_type==OBJ_VIEW)
+		addReference(refs, node, dynamic_cast<BaseTable *>(node)->getTag());
+
+	if(obj_type==OBJ_PERMISSION)
+		addReference(refs, node, dynamic_cast<Permission *>(node)->getObject());
+	else if(obj_type==OBJ_RELATIONSHIP)
+	{
+		Relationship *rel=dynamic_cast<Relationship *>(node);
+
+		addReference(refs, rel, rel->getTable(BaseRelationship::SRC_TABLE));
+		addReference(refs, rel, rel->getTable(BaseRelationship::DST_TABLE));
+
+		count=rel->getAttributeCount();
+		for(i=0; i < count; i++)
+			addReference(refs, rel, getUserTypeObject(rel->getAttribute(i)->getType()));
+
+		count=rel->getConstraintCount();
+		for(i=0; i < count; i++)
+			addConstraintReferences(refs, rel, rel->getConstraint(i));
+	}
+	else if(obj_type==BASE_RELATIONSHIP)
+	{
+		BaseRelationship *base_rel=dynamic_cast<BaseRelationship *>(node);
+		BaseTable *table=nullptr;
+
+		for(i=BaseRelationship::SRC_TABLE; i <= BaseRelationship::DST_TABLE; i++)
+		{
+			table=base_rel->getTable(i);
+			if(table && table->getObjectType()==OBJ_TABLE)
+				addReference(refs, base_rel, table);
+		}
+	}
+	else if(obj_type==OBJ_SEQUENCE)
+	{
+		Column *col=dynamic_cast<Sequence *>(node)->getOwnerColumn();
+
+		if(col)
+		{
+			addReference(refs, node, col);
+			addReference(refs, node, col->getParentTable());
+		}
+	}
+	else if(obj_type==OBJ_TABLE)
+	{
+		Table *table=dynamic_cast<Table *>(node);
+		Column *col=nullptr;
+		Constraint *constr=nullptr;
+		Trigger *trig=nullptr;
+		Index *ind=nullptr;
+		BaseTable *ref_tab=nullptr;
+
+		addReference(refs, table, table->getTablespace());
+
+		count=table->getColumnCount();
+		for(i=0; i < count; i++)
+		{
+			col=table->getColumn(i);
+
+			if(!col->isAddedByRelationship())
+				addReference(refs, col, getUserTypeObject(col->getType()));
+
+			addReference(refs, col, col->getCollation());
+		}
+
+		count=table->getConstraintCount();
+		for(i=0; i < count; i++)
+		{
+			constr=table->getConstraint(i);
+
+			//If a constraint references its own parent table it'll not be included on the references list
+			if(constr->getConstraintType()==ConstraintType::foreign_key &&
+				 constr->getParentTable()!=constr->getReferencedTable())
+				addReference(refs, constr, constr->getReferencedTable());
+
+			addReference(refs, constr, constr->getTablespace());
+
+			for(i1=0; i1 < constr->getExcludeElementCount(); i1++)
+				addReference(refs, constr, constr->getExcludeElement(i1).getOperatorClass());
+
+			addConstraintReferences(refs, constr, constr);
+		}
+
+		count=table->getTriggerCount();
+		for(i=0; i < count; i++)
+		{
+			trig=table->getTrigger(i);
+			ref_tab=trig->getReferencedTable();
+
+			if(ref_tab && ref_tab->getObjectType()==OBJ_TABLE)
+				addReference(refs, trig, ref_tab);
+
+			addReference(refs, trig, trig->getFunction());
+
+			for(i1=0; i1 < trig->getColumnCount(); i1++)
+				addReference(refs, trig, trig->getColumn(i1));
+		}
+
+		count=table->getIndexCount();
+		for(i=0; i < count; i++)
+		{
+			ind=table->getIndex(i);
+			addReference(refs, ind, ind->getTablespace());
+
+			for(i1=0; i1 < ind->getIndexElementCount(); i1++)
+			{
+				addReference(refs, ind, ind->getIndexElement(i1).getOperatorClass());
+				addReference(refs, ind, ind->getIndexElement(i1).getCollation());
+			}
+		}
+	}
+	else if(obj_type==OBJ_VIEW)
+	{
+		View *view=dynamic_cast<View *>(node);
+		Reference ref;
+
+		count=view->getReferenceCount();
+		for(i=0; i < count; i++)
+		{
+			ref=view->getReference(i);
+			addReference(refs, view, ref.getTable());
+			addReference(refs, view, ref.getColumn());
+		}
+	}
+	else if(obj_type==OBJ_FUNCTION)
+	{
+		Function *func=dynamic_cast<Function *>(node);
+
+		addReference(refs, func, getUserTypeObject(func->getReturnType()));
+
+		count=func->getParameterCount();
+		for(i=0; i < count; i++)
+			addReference(refs, func, getUserTypeObject(func->getParameter(i).getType()));
+
+		addReference(refs, func, func->getLanguage());
+	}
+	else if(obj_type==OBJ_CAST)
+	{
+		Cast *cast=dynamic_cast<Cast *>(node);
+
+		addReference(refs, cast, cast->getCastFunction());
+		addReference(refs, cast, getUserTypeObject(cast->getDataType(Cast::SRC_TYPE)));
+		addReference(refs, cast, getUserTypeObject(cast->getDataType(Cast::DST_TYPE)));
+	}
+	else if(obj_type==OBJ_CONVERSION)
+		addReference(refs, node, dynamic_cast<Conversion *>(node)->getConversionFunction());
+	else if(obj_type==OBJ_AGGREGATE)
+	{
+		Aggregate *aggreg=dynamic_cast<Aggregate *>(node);
+
+		addReference(refs, aggreg, aggreg->getFunction(Aggregate::FINAL_FUNC));
+		addReference(refs, aggreg, aggreg->getFunction(Aggregate::TRANSITION_FUNC));
+		addReference(refs, aggreg, aggreg->getSortOperator());
+
+		count=aggreg->getDataTypeCount();
+		for(i=0; i < count; i++)
+			addReference(refs, aggreg, getUserTypeObject(aggreg->getDataType(i)));
+	}
+	else if(obj_type==OBJ_OPERATOR)
+	{
+		Operator *oper=dynamic_cast<Operator *>(node);
+
+		addReference(refs, oper, oper->getFunction(Operator::FUNC_OPERATOR));
+		addReference(refs, oper, oper->getFunction(Operator::FUNC_JOIN));
+		addReference(refs, oper, oper->getFunction(Operator::FUNC_RESTRICT));
+		addReference(refs, oper, getUserTypeObject(oper->getArgumentType(Operator::LEFT_ARG)));
+		addReference(refs, oper, getUserTypeObject(oper->getArgumentType(Operator::RIGHT_ARG)));
+
+		for(i=Operator::OPER_COMMUTATOR; i <= Operator::OPER_NEGATOR; i++)
+			addReference(refs, oper, oper->getOperator(i));
+	}
+	else if(obj_type==OBJ_OPCLASS)
+	{
+		OperatorClass *op_class=dynamic_cast<OperatorClass *>(node);
+		OperatorClassElement elem;
+
+		addReference(refs, op_class, getUserTypeObject(op_class->getDataType()));
+		addReference(refs, op_class, op_class->getFamily());
+
+		count=op_class->getElementCount();
+		for(i=0; i < count; i++)
+		{
+			elem=op_class->getElement(i);
+			addReference(refs, op_class, getUserTypeObject(elem.getStorage()));
+			addReference(refs, op_class, elem.getFunction());
+			addReference(refs, op_class, elem.getOperator());
+		}
+	}
+	else if(obj_type==OBJ_TYPE)
+	{
+		Type *type=dynamic_cast<Type *>(node);
+
+		for(i=Type::INPUT_FUNC; i <= Type::ANALYZE_FUNC; i++)
+			addReference(refs, type, type->getFunction(i));
+
+		addReference(refs, type, getUserTypeObject(type->getAlignment()));
+		addReference(refs, type, getUserTypeObject(type->getElement()));
+		addReference(refs, type, getUserTypeObject(type->getLikeType()));
+		addReference(refs, type, getUserTypeObject(type->getSubtype()));
+		addReference(refs, type, type->getSubtypeOpClass());
+	}
+	else if(obj_type==OBJ_LANGUAGE)
+	{
+		Language *lang=dynamic_cast<Language *>(node);
+
+		addReference(refs, lang, lang->getFunction(Language::HANDLER_FUNC));
+		addReference(refs, lang, lang->getFunction(Language::VALIDATOR_FUNC));
+		addReference(refs, lang, lang->getFunction(Language::INLINE_FUNC));
+	}
+	else if(obj_type==OBJ_DOMAIN)
+		addReference(refs, node, getUserTypeObject(dynamic_cast<Domain *>(node)->getType()));
+	else if(obj_type==OBJ_ROLE)
+	{
+		Role *role=dynamic_cast<Role *>(node);
+		unsigned role_types[3]={Role::REF_ROLE, Role::MEMBER_ROLE, Role::ADMIN_ROLE};
+
+		for(i=0; i < 3; i++)
+		{
+			count=role->getRoleCount(role_types[i]);
+			for(i1=0; i1 < count; i1++)
+				addReference(refs, role, role->getRole(role_types[i], i1));
+		}
+	}
+}
+
+void DatabaseModel::updateNodeReferences(BaseObject *node)
+{
+	vector<pair<BaseObject *, BaseObject *>>::iterator itr, itr_end;
+	vector<pair<BaseObject *, BaseObject *>> &refs=node_refs[node];
+
+	itr=refs.begin();
+	itr_end=refs.end();
+
+	//Removing the references previously made by the node
+	while(itr!=itr_end)
+	{
+		obj_referrers[itr->second].erase(itr->first);
+
+		if(obj_referrers[itr->second].empty())
+			obj_referrers.erase(itr->second);
+
+		itr++;
+	}
+
+	getNodeReferences(node, refs);
+
+	itr=refs.begin();
+	itr_end=refs.end();
+
+	while(itr!=itr_end)
+	{
+		obj_referrers[itr->second].insert(itr->first);
+		itr++;
+	}
+}
+
+void DatabaseModel::removeNodeReferences(BaseObject *node)
+{
+	vector<pair<BaseObject *, BaseObject *>>::iterator itr, itr_end;
+
+	if(node_refs.count(node)==0)
+		return;
+
+	itr=node_refs[node].begin();
+	itr_end=node_refs[node].end();
+
+	while(itr!=itr_end)
+	{
+		obj_referrers[itr->second].erase(itr->first);
+
+		if(obj_referrers[itr->second].empty())
+			obj_referrers.erase(itr->second);
+
+		itr++;
+	}
+
+	node_refs.erase(node);
+}
+
+void DatabaseModel::updateReferencesGraph(void)
+{
+	set<BaseObject *>::iterator itr, itr_end;
+	set<BaseObject *> nodes;
+	vector<BaseObject *>::iterator itr_rel, itr_rel_end;
+	TableObject *tab_obj=nullptr;
+	BaseObject *node=nullptr, *owners[]={ this, nullptr };
+	bool found=false;
+
+	{
+		QMutexLocker locker(&BaseObject::invalidated_refs_mutex);
+
+		/* Only the objects invalidated while belonging to this model and the ones that didn't belong to any
+		 model are checked. The objects of other models are left untouched */
+		for(unsigned i=0; i < 2; i++)
+		{
+			if(BaseObject::invalidated_refs.count(owners[i])==0)
+				continue;
+
+			set<BaseObject *> &objects=BaseObject::invalidated_refs[owners[i]];
+			itr=objects.begin();
+			itr_end=objects.end();
+
+			while(itr!=itr_end)
+			{
+				node=(*itr);
+				tab_obj=dynamic_cast<TableObject *>(node);
+				found=false;
+
+				if(tab_obj)
+				{
+					/* Columns and constraints that belongs to relationships (attributes) have their
+					 references stored in the node of the relationship */
+					if((tab_obj->getObjectType()==OBJ_COLUMN || tab_obj->getObjectType()==OBJ_CONSTRAINT) &&
+						 (!tab_obj->getParentTable() || tab_obj->isAddedByRelationship()))
+					{
+						itr_rel=relationships.begin();
+						itr_rel_end=relationships.end();
+
+						while(itr_rel!=itr_rel_end)
+						{
+							if(dynamic_cast<Relationship *>(*itr_rel)->getObjectIndex(tab_obj) >= 0)
+							{
+								nodes.insert(*itr_rel);
+								found=true;
+							}
+							itr_rel++;
+						}
+					}
+
+					if(tab_obj->getParentTable())
+						node=tab_obj->getParentTable();
+				}
+
+				if(node_refs.count(node))
+				{
+					nodes.insert(node);
+					found=true;
+				}
+
+				/* Objects that doesn't belong to any model are kept on the map because they
+				 can be nodes (or children of nodes) of another model */
+				if(found || owners[i])
+					objects.erase(itr++);
+				else
+					itr++;
+			}
+
+			if(objects.empty())
+				BaseObject::invalidated_refs.erase(owners[i]);
+		}
+	}
+
+	for(itr=nodes.begin(); itr!=nodes.end(); itr++)
+		updateNodeReferences(*itr);
+}
+
 void DatabaseModel::getObjectReferences(BaseObject *object, vector<BaseObject *> &refs, bool exclusion_mode)
 {
 	refs.clear();
 
+	if(object)
+	{
+		map<BaseObject *, set<BaseObject *>>::iterator itr_ref;
+		set<BaseObject *>::iterator itr, itr_end;
+		map<unsigned, BaseObject *> sorted_refs;
+		map<unsigned, BaseObject *>::iterator itr_sort;
+		BaseRelationship *base_rel=nullptr;
+
+		updateReferencesGraph();
+		itr_ref=obj_referrers.find(object);
+
+		if(itr_ref!=obj_referrers.end())
+		{
+			itr=itr_ref->second.begin();
+			itr_end=itr_ref->second.end();
+
+			while(itr!=itr_end)
+			{
+				base_rel=dynamic_cast<BaseRelationship *>(*itr);
+
+				/* As base relationship are created automatically by the model they aren't considered
+				as a reference to the table in exclusion mode (except fk relationships) */
+				if(!exclusion_mode || !base_rel || base_rel->getObjectType()!=BASE_RELATIONSHIP ||
+					 base_rel->getRelationshipType()==BaseRelationship::RELATIONSHIP_FK)
+					sorted_refs[(*itr)->getObjectId()]=(*itr);
+
+				itr++;
+			}
+
+			//The references are returned sorted by id so the creation order is preserved
+			for(itr_sort=sorted_refs.begin(); itr_sort!=sorted_refs.end(); itr_sort++)
+			{
+				refs.push_back(itr_sort->second);
+
+				if(exclusion_mode)
+					break;
+			}
+		}
+	}
+}
+
+#ifdef QT_DEBUG
+void DatabaseModel::checkReferencesGraph(vector<BaseObject *> &inv_objs)
+{
+	ObjectType types[]={ OBJ_TABLE, OBJ_VIEW, OBJ_FUNCTION, OBJ_SCHEMA, OBJ_TYPE, OBJ_DOMAIN,
+											 OBJ_SEQUENCE, OBJ_EXTENSION, OBJ_ROLE, OBJ_TABLESPACE, OBJ_LANGUAGE,
+											 OBJ_OPCLASS, OBJ_OPERATOR, OBJ_OPFAMILY, OBJ_COLLATION, OBJ_TAG };
+	vector<BaseObject *> objects, refs, aux_refs;
+	vector<BaseObject *>::iterator itr, itr_end;
+	vector<TableObject *> *tab_objs=nullptr;
+	map<unsigned, BaseObject *> sorted_refs;
+	map<unsigned, BaseObject *>::iterator itr_sort;
+	vector<BaseObject *> *obj_list=nullptr;
+	unsigned i, count=sizeof(types)/sizeof(ObjectType);
+
+	inv_objs.clear();
+
+	for(i=0; i < count; i++)
+	{
+		obj_list=getObjectList(types[i]);
+		objects.insert(objects.end(), obj_list->begin(), obj_list->end());
+	}
+
+	//Columns are checked too since they can be referenced by sequences, views, constraints, etc.
+	for(i=0; i < tables.size(); i++)
+	{
+		tab_objs=dynamic_cast<Table *>(tables[i])->getObjectList(OBJ_COLUMN);
+		objects.insert(objects.end(), tab_objs->begin(), tab_objs->end());
+	}
+
+	itr=objects.begin();
+	itr_end=objects.end();
+
+	while(itr!=itr_end)
+	{
+		getObjectReferences(*itr, refs);
+		__getObjectReferences(*itr, aux_refs);
+
+		//The scan can return the same object more than once and in a different order
+		sorted_refs.clear();
+		for(i=0; i < aux_refs.size(); i++)
+			sorted_refs[aux_refs[i]->getObjectId()]=aux_refs[i];
+
+		aux_refs.clear();
+		for(itr_sort=sorted_refs.begin(); itr_sort!=sorted_refs.end(); itr_sort++)
+			aux_refs.push_back(itr_sort->second);
+
+		if(refs!=aux_refs)
+			inv_objs.push_back(*itr);
+
+		itr++;
+	}
+}
+#endif
+
+#ifdef QT_DEBUG
+void DatabaseModel::__getObjectReferences(BaseObject *object, vector<BaseObject *> &refs, bool exclusion_mode)
+{
+	refs.clear();
+
 	if(object)
 	{
 		vector<BaseObject *>::iterator itr_perm, itr_perm_end;
@@ -7686,7 +8783,7 @@ void DatabaseModel::getObjectReferences(BaseObject *object, vector<BaseObject *>
 				for(i1=0; i1 < 3 && (!exclusion_mode || (exclusion_mode && !refer)); i1++)
 				{
 					count=role_aux->getRoleCount(role_types[i1]);
-					for(i=0; i < count && !refer; i++)
+					for(i=0; i < count && (!exclusion_mode || (exclusion_mode && !refer)); i++)
 					{
 						if(role_aux->getRole(role_types[i1], i)==role)
 						{
@@ -7911,7 +9008,7 @@ void DatabaseModel::getObjectReferences(BaseObject *object, vector<BaseObject *>
 				}
 				else if(obj_types[i]==OBJ_OPERATOR)
 				{
-					while(itr!=itr_end && !refer)
+					while(itr!=itr_end && (!exclusion_mode || (exclusion_mode && !refer)))
 					{
 						oper_aux=dynamic_cast<Operator *>(*itr);
 						itr++;
@@ -8110,6 +9207,7 @@ void DatabaseModel::getObjectReferences(BaseObject *object, vector<BaseObject *>
     }
 	}
 }
+#endif
 
 void DatabaseModel::setObjectsModified(vector<ObjectType> types)
 {
@@ -8411,6 +9509,16 @@ bool DatabaseModel::isInvalidated(void)
 	return(invalidated);
 }
 
+void DatabaseModel::setParallelCodeGeneration(bool value)
+{
+	parallel_code_gen=value;
+}
+
+bool DatabaseModel::isParallelCodeGeneration(void)
+{
+	return(parallel_code_gen);
+}
+
 void  DatabaseModel::setAppendAtEOD(bool value)
 {
 	append_at_eod=value;
@@ -30,6 +30,8 @@ Additionally, this class, saves, loads and generates the XML/SQL definition of a
 #include <QFile>
 #include <QObject>
 #include <QStringList>
+#include <QHash>
+#include <QAtomicInt>
 #include "baseobject.h"
 #include "table.h"
 #include "function.h"
@@ -55,6 +57,31 @@ Additionally, this class, saves, loads and generates the XML/SQL definition of a
 #include <algorithm>
 #include <locale.h>
 
+/*! \brief Stores a single statement of the model's SQL code generated by DatabaseModel::getSQLStatements() along with
+ the type, id and name of the object that generated it. The SQL is stored as written on the model's code (including
+ comments and the ddl end token) so the statements can be written on a file as is. The command to be sent to the server
+ is retrieved by getCommand() */
+class SQLStatement {
+	public:
+		ObjectType obj_type;
+		unsigned obj_id;
+		QString name, sql;
+
+		SQLStatement(BaseObject *object, const QString &sql);
+
+		//! \brief Returns the executable command of the statement (without commented and blank lines)
+		QString getCommand(void) const;
+};
+
+//! \brief Interface implemented by the classes that consume the statements generated by DatabaseModel::getSQLStatements()
+class SQLStatementHandler {
+	public:
+		virtual ~SQLStatementHandler(void) {}
+
+		//! \brief Receives the statements in the same order they appear on the model's SQL code
+		virtual void handleStatement(const SQLStatement &stmt)=0;
+};
+
 class DatabaseModel:  public QObject, public BaseObject {
 	private:
 		Q_OBJECT
@@ -103,6 +130,35 @@ class DatabaseModel:  public QObject, public BaseObject {
 		 when revalidating the relationships */
 		map<unsigned, QString> xml_special_objs;
 
+		/*! \brief Indexes used by getObject() to find objects by their formatted name (or signature
+		 for functions and operators) without quotes. Each index stores the position of the objects
+		 on the list of its type and is rebuilt when the list size differs from the one stored
+		 in name_indexes_size or when the objects' names changed (see name_version) */
+		map<ObjectType, QHash<QString, unsigned>> name_indexes;
+
+		//! \brief Size of the object lists when the name indexes were built
+		map<ObjectType, unsigned> name_indexes_size;
+
+		/*! \brief Incremented every time an object of the model has its name, schema or signature changed.
+		 Atomic since the objects can be changed by worker threads (e.g. import and validation) */
+		QAtomicInt name_version;
+
+		//! \brief Name version of the current name indexes
+		int name_indexes_version;
+
+		//! \brief Increments the name version discarding the current name indexes (see BaseObject::updateNameVersion())
+		void incrementNameVersion(void);
+
+		/*! \brief Stores the references created by each node of the references graph. A node is an object
+		 stored directly on the model (including the model itself) and each reference is a pair
+		 [referrer object, referenced object] where the referrer can be the node or one of its children
+		 (e.g. columns, constraints, triggers and indexes of a table) */
+		map<BaseObject *, vector<pair<BaseObject *, BaseObject *>>> node_refs;
+
+		/*! \brief Reverse references graph: stores for each referenced object the objects referencing it.
+		 This map is used by getObjectReferences() instead of scanning all the model objects */
+		map<BaseObject *, set<BaseObject *>> obj_referrers;
+
 		//! \brief Indicates if the model is being loaded
 		bool loading_model,
 
@@ -111,12 +167,21 @@ class DatabaseModel:  public QObject, public BaseObject {
 		invalidated,
 
 		//! \brief Indicates that appended SQL commands must be put at the very end of model definition
-		append_at_eod;
+		append_at_eod,
+
+		//! \brief Indicates that the objects' SQL code must be generated in parallel (see setParallelCodeGeneration())
+		parallel_code_gen;
 
 		/*! \brief Returns an object seaching it by its name and type. The third parameter stores
 		 the object index */
 		BaseObject *getObject(const QString &name, ObjectType obj_type, int &obj_idx);
 
+		//! \brief Returns the name index of the specified object type, rebuilding it if it's outdated
+		QHash<QString, unsigned> &getNameIndex(ObjectType obj_type);
+
+		//! \brief Returns the key used by the name indexes for the specified object
+		static QString getNameIndexKey(BaseObject *object);
+
 		//! \brief Generic method that adds an object to the model
 		void __addObject(BaseObject *object, int obj_idx=-1);
 
@@ -127,6 +192,26 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Recreates the special object from the passed xml code buffer
 		void createSpecialObject(const QString &xml_def, unsigned obj_id=0);
 
+		/*! \brief Stores the XML of the special objects (see storeSpecialObjectsXML()) related to the changed tables:
+		 objects owned by or referencing them. When 'changed_tabs' is not allocated all the special objects are stored */
+		void storeSpecialObjectsXML(set<Table *> *changed_tabs);
+
+		//! \brief Returns if the view references at least one of the specified tables
+		static bool isViewReferencingTables(View *view, set<Table *> &tables);
+
+		//! \brief Disconnects the specified relationships from the last to the first
+		void disconnectRelationships(vector<BaseObject *> &rels);
+
+		/*! \brief Returns the relationships that need to be reconnected, in the same order they are on the model:
+		 the invalidated ones and the ones that copy columns from a changed table (directly or through the columns
+		 propagated by other affected relationships). The tables that receive columns from the returned relationships
+		 are inserted on 'changed_tabs'. The relationships that are still valid are returned on 'valid_rels' */
+		void getAffectedRelationships(set<Table *> &changed_tabs, vector<BaseObject *> &valid_rels, vector<BaseObject *> &inv_rels);
+
+		/*! \brief Reconnects the invalidated relationships and the ones affected by the changed tables, recreating
+		 the special objects related to them */
+		void revalidateRelationships(set<Table *> &changed_tabs);
+
 		//! \brief Removes an user defined type (domain or type)
 		void removeUserType(BaseObject *object, int obj_idx);
 
@@ -134,12 +219,66 @@ class DatabaseModel:  public QObject, public BaseObject {
 		 returned object can be: table, sequence, domain or type */
 		BaseObject *getObjectPgSQLType(PgSQLType type);
 
+		//! \brief Returns the object that represents the user defined type (table, sequence, domain, etc.) without searching it by name
+		static BaseObject *getUserTypeObject(PgSQLType type);
+
+		//! \brief Appends the reference [referrer, ref_obj] to the list if ref_obj is allocated and the reference is not on the list
+		static void addReference(vector<pair<BaseObject *, BaseObject *>> &refs, BaseObject *referrer, BaseObject *ref_obj);
+
+		//! \brief Appends to the list the references to columns made by the constraint (the referrer can be the constraint itself or a relationship)
+		static void addConstraintReferences(vector<pair<BaseObject *, BaseObject *>> &refs, BaseObject *referrer, Constraint *constr);
+
+		//! \brief Returns all the references made by the node (including the ones made by its children)
+		void getNodeReferences(BaseObject *node, vector<pair<BaseObject *, BaseObject *>> &refs);
+
+		//! \brief Recreates the references made by the node on the references graph
+		void updateNodeReferences(BaseObject *node);
+
+		//! \brief Removes the node and the references made by it from the references graph
+		void removeNodeReferences(BaseObject *node);
+
+		/*! \brief Updates the nodes of the references graph related to the objects that had their
+		 references changed since the last update (see BaseObject::invalidateReferences()) */
+		void updateReferencesGraph(void);
+
+#ifdef QT_DEBUG
+		//! \brief Returns the objects referencing the passed one scanning all the model objects (used to check the references graph)
+		void __getObjectReferences(BaseObject *object, vector<BaseObject *> &refs, bool exclusion_mode=false);
+#endif
+
 		//! \brief Creates a IndexElement or ExcludeElement from XML depending on type of the 'elem' param.
 		void createElement(Element &elem, TableObject *tab_obj, BaseObject *parent_obj);
 
 		//! \brief Creates a desambiguation name composed by the object name as well it`s id
 		QString generateUniqueName(BaseObject *obj);
 
+		/*! \brief Generates the complete code definition for the entire model. When 'handler' is allocated (only for SQL)
+		 the code is streamed to it statement by statement, instead of being concatenated on the returned code, which is
+		 empty in that case (see getSQLStatements()) */
+		QString getCodeDefinition(unsigned def_type, bool export_file, SQLStatementHandler *handler);
+
+		/*! \brief Generates the code of a single object of the model, appending it to the attribute of the model's schema file
+		 where it is inserted (see appendCodeDefinition()). The search path is updated when the object is a schema */
+		void getObjectCodeDefinition(BaseObject *object, unsigned def_type, attribs_map &attribs, SQLStatementHandler *handler, QString &search_path);
+
+		/*! \brief Returns if the object has its SQL code placed before the other objects on the model's code
+		 (roles, tablespaces, database, schemas and the shell types of base types) */
+		static bool isPrecedingObject(BaseObject *object);
+
+		//! \brief Emits the code generation progress of the object
+		void emitGenerationProgress(BaseObject *object, float progress, const QString &msg);
+
+		/*! \brief Appends the complete SQL definition of the base types (generated after the other objects) and restores
+		 the parameters of the functions used by them (see Type::convertFunctionParameters()) */
+		void appendBaseTypesDefinition(attribs_map &attribs, SQLStatementHandler *handler);
+
+		//! \brief Appends the code of the object to the attribute or streams it to the handler when it is allocated
+		static void appendCodeDefinition(attribs_map &attribs, SQLStatementHandler *handler,
+																		 const QString &attrib, BaseObject *object, const QString &code);
+
+		//! \brief Splits the code of the object in statements (using the ddl end token) and sends them to the handler
+		static void emitStatements(SQLStatementHandler &handler, BaseObject *object, const QString &code);
+
 	public:
 		DatabaseModel(void);
 		~DatabaseModel(void);
@@ -154,7 +293,8 @@ class DatabaseModel:  public QObject, public BaseObject {
 		 by relationship) in order to be reconstructed in a posterior moment */
 		void storeSpecialObjectsXML(void);
 
-		//! \brief Validates all the relationship, propagating all column modifications over the tables
+		/*! \brief Validates the relationships, propagating all column modifications over the tables. Only the invalidated
+		 relationships and the ones affected by them are reconnected (see getAffectedRelationships()) */
 		void validateRelationships(void);
 
 		//! \brief Returns the list of specified object type that belongs to the passed schema
@@ -169,6 +309,11 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Retuns the passed object index
 		int getObjectIndex(BaseObject *object);
 
+		/*! \brief Emits the s_objectModified() signal for the specified object. This method must be called
+		by the ones that change an object already inserted on the model (e.g. the editing forms) so the
+		views attached to the model can update only the items related to that object */
+		void notifyObjectModified(BaseObject *object);
+
 		//! \brief Adds an object to the model
 		void addObject(BaseObject *object, int obj_idx=-1);
 
@@ -181,8 +326,9 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Returns an object from the model using its index and type
 		BaseObject *getObject(unsigned obj_idx, ObjectType obj_type);
 
-		//! \brief Loads a database model from a file
-		void loadModel(const QString &filename);
+		/*! \brief Loads a database model from a file. The file is read element by element creating the objects as their
+		 elements are read. When 'validate' is true the file is validated against the model's DTD while it is read */
+		void loadModel(const QString &filename, bool validate=true);
 
 		//! \brief Sets the database encoding
 		void setEncoding(EncodingType encod);
@@ -238,6 +384,15 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Indicate if the model invalidated
 		void setInvalidated(bool value);
 
+		/*! \brief Enables the generation of the objects' SQL code in parallel when running getCodeDefinition().
+		 The definitions are generated on a thread pool, stored in creation order and concatenated at the end,
+		 so the resulting code is the same as the one generated serially. The XML code is always generated
+		 serially since in that mode the objects reuse the attributes of the referenced objects (schema, owner, etc.) */
+		void setParallelCodeGeneration(bool value);
+
+		//! \brief Returns if the objects' SQL code is generated in parallel
+		bool isParallelCodeGeneration(void);
+
 		//! \brief Saves the specified code definition for the model on the specified filename
 		void saveModel(const QString &filename, unsigned def_type);
 
@@ -249,10 +404,20 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Returns the complete SQL/XML definition for the entire model (including all the other objects).
 		virtual QString getCodeDefinition(unsigned def_type) final;
 
+		/*! \brief Generates the model's SQL code sending it to the handler one statement at time, in the same order and
+		 format of getCodeDefinition(), so the whole code doesn't need to be kept in memory. General statements (header,
+		 SET commands, appended SQL) are sent as generated by the model itself. The 'export_file' parameter has the same
+		 meaning as in getCodeDefinition(), when it is false roles, tablespaces and the database aren't generated */
+		void getSQLStatements(SQLStatementHandler &handler, bool export_file);
+
 		//! \brief Returns the code definition only for the database (excluding the definition of the other objects)
 		QString __getCodeDefinition(unsigned def_type);
 
-    map<unsigned, BaseObject *> getCreationOrder(unsigned def_type);
+		/*! \brief Returns the objects in the order their code must be generated, keyed by their position in that order.
+		 The order is computed from the dependencies between the objects (see DependencyGraph) keeping the id order
+		 for the objects that don't depend on each other. Foreign keys, fk relationships and permissions are placed at the end.
+		 When 'cycles' is specified it receives the groups of objects with circular dependencies (kept in id order) */
+		map<unsigned, BaseObject *> getCreationOrder(unsigned def_type, vector<vector<BaseObject *> > *cycles=nullptr);
 
 		void addRelationship(BaseRelationship *rel, int obj_idx=-1);
 		void removeRelationship(BaseRelationship *rel, int obj_idx=-1);
@@ -422,9 +587,16 @@ class DatabaseModel:  public QObject, public BaseObject {
 
 		/*! \brief Returns all the objects that references the passed object. The boolean paramenter is used to performance purpose,
 		 generally applied when excluding objects, this means that the method will stop the search when the first
-		 reference is found */
+		 reference is found. The returned objects are sorted by their ids and are retrieved from the references graph
+		 which is updated only for the objects that had their references changed since the last call */
 		void getObjectReferences(BaseObject *object, vector<BaseObject *> &refs, bool exclusion_mode=false);
 
+#ifdef QT_DEBUG
+		/*! \brief Compares the references retrieved from the references graph with the ones found by scanning all the
+		 model objects. The objects which references differ are stored on the vector. Used for debugging purposes */
+		void checkReferencesGraph(vector<BaseObject *> &inv_objs);
+#endif
+
     /*! \brief Marks the graphical objects as modified forcing their redraw. User can specify only a set of
      graphical objects to be marked */
     void setObjectsModified(vector<ObjectType> types={});
@@ -452,6 +624,9 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Signal emitted when an object is removed from the model
 		void s_objectRemoved(BaseObject *object);
 
+		//! \brief Signal emitted when an object of the model is modified (see notifyObjectModified())
+		void s_objectModified(BaseObject *object);
+
 		//! \brief Signal emitted when an object is created from a xml code
 		void s_objectLoaded(int progress, QString object_id, unsigned obj_type);
 };
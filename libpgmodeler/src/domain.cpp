@@ -79,6 +79,7 @@ void Domain::setNotNull(bool value)
 void Domain::setType(PgSQLType type)
 {
 	this->type=type;
+	invalidateReferences();
 }
 
 QString Domain::getConstraintName(void)
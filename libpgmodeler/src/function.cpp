@@ -66,6 +66,8 @@ void Function::addParameter(Parameter param)
 	vector<Parameter>::iterator itr,itr_end;
 	bool found=false;
 
+	invalidateReferences();
+
 	itr=parameters.begin();
 	itr_end=parameters.end();
 
@@ -191,6 +193,8 @@ void Function::setSymbol(const QString &symbol)
 
 void Function::setReturnType(PgSQLType type)
 {
+	invalidateReferences();
+
 	return_type=type;
 }
 
@@ -201,6 +205,8 @@ void Function::setFunctionType(FunctionType func_type)
 
 void Function::setLanguage(BaseObject *language)
 {
+	invalidateReferences();
+
 	//Raises an error if the language is not allocated
 	if(!language)
 		throw Exception(ERR_ASG_NOT_ALOC_LANGUAGE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -348,6 +354,7 @@ void Function::removeParameters(void)
 {
 	parameters.clear();
 	createSignature();
+	invalidateReferences();
 }
 
 void Function::removeReturnedTableColumns(void)
@@ -359,6 +366,8 @@ void Function::removeParameter(const QString &name, PgSQLType type)
 {
 	vector<Parameter>::iterator itr,itr_end;
 
+	invalidateReferences();
+
 	itr=parameters.begin();
 	itr_end=parameters.end();
 
@@ -379,6 +388,8 @@ void Function::removeParameter(const QString &name, PgSQLType type)
 
 void Function::removeParameter(unsigned param_idx)
 {
+	invalidateReferences();
+
 	//Raises an error if parameter index is out of bound
 	if(param_idx>=parameters.size())
 		throw Exception(ERR_REF_PARAM_INV_INDEX,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -424,6 +435,7 @@ void Function::createSignature(bool format, bool prepend_schema)
 
 	//Signature format NAME(IN|OUT PARAM1_TYPE,IN|OUT PARAM2_TYPE,...,IN|OUT PARAMn_TYPE)
 	signature=this->getName(format, prepend_schema) + QString("(") + str_param + QString(")");
+	updateNameVersion();
 }
 
 QString Function::getCodeDefinition(unsigned def_type)
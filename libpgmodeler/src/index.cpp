@@ -72,6 +72,8 @@ int Index::getElementIndex(IndexElement elem)
 
 void Index::addIndexElement(IndexElement elem)
 {
+	invalidateReferences();
+
 	if(getElementIndex(elem) >= 0)
 		throw Exception(ERR_INS_DUPLIC_ELEMENT,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 	else if(elem.getExpression().isEmpty() && !elem.getColumn())
@@ -82,6 +84,8 @@ void Index::addIndexElement(IndexElement elem)
 
 void Index::addIndexElement(const QString &expr, Collation *coll, OperatorClass *op_class, bool use_sorting, bool asc_order, bool nulls_first)
 {
+	invalidateReferences();
+
 	try
 	{
 		IndexElement elem;
@@ -111,6 +115,8 @@ void Index::addIndexElement(const QString &expr, Collation *coll, OperatorClass
 
 void Index::addIndexElement(Column *column, Collation *coll, OperatorClass *op_class, bool use_sorting, bool asc_order, bool nulls_first)
 {
+	invalidateReferences();
+
 	try
 	{
 		IndexElement elem;
@@ -144,6 +150,8 @@ void Index::addIndexElements(vector<IndexElement> &elems)
 {
 	vector<IndexElement> elems_bkp=idx_elements;
 
+	invalidateReferences();
+
 	try
 	{
 		idx_elements.clear();
@@ -160,6 +168,8 @@ void Index::addIndexElements(vector<IndexElement> &elems)
 
 void Index::removeIndexElement(unsigned idx_elem)
 {
+	invalidateReferences();
+
 	if(idx_elem >= idx_elements.size())
 		throw Exception(ERR_REF_ELEM_INV_INDEX,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
@@ -169,6 +179,7 @@ void Index::removeIndexElement(unsigned idx_elem)
 void Index::removeIndexElements(void)
 {
 	idx_elements.clear();
+	invalidateReferences();
 }
 
 IndexElement Index::getIndexElement(unsigned elem_idx)
@@ -266,7 +277,7 @@ bool Index::isReferCollation(Collation *collation)
 	//Checks if some of the elements is referencing the collation
 	while(itr!=itr_end && !found)
 	{
-		found=(collation && (*itr).getCollation());
+		found=(collation && (*itr).getCollation()==collation);
 		itr++;
 	}
 
@@ -53,6 +53,8 @@ void  Language::setFunction(Function *func, unsigned func_type)
 {
 	LanguageType lang=LanguageType::c;
 
+	invalidateReferences();
+
 	if(!func ||
 		 (func &&
 			/* The handler function must be written in C and have
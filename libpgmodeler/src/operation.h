@@ -28,6 +28,7 @@
 #include "baseobject.h"
 #include "permission.h"
 #include <QString>
+#include <QPointF>
 
 class Operation {
 	protected:
@@ -60,6 +61,10 @@ class Operation {
 		//! \brief Stores the object's permission before it's removal
 		vector<Permission *> permissions;
 
+		/*! \brief Stores the object's position in position only operations (see OperationList::isPositionOnlyOperation).
+		In this kind of operation the pool stores the original object instead of a copy */
+		QPointF position;
+
 	public:
 		//! \brief Constants used to reference the type of operations
 		static const unsigned OBJECT_MODIFIED=0,
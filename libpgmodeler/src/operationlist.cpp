@@ -53,6 +53,82 @@ int OperationList::getCurrentIndex(void)
 	return(current_index);
 }
 
+unsigned OperationList::getMemoryUsage(void)
+{
+	unsigned size=0;
+
+	for(auto oper : operations)
+	{
+		size+=sizeof(Operation) + (oper->xml_definition.capacity() * sizeof(QChar)) +
+					(oper->permissions.capacity() * sizeof(Permission *));
+
+		//Only the copies of objects are owned by the list
+		if(oper->pool_obj!=oper->original_obj)
+			size+=getObjectSize(oper->pool_obj);
+	}
+
+	//Objects removed from the pool that are still waiting to be deleted (see removeFromPool())
+	for(auto object : set<BaseObject *>(not_removed_objs.begin(), not_removed_objs.end()))
+	{
+		if(!isObjectReferenced(object))
+			size+=getObjectSize(object);
+	}
+
+	return(size + ((object_pool.size() + not_removed_objs.capacity()) * sizeof(BaseObject *)));
+}
+
+unsigned OperationList::getObjectSize(BaseObject *object)
+{
+	unsigned size=0;
+
+	if(!object)
+		return(0);
+
+	switch(object->getObjectType())
+	{
+		case OBJ_RELATIONSHIP: size=sizeof(Relationship); break;
+		case BASE_RELATIONSHIP: size=sizeof(BaseRelationship); break;
+		case OBJ_COLUMN: size=sizeof(Column); break;
+		case OBJ_CONSTRAINT: size=sizeof(Constraint); break;
+		case OBJ_TRIGGER: size=sizeof(Trigger); break;
+		case OBJ_RULE: size=sizeof(Rule); break;
+		case OBJ_INDEX: size=sizeof(Index); break;
+		case OBJ_TABLE: size=sizeof(Table); break;
+		case OBJ_TEXTBOX: size=sizeof(Textbox); break;
+		case OBJ_OPCLASS: size=sizeof(OperatorClass); break;
+		case OBJ_CONVERSION: size=sizeof(Conversion); break;
+		case OBJ_CAST: size=sizeof(Cast); break;
+		case OBJ_DOMAIN: size=sizeof(Domain); break;
+		case OBJ_TABLESPACE: size=sizeof(Tablespace); break;
+		case OBJ_SCHEMA: size=sizeof(Schema); break;
+		case OBJ_OPFAMILY: size=sizeof(OperatorFamily); break;
+		case OBJ_FUNCTION: size=sizeof(Function); break;
+		case OBJ_AGGREGATE: size=sizeof(Aggregate); break;
+		case OBJ_LANGUAGE: size=sizeof(Language); break;
+		case OBJ_OPERATOR: size=sizeof(Operator); break;
+		case OBJ_ROLE: size=sizeof(Role); break;
+		case OBJ_SEQUENCE: size=sizeof(Sequence); break;
+		case OBJ_TYPE: size=sizeof(Type); break;
+		case OBJ_VIEW: size=sizeof(View); break;
+		case OBJ_COLLATION: size=sizeof(Collation); break;
+		case OBJ_EXTENSION: size=sizeof(Extension); break;
+		case OBJ_TAG: size=sizeof(Tag); break;
+		default: size=sizeof(BaseObject); break;
+	}
+
+	//Adding the size of the texts held by the object
+	size+=(object->getName().capacity() + object->getComment().capacity()) * sizeof(QChar);
+
+	return(size);
+}
+
+bool OperationList::isPositionOnlyOperation(BaseObject *object, unsigned op_type)
+{
+	return(op_type==Operation::OBJECT_MOVED &&
+				 dynamic_cast<BaseGraphicObject *>(object) &&
+				 !dynamic_cast<BaseRelationship *>(object));
+}
+
 void OperationList::startOperationChain(void)
 {
 	/* If the chaining is started and the user try it initializes
@@ -144,7 +220,7 @@ void OperationList::addToPool(BaseObject *object, unsigned op_type)
 
 		//Stores a copy of the object if its about to be moved or modified
 		if(op_type==Operation::OBJECT_MODIFIED ||
-			 op_type==Operation::OBJECT_MOVED)
+			 (op_type==Operation::OBJECT_MOVED && !isPositionOnlyOperation(object, op_type)))
 		{
 			BaseObject *copy_obj=nullptr;
 
@@ -161,8 +237,11 @@ void OperationList::addToPool(BaseObject *object, unsigned op_type)
 				object_pool.push_back(copy_obj);
 		}
 		else
-			//Inserts the original object on the pool (in case of adition or deletion operations)
+			/* Inserts the original object on the pool (in case of adition or deletion operations
+			or position only operations) */
 			object_pool.push_back(object);
+
+		pool_refs[object_pool.back()]++;
 	}
 	catch(Exception &e)
 	{
@@ -233,54 +312,146 @@ void OperationList::removeOperations(void)
 
 	current_index=0;
 	unallocated_objs.clear();
+	pool_refs.clear();
 }
 
 void OperationList::validateOperations(void)
 {
-	vector<Operation *>::iterator itr, itr_end;
-	Operation *oper=nullptr;
+	deque<Operation *> valid_ops;
 
-	itr=operations.begin();
-	itr_end=operations.end();
-	while(itr!=itr_end)
+	//Keeps only the operations which object is on the pool, removing the others in a single pass
+	for(auto oper : operations)
 	{
-		oper=(*itr);
-		//Case the object isn't on the pool
-		if(!isObjectOnPool((*itr)->pool_obj))
-		{
-			//Remove the operation
-			operations.erase(itr);
+		if(isObjectOnPool(oper->pool_obj))
+			valid_ops.push_back(oper);
+		else
 			delete(oper);
-			itr=operations.begin();
-			itr_end=operations.end();
-		}
-		else itr++;
 	}
+
+	operations.swap(valid_ops);
 }
 
 bool OperationList::isObjectOnPool(BaseObject *object)
 {
-	bool found=false;
-	vector<BaseObject *>::iterator itr, itr_end;
-
 	if(!object)
 		throw Exception(ERR_OPR_NOT_ALOC_OBJECT,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-	itr=object_pool.begin();
-	itr_end=object_pool.end();
-	while(!found && itr!=itr_end)
+	return(pool_refs.contains(object));
+}
+
+bool OperationList::evictOldestOperations(void)
+{
+	unsigned count=0, size=operations.size();
+	BaseObject *object=nullptr;
+
+	if(operations.empty())
+		return(false);
+
+	//Counts the operations of the oldest chain (or only the first operation if it is not chained)
+	if(operations[0]->chain_type==Operation::CHAIN_START)
 	{
-		found=*(itr)==object;
-		itr++;
+		while(count < size && operations[count]->chain_type!=Operation::CHAIN_END)
+			count++;
+
+		//The chain is still open (there's no end) so it can't be evicted
+		if(count==size)
+			return(false);
+	}
+
+	count++;
+
+	//The current operation chain can't be evicted otherwise the undo/redo will be broken
+	if(count >= size && isOperationChainStarted())
+		return(false);
+
+	for(unsigned i=0; i < count; i++)
+	{
+		object=object_pool.front();
+		removeFromPool(0);
+		delete(operations.front());
+		operations.pop_front();
+
+		/* The evicted object (a copy or a removed object) is deleted right away when nothing else uses it,
+		otherwise it stays on the not removed objects to be checked when the list is destroyed */
+		if(!isObjectReferenced(object))
+		{
+			not_removed_objs.pop_back();
+			deleteObject(object);
+		}
+	}
+
+	current_index-=static_cast<int>(count);
+	if(current_index < 0) current_index=0;
+
+	return(true);
+}
+
+bool OperationList::isObjectReferenced(BaseObject *object)
+{
+	TableObject *tab_obj=dynamic_cast<TableObject *>(object);
+	BaseTable *tab=nullptr;
+	vector<BaseObject *> *rels=nullptr;
+
+	/* There's no need to check the original objects of the operations since they are either objects
+	of the model or the pool objects of the same operations (removed objects) */
+	if(pool_refs.contains(object))
+		return(true);
+
+	if(tab_obj)
+	{
+		tab=dynamic_cast<BaseTable *>(tab_obj->getParentTable());
+
+		if(tab)
+			return(tab->getObjectIndex(tab_obj) >= 0);
+
+		//Table objects without parent table can be attributes of relationships
+		rels=model->getObjectList(OBJ_RELATIONSHIP);
+		for(auto rel : (*rels))
+		{
+			if(dynamic_cast<Relationship *>(rel)->getObjectIndex(tab_obj) >= 0)
+				return(true);
+		}
+
+		return(false);
+	}
+	else if(model->getObjectIndex(object) >= 0)
+		return(true);
+	else if(object->getObjectType()==OBJ_TABLE)
+	{
+		//The children of a table are deleted with it so the table is kept if one of them is still used
+		vector<BaseObject *> children=dynamic_cast<Table *>(object)->getObjects();
+
+		for(auto child : children)
+		{
+			if(pool_refs.contains(child))
+				return(true);
+		}
+	}
+
+	return(false);
+}
+
+void OperationList::deleteObject(BaseObject *object)
+{
+	vector<BaseObject *> deleted_objs={ object };
+
+	if(object->getObjectType()==OBJ_TABLE)
+	{
+		vector<BaseObject *> children=dynamic_cast<Table *>(object)->getObjects();
+		deleted_objs.insert(deleted_objs.end(), children.begin(), children.end());
 	}
 
-	return(found);
+	//Removes the deleted objects from the not removed list avoiding them to be deleted again by removeOperations()
+	for(auto obj : deleted_objs)
+		not_removed_objs.erase(std::remove(not_removed_objs.begin(), not_removed_objs.end(), obj), not_removed_objs.end());
+
+	delete(object);
 }
 
 void OperationList::removeFromPool(unsigned obj_idx)
 {
 	BaseObject *object=nullptr;
-	vector<BaseObject *>::iterator itr;
+	deque<BaseObject *>::iterator itr;
 
 	//Raises an error if the object index is invalid (out of bound)
 	if(obj_idx >= object_pool.size())
@@ -293,6 +464,9 @@ void OperationList::removeFromPool(unsigned obj_idx)
 	//Removes the object from pool
 	object_pool.erase(itr);
 
+	if(--pool_refs[object]==0)
+		pool_refs.remove(object);
+
 	/* Stores the object that was in the pool on the 'not_removed_objs' vector.
 		The object will be deleted in the destructor of the list. Note: The object is not
 		deleted immediately because the model / table / list of operations may still
@@ -330,30 +504,27 @@ int OperationList::registerObject(BaseObject *object, unsigned op_type, int obje
 						 (obj_type==OBJ_INDEX && parent_obj->getObjectType()!=OBJ_TABLE)))
 			throw Exception(ERR_OPR_OBJ_INV_TYPE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-		//If the operations list is full makes the automatic cleaning before inserting a new operation
-		if(current_index == static_cast<int>(max_size-1))
-			removeOperations();
-
 		/* If adding an operation and the current index is not pointing
 		 to the end of the list (available redo / user ran undo operations)
 		 all elements from the current index to the end of the list will be deleted
 		 as well as the objects in the pool that were linked to the excluded operations */
 		if(current_index>=0 && static_cast<unsigned>(current_index)!=operations.size())
 		{
-			//Gets the last operation index
-			int i=operations.size()-1;
-
-			//Removes all the operation while the current index isn't reached
-			while(i >= current_index)
+			/* Removes all the operations (and their objects on the pool) while the current index isn't reached.
+			Since the operations are removed together with their pool objects there is no need to validate
+			the remaining ones */
+			while(static_cast<int>(operations.size()) > current_index)
 			{
-				removeFromPool(i);
-				i--;
+				removeFromPool(operations.size()-1);
+				delete(operations.back());
+				operations.pop_back();
 			}
-
-			//Validates the remaining operatoins after the deletion
-			validateOperations();
 		}
 
+		/* If the operations list is full the oldest operations are discarded (one chain at time)
+		before inserting a new operation, keeping the rest of the history */
+		while(operations.size() >= max_size && evictOldestOperations());
+
 		//Creates the new operation
 		operation=new Operation;
 		operation->op_type=op_type;
@@ -366,6 +537,10 @@ int OperationList::registerObject(BaseObject *object, unsigned op_type, int obje
 		//Assigns the pool object to the operation
 		operation->pool_obj=object_pool.back();
 
+		//Stores only the current position of the object when it's about to be moved
+		if(isPositionOnlyOperation(object, op_type))
+			operation->position=dynamic_cast<BaseGraphicObject *>(object)->getPosition();
+
 		//Stores the object's permission befor its removal
 		if(op_type==Operation::OBJECT_REMOVED)
 			model->getPermissions(object, operation->permissions);
@@ -444,6 +619,15 @@ int OperationList::registerObject(BaseObject *object, unsigned op_type, int obje
 		operations.push_back(operation);
 		current_index=operations.size();
 
+		/* Notifies the model that the object is about to be changed so the views can update only its items (or the
+		parent's ones). Created and removed objects are notified by the model itself and moving an object doesn't
+		change its items */
+		if(parent_obj)
+			model->notifyObjectModified(parent_obj);
+		else if(op_type==Operation::OBJECT_MODIFIED ||
+						(op_type==Operation::OBJECT_MOVED && !isPositionOnlyOperation(object, op_type)))
+			model->notifyObjectModified(object);
+
     //Returns the last operation position as operation's ID
     return(operations.size()-1);
 	}
@@ -696,10 +880,20 @@ void OperationList::executeOperation(Operation *oper, bool redo)
 				aux_obj=model->createSequence();
 		}
 
+		/* If the operation changed only the object's position the stored position is swapped
+		with the current one so the operation can be redone */
+		if(isPositionOnlyOperation(object, oper->op_type) && object==oper->original_obj)
+		{
+			BaseGraphicObject *graph_obj=dynamic_cast<BaseGraphicObject *>(object);
+			QPointF pos=graph_obj->getPosition();
+
+			graph_obj->setPosition(oper->position);
+			oper->position=pos;
+		}
 		/* If the operation is a modified/moved object, the object copy
 			stored in the pool will be restored */
-		if(oper->op_type==Operation::OBJECT_MODIFIED ||
-			 oper->op_type==Operation::OBJECT_MOVED)
+		else if(oper->op_type==Operation::OBJECT_MODIFIED ||
+						oper->op_type==Operation::OBJECT_MOVED)
 		{
 			if(obj_type==OBJ_RELATIONSHIP)
 			{
@@ -868,6 +1062,13 @@ void OperationList::executeOperation(Operation *oper, bool redo)
           dynamic_cast<Column *>(obj)->getParentTable()->setModified(true);
       }
     }
+
+		//Notifies the restored object (or its parent) so the views can update only its items
+		if(oper->parent_obj)
+			model->notifyObjectModified(oper->parent_obj);
+		else if(oper->op_type==Operation::OBJECT_MODIFIED ||
+						(oper->op_type==Operation::OBJECT_MOVED && !isPositionOnlyOperation(object, oper->op_type)))
+			model->notifyObjectModified(object);
 	}
 }
 
@@ -877,7 +1078,7 @@ void OperationList::removeLastOperation(void)
 	{
 		Operation *oper=nullptr;
 		bool end=false;
-		vector<Operation *>::reverse_iterator itr;
+		deque<Operation *>::reverse_iterator itr;
     int oper_idx=operations.size()-1;
 
 		//Gets the last operation on the list using reverse iterator
@@ -926,7 +1127,7 @@ void OperationList::removeLastOperation(void)
 
 void OperationList::updateObjectIndex(BaseObject *object, unsigned new_idx)
 {
-	vector<Operation *>::iterator itr, itr_end;
+	deque<Operation *>::iterator itr, itr_end;
 	Operation *oper=nullptr;
 
 	if(!object)
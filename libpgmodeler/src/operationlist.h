@@ -28,6 +28,7 @@ undo / redo all the operations made.
 #ifndef OPERATIONLIST_H
 #define OPERATIONLIST_H
 
+#include <deque>
 #include "databasemodel.h"
 #include "pgmodelerns.h"
 #include "operation.h"
@@ -39,8 +40,13 @@ class OperationList: public QObject {
 		//! \brief Inidcates that operation chaining is ignored temporarily
 		bool ignore_chain;
 
-		//! \brief List of objects that were removed / modified on the model
-		vector<BaseObject *> object_pool;
+		/*! \brief List of objects that were removed / modified on the model. Each operation has exactly
+		one object on the pool at the same position of the operation in the operations list */
+		deque<BaseObject *> object_pool;
+
+		/*! \brief Stores how many times each object appears on the pool (the same object can be
+		registered by several operations). Used to check the pool membership in constant time */
+		QHash<BaseObject *, unsigned> pool_refs;
 
 		/*! \brief List of objects that at the time of deletion from pool were still referenced
 		 somehow on the model. The object is stored in this secondary list and
@@ -51,8 +57,9 @@ class OperationList: public QObject {
 		is used in order to avoid double delete on pointers. */
 		map<BaseObject *, bool> unallocated_objs;
 
-		//! \brief Stores the operations executed by the user
-		vector<Operation *> operations;
+		/*! \brief Stores the operations executed by the user. When the list is full the oldest operations
+		are evicted from the front of the list so a deque is used to avoid shifting the whole list */
+		deque<Operation *> operations;
 
 		//! \brief Database model that is linked with this operation list
 		DatabaseModel *model;
@@ -77,6 +84,19 @@ class OperationList: public QObject {
 		//! \brief Checks whether the passed object is in the pool
 		bool isObjectOnPool(BaseObject *object);
 
+		/*! \brief Removes the oldest operation (or the oldest operation chain) from the list in order
+		to give room to new operations. Returns false if nothing could be removed, which happens
+		when the whole list is a single chain still open */
+		bool evictOldestOperations(void);
+
+		/*! \brief Returns if the object is still used by the model (directly or as child of tables and relationships),
+		 or by the pool. Tables are also considered in use when some of their children is on the pool */
+		bool isObjectReferenced(BaseObject *object);
+
+		/*! \brief Deletes an object removed from the pool that is no longer referenced, removing it (and its children
+		 in case of tables) from the not removed objects list */
+		void deleteObject(BaseObject *object);
+
 		//! \brief Adds the object on the pool according to the operation type passed
 		void addToPool(BaseObject *object, unsigned op_type);
 
@@ -92,6 +112,14 @@ class OperationList: public QObject {
 		//! \brief Returns the chain size from the current element
 		unsigned getChainSize(void);
 
+		/*! \brief Returns if the operation over the object changes only its position. This is the case of
+		graphical objects (except relationships) being moved. Instead of a full copy of the object these
+		operations store only the object's position (delta) which is swapped on undo / redo */
+		static bool isPositionOnlyOperation(BaseObject *object, unsigned op_type);
+
+		//! \brief Returns the approximated amount of memory (in bytes) used by the passed object
+		static unsigned getObjectSize(BaseObject *object);
+
 	public:
 		OperationList(DatabaseModel *model);
 		~OperationList(void);
@@ -154,6 +182,10 @@ class OperationList: public QObject {
 		//! \brief Gets the current operation index
 		int getCurrentIndex(void);
 
+		/*! \brief Returns the approximated amount of memory (in bytes) used by the operations history
+		(operations, object copies on the pool and XML definitions of special objects) */
+		unsigned getMemoryUsage(void);
+
 		//! \brief Returns if the list is prepared to execute redo operations
 		bool isRedoAvailable(void);
 
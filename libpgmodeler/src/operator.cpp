@@ -88,12 +88,17 @@ void Operator::setName(const QString &name)
 		if(!isValidName(name))
 			throw Exception(ERR_ASG_INV_NAME_OBJECT,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 		else
+		{
 			this->obj_name=name;
+			updateNameVersion();
+		}
 	}
 }
 
 void Operator::setFunction(Function *func, unsigned func_type)
 {
+	invalidateReferences();
+
 	//Raises an error if the function type is invalid
 	if(func_type > FUNC_RESTRICT)
 		throw Exception(ERR_REF_FUNCTION_INV_TYPE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -155,15 +160,20 @@ void Operator::setFunction(Function *func, unsigned func_type)
 
 void Operator::setArgumentType(PgSQLType arg_type, unsigned arg_id)
 {
+	invalidateReferences();
+
 	//Raises an error if the argument id is invalid
 	if(arg_id > RIGHT_ARG)
 		throw Exception( ERR_REF_OPER_ARG_INV_TYPE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
 	argument_types[arg_id]=arg_type;
+	updateNameVersion();
 }
 
 void Operator::setOperator(Operator *oper, unsigned op_type)
 {
+	invalidateReferences();
+
 	//Raises an error if the operator type is invalid
 	if(op_type > OPER_NEGATOR)
 		throw Exception(ERR_REF_OPER_INV_TYPE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -37,6 +37,8 @@ OperatorClass::~OperatorClass(void)
 
 void OperatorClass::setDataType(PgSQLType data_type)
 {
+	invalidateReferences();
+
 	//A null datatype is not accepted by the operator class
 	if(data_type==PgSQLType::null)
 		throw Exception(ERR_ASG_INV_TYPE_OBJECT,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -47,6 +49,7 @@ void OperatorClass::setDataType(PgSQLType data_type)
 void OperatorClass::setFamily(OperatorFamily *family)
 {
 	this->family=family;
+	invalidateReferences();
 }
 
 void OperatorClass::setIndexingType(IndexingType index_type)
@@ -79,6 +82,8 @@ void OperatorClass::setElementsAttribute(unsigned def_type)
 
 void OperatorClass::addElement(OperatorClassElement elem)
 {
+	invalidateReferences();
+
 	//The operator class does not accept duplicate elements on the list
 	if(isElementExists(elem))
 		throw Exception(ERR_INS_DUPLIC_ELEMENT,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -88,6 +93,8 @@ void OperatorClass::addElement(OperatorClassElement elem)
 
 void OperatorClass::removeElement(unsigned elem_idx)
 {
+	invalidateReferences();
+
 	//Raises an error in case the element index is out of bound
 	if(elem_idx >= elements.size())
 		throw Exception(ERR_REF_ELEM_INV_INDEX,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -99,6 +106,7 @@ void OperatorClass::removeElement(unsigned elem_idx)
 void OperatorClass::removeElements(void)
 {
 	elements.clear();
+	invalidateReferences();
 }
 
 OperatorClassElement OperatorClass::getElement(unsigned elem_idx)
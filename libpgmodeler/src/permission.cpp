@@ -373,6 +373,7 @@ void Permission::generatePermissionId(void)
 	hash.addData(QByteArray(str_aux.toStdString().c_str()));
 	str_aux=hash.result().toHex();
 	this->obj_name=(!revoke ? QString("grant_") : QString("revoke_")) + str_aux.mid(0,10);
+	updateNameVersion();
 }
 
 QString Permission::getCodeDefinition(unsigned def_type)
@@ -17,6 +17,7 @@
 */
 
 #include "pgsqltypes.h"
+#include <algorithm>
 
 /********************
  * CLASS: BaseType  *
@@ -260,31 +261,54 @@ void BaseType::getTypes(QStringList &types,unsigned offset,unsigned count)
 	}
 }
 
-unsigned BaseType::getType(const QString &type_name,unsigned offset,unsigned count)
+QHash<QString, vector<unsigned>> BaseType::createTypeNamesIndex(void)
 {
-	unsigned idx,total;
-	bool found=false;
+	QHash<QString, vector<unsigned>> names_idx;
+	QString aux_name;
+
+	for(unsigned idx=1; idx < types_count; idx++)
+	{
+		aux_name=BaseType::type_list[idx];
+		aux_name.remove("\"");
+		names_idx[aux_name].push_back(idx);
+	}
+
+	return(names_idx);
+}
 
+const QHash<QString, vector<unsigned>> &BaseType::getTypeNamesIndex(void)
+{
+	//The initialization of local static variables is done only once and it's thread safe
+	static const QHash<QString, vector<unsigned>> names_idx=createTypeNamesIndex();
+	return(names_idx);
+}
+
+unsigned BaseType::getType(const QString &type_name,unsigned offset,unsigned count)
+{
 	if(type_name=="")
 		return(BaseType::null);
 	else
 	{
-    QString aux_name, tp_name=type_name;
+		const QHash<QString, vector<unsigned>> &names_idx=getTypeNamesIndex();
+		QHash<QString, vector<unsigned>>::const_iterator itr;
+		unsigned total=offset + count;
 
-    tp_name.remove("\"");
-		total=offset + count;
+		if(type_name.contains('"'))
+			itr=names_idx.constFind(QString(type_name).remove("\""));
+		else
+			itr=names_idx.constFind(type_name);
 
-		for(idx=offset; idx<total && !found; idx++)
-    {
-      aux_name=BaseType::type_list[idx];
-      aux_name.remove("\"");
-      found=(tp_name==aux_name);
-    }
+		if(itr!=names_idx.constEnd())
+		{
+			//Returns the first id of the name that is in the interval of the type class
+			for(unsigned idx : itr.value())
+			{
+				if(idx >= offset && idx < total)
+					return(idx);
+			}
+		}
 
-		if(found)
-		{ idx--; return(idx); }
-		else
-			return(BaseType::null);
+		return(BaseType::null);
 	}
 }
 
@@ -703,6 +727,8 @@ QString SpatialType::operator * (void)
  * CLASS: PgSQLType *
  ********************/
 vector<UserTypeConfig> PgSQLType::user_types;
+QHash<QString, vector<unsigned>> PgSQLType::user_type_names;
+QHash<void *, vector<unsigned>> PgSQLType::user_type_refs;
 
 PgSQLType::PgSQLType(void)
 {
@@ -1097,6 +1123,37 @@ void PgSQLType::addUserType(const QString &type_name, void *ptype, void *pmodel,
 		cfg.pmodel=pmodel;
 		cfg.type_conf=type_conf;
 		PgSQLType::user_types.push_back(cfg);
+
+		user_type_names[type_name].push_back(user_types.size()-1);
+		user_type_refs[ptype].push_back(user_types.size()-1);
+	}
+}
+
+void PgSQLType::insertUserTypeIndex(vector<unsigned> &idx_list, unsigned idx)
+{
+	idx_list.insert(std::lower_bound(idx_list.begin(), idx_list.end(), idx), idx);
+}
+
+void PgSQLType::removeUserTypeIndex(vector<unsigned> &idx_list, unsigned idx)
+{
+	vector<unsigned>::iterator itr=std::lower_bound(idx_list.begin(), idx_list.end(), idx);
+
+	if(itr!=idx_list.end() && (*itr)==idx)
+		idx_list.erase(itr);
+}
+
+void PgSQLType::createUserTypesIndex(void)
+{
+	user_type_names.clear();
+	user_type_refs.clear();
+
+	for(unsigned idx=0; idx < user_types.size(); idx++)
+	{
+		if(!user_types[idx].invalidated)
+		{
+			user_type_names[user_types[idx].name].push_back(idx);
+			user_type_refs[user_types[idx].ptype].push_back(idx);
+		}
 	}
 }
 
@@ -1118,6 +1175,11 @@ void PgSQLType::removeUserType(const QString &type_name, void *ptype)
 
 		if(itr!=itr_end)
 		{
+			unsigned idx=itr - user_types.begin();
+
+			removeUserTypeIndex(user_type_names[itr->name], idx);
+			removeUserTypeIndex(user_type_refs[itr->ptype], idx);
+
 			//PgSQLType::user_types.erase(itr);
 			itr->name="__invalidated_type__";
 			itr->ptype=nullptr;
@@ -1140,6 +1202,10 @@ void PgSQLType::renameUserType(const QString &type_name, void *ptype,const QStri
 		{
 			if(!itr->invalidated && itr->name==type_name && itr->ptype==ptype)
 			{
+				unsigned idx=itr - user_types.begin();
+
+				removeUserTypeIndex(user_type_names[type_name], idx);
+				insertUserTypeIndex(user_type_names[new_name], idx);
 				itr->name=new_name;
 				break;
 			}
@@ -1169,6 +1235,9 @@ void PgSQLType::removeUserTypes(void *pmodel)
 				itr++;
 			}
 		}
+
+		//The positions of the remaining types may have changed so the indexes are recreated
+		createUserTypesIndex();
 	}
 }
 
@@ -1176,9 +1245,16 @@ unsigned PgSQLType::getBaseTypeIndex(const QString &type_name)
 {
 	QString aux_name=type_name;
 
+	int pos=-1;
+
 	aux_name.remove("[]");
   //aux_name.remove("\"");
-	aux_name.remove(QRegExp("( )(with)(out)?(.)*"));
+
+	//Removing the timezone portion of the name (same as the removal of the pattern "( )(with)(out)?(.)*")
+	pos=aux_name.indexOf(" with");
+	if(pos >= 0)
+		aux_name.truncate(pos);
+
 	aux_name=aux_name.trimmed();
 	return(getType(aux_name,offset,types_count));
 }
@@ -1187,25 +1263,48 @@ unsigned PgSQLType::getUserTypeIndex(const QString &type_name, void *ptype, void
 {
 	if(PgSQLType::user_types.size() > 0 && (type_name!="" || ptype))
 	{
-		vector<UserTypeConfig>::iterator itr, itr_end;
-		int idx=0;
+		QHash<QString, vector<unsigned>>::const_iterator name_itr;
+		QHash<void *, vector<unsigned>>::const_iterator ref_itr;
+		unsigned found_idx=user_types.size();
 
-		itr=PgSQLType::user_types.begin();
-		itr_end=PgSQLType::user_types.end();
+		/* Searches the first (lowest position) valid type that matches the name or the reference
+		and belongs to the specified model (when specified) */
+		if(type_name!="")
+		{
+			name_itr=user_type_names.constFind(type_name);
 
-		while(itr!=itr_end)
+			if(name_itr!=user_type_names.constEnd())
+			{
+				for(unsigned idx : name_itr.value())
+				{
+					if(!pmodel || user_types[idx].pmodel==pmodel)
+					{
+						found_idx=idx;
+						break;
+					}
+				}
+			}
+		}
+
+		if(ptype)
 		{
-			if(!itr->invalidated &&
-				 (((type_name!="" && itr->name==type_name) || (ptype && itr->ptype==ptype)) &&
-					((pmodel && itr->pmodel==pmodel) || !pmodel)))
-				break;
+			ref_itr=user_type_refs.constFind(ptype);
 
-			idx++;
-			itr++;
+			if(ref_itr!=user_type_refs.constEnd())
+			{
+				for(unsigned idx : ref_itr.value())
+				{
+					if(idx < found_idx && (!pmodel || user_types[idx].pmodel==pmodel))
+					{
+						found_idx=idx;
+						break;
+					}
+				}
+			}
 		}
 
-		if(itr!=itr_end)
-			return(pseudo_end + 1 + idx);
+		if(found_idx < user_types.size())
+			return(pseudo_end + 1 + found_idx);
 		else
 			return(BaseType::null);
 	}
@@ -31,6 +31,7 @@
 #include <vector>
 #include <map>
 #include <QRegExp>
+#include <QHash>
 
 using namespace std;
 
@@ -38,6 +39,12 @@ class BaseType{
 	private:
     static const unsigned types_count=232;
 
+		/*! \brief Returns the index that maps each type name (without quotes) to its ids on type_list.
+		The same name can appear in more than one type class so a name can have several ids (in ascending order).
+		The index is created only once, on the first call, since type_list never changes */
+		static const QHash<QString, vector<unsigned>> &getTypeNamesIndex(void);
+		static QHash<QString, vector<unsigned>> createTypeNamesIndex(void);
+
 	protected:
 		static QString type_list[types_count];
 
@@ -336,6 +343,18 @@ class PgSQLType: public BaseType{
 		//! \brief Configuration for user defined types
 		static vector<UserTypeConfig> user_types;
 
+		/*! \brief Indexes of the valid (not invalidated) user types by name and by type reference.
+		Each key stores the positions on user_types vector (in ascending order) */
+		static QHash<QString, vector<unsigned>> user_type_names;
+		static QHash<void *, vector<unsigned>> user_type_refs;
+
+		//! \brief Recreates the user types indexes. Used when the user types vector has elements erased
+		static void createUserTypesIndex(void);
+
+		//! \brief Inserts/Removes the user type position on the specified index list keeping it ordered
+		static void insertUserTypeIndex(vector<unsigned> &idx_list, unsigned idx);
+		static void removeUserTypeIndex(vector<unsigned> &idx_list, unsigned idx);
+
 		//! \brief Dimension of the type if it's configured as array
 		unsigned dimension,
 
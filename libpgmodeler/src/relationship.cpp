@@ -468,6 +468,8 @@ void Relationship::addObject(TableObject *tab_obj, int obj_idx)
 	ObjectType obj_type;
 	vector<TableObject *> *obj_list=nullptr;
 
+	invalidateReferences();
+
 	/* Raises an error if the user try to add  manually a special primary key on
 		the relationship and the relationship type is not generalization or copy */
 	if((rel_type==RELATIONSHIP_GEN ||
@@ -574,6 +576,8 @@ void Relationship::removeObject(unsigned obj_id, ObjectType obj_type)
   TableObject *tab_obj=nullptr;
   Table *recv_table=nullptr;
 
+	invalidateReferences();
+
 	if(obj_type==OBJ_COLUMN)
 		obj_list=&rel_attributes;
 	else if(obj_type==OBJ_CONSTRAINT)
@@ -61,6 +61,8 @@ void Role::setOption(unsigned op_type, bool value)
 
 void Role::addRole(unsigned role_type, Role *role)
 {
+	invalidateReferences();
+
 	//Raises an error if the role to be added is not allocated
 	if(!role)
 		throw Exception(ERR_ASG_NOT_ALOC_OBJECT,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -191,6 +193,8 @@ void Role::removeRole(unsigned role_type, unsigned role_idx)
 	vector<Role *> *list=nullptr;
 	vector<Role *>::iterator itr;
 
+	invalidateReferences();
+
 	switch(role_type)
 	{
 		case REF_ROLE: list=&ref_roles; break;
@@ -213,6 +217,8 @@ void Role::removeRoles(unsigned role_type)
 {
 	vector<Role *> *list=nullptr;
 
+	invalidateReferences();
+
 	switch(role_type)
 	{
 		case REF_ROLE: list=&ref_roles; break;
@@ -260,6 +260,8 @@ void Sequence::setValues(QString minv, QString maxv, QString inc, QString start,
 
 void Sequence::setOwnerColumn(Table *table, const QString &col_name)
 {
+	invalidateReferences();
+
 	if(!table || col_name=="")
 		this->owner_col=nullptr;
 	else if(table)
@@ -297,6 +299,8 @@ void Sequence::setOwnerColumn(Column *column)
 {
 	Table *table=nullptr;
 
+	invalidateReferences();
+
 	if(!column)
 		this->owner_col=nullptr;
 	else
@@ -328,6 +328,8 @@ void Table::addObject(BaseObject *obj, int obj_idx)
 {
 	ObjectType obj_type;
 
+	invalidateReferences();
+
 	if(!obj)
 		throw Exception(ERR_ASG_NOT_ALOC_OBJECT,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 	else
@@ -569,6 +571,8 @@ void Table::removeObject(const QString &name, ObjectType obj_type)
 
 void Table::removeObject(unsigned obj_idx, ObjectType obj_type)
 {
+	invalidateReferences();
+
 	//Raises an error if the user try to remove a object with invalid type
 	if(!TableObject::isTableObject(obj_type) && obj_type!=OBJ_TABLE)
 		throw Exception(ERR_REM_OBJ_INVALID_TYPE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
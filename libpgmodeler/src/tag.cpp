@@ -47,6 +47,7 @@ void Tag::setName(const QString &name)
     throw Exception(ERR_ASG_LONG_NAME_OBJECT ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
   this->obj_name=name;
+  updateNameVersion();
 }
 
 QString Tag::getName(bool, bool)
@@ -90,6 +90,8 @@ void Trigger::setEvent(EventType event, bool value)
 
 void Trigger::setFunction(Function *func)
 {
+	invalidateReferences();
+
 	//Case the function is null an error is raised
 	if(!func)
 		throw Exception(Exception::getErrorMessage(ERR_ASG_NOT_ALOC_FUNCTION)
@@ -119,6 +121,8 @@ void Trigger::setCondition(const QString &cond)
 
 void Trigger::addColumn(Column *column)
 {
+	invalidateReferences();
+
 	if(!column)
 		throw Exception(QString(Exception::getErrorMessage(ERR_ASG_NOT_ALOC_COLUMN))
 										.arg(this->getName(true))
@@ -226,10 +230,13 @@ void Trigger::removeArguments(void)
 void Trigger::removeColumns(void)
 {
 	upd_columns.clear();
+	invalidateReferences();
 }
 
 void Trigger::setReferecendTable(BaseTable *ref_table)
 {
+	invalidateReferences();
+
 	//If the referenced table isn't valid raises an error
 	if(ref_table && ref_table->getObjectType()!=OBJ_TABLE)
 		throw Exception(ERR_ASG_OBJECT_INV_TYPE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -198,6 +198,8 @@ void Type::setFunction(unsigned func_id, Function *func)
 	lang=LanguageType::c;
 	unsigned funcs_len=sizeof(functions)/sizeof(Function *);
 
+	invalidateReferences();
+
 	//Raises an error if the function id is invalid
 	if(func_id >= funcs_len)
 		throw Exception(ERR_REF_FUNCTION_INV_TYPE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -351,6 +353,8 @@ void Type::setAlignment(PgSQLType type)
 {
 	QString tp=(*type);
 
+	invalidateReferences();
+
 	//Raises an error if the type assigned to the alignment is invalid according to the rule
 	if(tp!="char" && tp!="smallint" && tp!="integer" && tp!="double precision")
 		throw Exception(Exception::getErrorMessage(ERR_ASG_INV_ALIGNMENT_TYPE).arg(Utf8String::create(this->getName(true))),
@@ -369,6 +373,8 @@ void Type::setDefaultValue(const QString &value)
 
 void Type::setElement(PgSQLType elem)
 {
+	invalidateReferences();
+
 	if(PgSQLType::getUserTypeIndex(this->getName(true), this) == !elem)
 		throw Exception(Exception::getErrorMessage(ERR_USER_TYPE_SELF_REFERENCE).arg(Utf8String::create(this->getName(true))),
 										ERR_USER_TYPE_SELF_REFERENCE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -437,6 +443,8 @@ void Type::setCollatable(bool value)
 
 void Type::setLikeType(PgSQLType like_type)
 {
+	invalidateReferences();
+
 	if(PgSQLType::getUserTypeIndex(this->getName(true), this) == !like_type)
 		throw Exception(Exception::getErrorMessage(ERR_USER_TYPE_SELF_REFERENCE).arg(Utf8String::create(this->getName(true))),
 										ERR_USER_TYPE_SELF_REFERENCE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -446,6 +454,8 @@ void Type::setLikeType(PgSQLType like_type)
 
 void Type::setSubtype(PgSQLType subtype)
 {
+	invalidateReferences();
+
 	if(PgSQLType::getUserTypeIndex(this->getName(true), this) == !subtype)
 		throw Exception(Exception::getErrorMessage(ERR_USER_TYPE_SELF_REFERENCE).arg(Utf8String::create(this->getName(true))),
 										ERR_USER_TYPE_SELF_REFERENCE,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -455,6 +465,8 @@ void Type::setSubtype(PgSQLType subtype)
 
 void Type::setSubtypeOpClass(OperatorClass *opclass)
 {
+	invalidateReferences();
+
 	if(opclass && opclass->getIndexingType()!=IndexingType::btree)
 		throw Exception(Exception::getErrorMessage(ERR_ASG_INV_OPCLASS_OBJ)
 										.arg(Utf8String::create(this->getName(true)))
@@ -214,6 +214,8 @@ void View::addReference(Reference &refer, unsigned sql_type, int expr_id)
 	vector<unsigned> *expr_list=nullptr;
 	Column *col=nullptr;
 
+	invalidateReferences();
+
 	//Specific tests for expressions used as view definition
 	if(sql_type==Reference::SQL_VIEW_DEFINITION)
 	{
@@ -328,6 +330,8 @@ Reference View::getReference(unsigned ref_id, unsigned sql_type)
 
 void View::removeReference(unsigned ref_id)
 {
+	invalidateReferences();
+
 	vector<unsigned> *vect_idref[3]={&exp_select, &exp_from, &exp_where};
 	vector<unsigned>::iterator itr, itr_end;
 	unsigned i;
@@ -361,10 +365,13 @@ void View::removeReferences(void)
 	exp_select.clear();
 	exp_from.clear();
 	exp_where.clear();
+	invalidateReferences();
 }
 
 void View::removeReference(unsigned expr_id, unsigned sql_type)
 {
+	invalidateReferences();
+
 	vector<unsigned> *vect_idref=getExpressionList(sql_type);
 
 	if(expr_id >= vect_idref->size())
@@ -79,7 +79,10 @@ SOURCES += src/mainwindow.cpp \
     src/swapobjectsidswidget.cpp \
     src/temporarymodelthread.cpp \
     src/sqltoolwidget.cpp \
-    src/tagwidget.cpp
+    src/tagwidget.cpp \
+    src/resultsetmodel.cpp \
+    src/sqlexecutionthread.cpp \
+    src/progressthrottle.cpp
 
 HEADERS += src/mainwindow.h \
 	   src/modelwidget.h \
@@ -148,7 +151,10 @@ HEADERS += src/mainwindow.h \
     src/swapobjectsidswidget.h \
     src/temporarymodelthread.h \
     src/sqltoolwidget.h \
-    src/tagwidget.h
+    src/tagwidget.h \
+    src/resultsetmodel.h \
+    src/sqlexecutionthread.h \
+    src/progressthrottle.h
 
 FORMS += ui/mainwindow.ui \
 	 ui/aboutform.ui \
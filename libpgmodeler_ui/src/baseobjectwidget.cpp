@@ -864,6 +864,7 @@ void BaseObjectWidget::finishConfiguration(void)
 				prev_schema->setModified(true);
 		}
 
+		notifyObjectModification();
 		emit s_objectManipulated();
 	}
 }
@@ -912,6 +913,7 @@ void BaseObjectWidget::cancelConfiguration(void)
 		{
 			op_list->undoOperation();
 			op_list->removeLastOperation();
+			notifyObjectModification();
 		}
 		catch(Exception &e)
 		{}
@@ -919,3 +921,18 @@ void BaseObjectWidget::cancelConfiguration(void)
 
 	emit s_objectManipulated();
 }
+
+void BaseObjectWidget::notifyObjectModification(void)
+{
+	if(model && this->object)
+	{
+		ObjectType obj_type=this->object->getObjectType();
+
+		if(this->table && TableObject::isTableObject(obj_type))
+			model->notifyObjectModified(this->table);
+		else if(this->relationship && (obj_type==OBJ_COLUMN || obj_type==OBJ_CONSTRAINT))
+			model->notifyObjectModified(this->relationship);
+		else if(obj_type!=OBJ_PARAMETER)
+			model->notifyObjectModified(this->object);
+	}
+}
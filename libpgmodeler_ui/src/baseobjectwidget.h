@@ -47,6 +47,10 @@ class BaseObjectWidget: public QDialog, public Ui::BaseObjectWidget {
 			to control the exhibition of the alert frame when the object is protected */
 		int pf_min_height, pf_max_height;
 
+		/*! \brief Notifies the model that the edited object was modified. For table objects the parent
+		table (or relationship) is the one notified */
+		void notifyObjectModification(void);
+
 	protected:
     static const int MAX_OBJECT_SIZE=16777215;
 		static const QColor PROT_LINE_BGCOLOR,
@@ -407,7 +407,7 @@ void DatabaseImportForm::handleImportFinished(Exception e)
 	model_wgt->rearrangeSchemas(QPointF(origin_sb->value(), origin_sb->value()),
 															tabs_per_row_sb->value(), sch_per_row_sb->value(), obj_spacing_sb->value());
 
-	finishImport(trUtf8("Importing process sucessfuly ended!"));
+	finishImport(trUtf8("Importing process sucessfuly ended! (catalog queries executed: %1, progress events coalesced: %2)").arg(import_helper.getCatalogQueryCount()).arg(import_helper.getCoalescedEventsCount()));
 	ico_lbl->setPixmap(QPixmap(QString(":/icones/icones/msgbox_info.png")));
 	this->accept();
 }
@@ -17,13 +17,158 @@
 */
 
 #include "databaseimporthelper.h"
+#include <QThreadPool>
 
 const QString DatabaseImportHelper::ARRAY_PATTERN="((\\[)[0-9]+(\\:)[0-9]+(\\])=)?(\\{)((.)+(,)*)*(\\})$";
 
+/* Stores the attributes of the objects, as soon as they are retrieved from the catalog, on a map using their oids
+	 as keys. Objects already stored on the ignored maps are discarded */
+class ObjectsMapHandler: public ObjectAttributesHandler {
+	private:
+		map<unsigned, attribs_map> *objects;
+		vector<map<unsigned, attribs_map> *> ignored_maps;
+		bool *canceled;
+
+	public:
+		ObjectsMapHandler(map<unsigned, attribs_map> &objects, bool *canceled)
+		{
+			this->objects=&objects;
+			this->canceled=canceled;
+		}
+
+		void addIgnoredMap(map<unsigned, attribs_map> &ignored_map)
+		{
+			ignored_maps.push_back(&ignored_map);
+		}
+
+		void handleAttributes(attribs_map &attribs)
+		{
+			unsigned oid;
+
+			if(*canceled)
+				return;
+
+			oid=attribs[ParsersAttributes::OID].toUInt();
+
+			for(auto ignored_map : ignored_maps)
+			{
+				if(ignored_map->count(oid))
+					return;
+			}
+
+			(*objects)[oid].swap(attribs);
+		}
+};
+
+/* Stores the attributes of the columns, as soon as they are retrieved from the catalog, on the map of their
+	 parent tables. Only the selected columns are stored (see DatabaseImportHelper::column_oids) */
+class SelectedColumnsHandler: public ObjectAttributesHandler {
+	private:
+		map<unsigned, map<unsigned, attribs_map>> *columns;
+		const map<unsigned, vector<unsigned>> *column_oids;
+		bool *canceled;
+
+	public:
+		SelectedColumnsHandler(map<unsigned, map<unsigned, attribs_map>> &columns, const map<unsigned, vector<unsigned>> &column_oids, bool *canceled)
+		{
+			this->columns=&columns;
+			this->column_oids=&column_oids;
+			this->canceled=canceled;
+		}
+
+		void handleAttributes(attribs_map &attribs)
+		{
+			map<unsigned, vector<unsigned>>::const_iterator itr;
+			unsigned tab_oid, col_id;
+
+			if(*canceled)
+				return;
+
+			tab_oid=attribs[ParsersAttributes::TABLE].toUInt();
+			col_id=attribs[ParsersAttributes::OID].toUInt();
+			itr=column_oids->find(tab_oid);
+
+			if(itr!=column_oids->end() &&
+				 std::find(itr->second.begin(), itr->second.end(), col_id)!=itr->second.end())
+				(*columns)[tab_oid][col_id].swap(attribs);
+		}
+};
+
+//Stores the parameters and the result of a catalog query executed by a CatalogRetrievalTask
+struct CatalogRetrievalJob {
+	ObjectType obj_type;
+	vector<unsigned> oids;
+	attribs_map extra_attribs;
+	map<unsigned, attribs_map> objects;
+	map<unsigned, map<unsigned, attribs_map>> columns;
+	bool failed;
+	Exception error;
+
+	CatalogRetrievalJob(void) : obj_type(BASE_OBJECT), failed(false) {}
+};
+
+/* Executes on a pool thread a set of catalog queries using a dedicated catalog connection.
+	 The catalog must be already attached to the snapshot shared by all pooled connections */
+class CatalogRetrievalTask: public QRunnable {
+	private:
+		Catalog *catalog;
+		vector<CatalogRetrievalJob *> jobs;
+		const map<unsigned, vector<unsigned>> *column_oids;
+		bool *canceled;
+		QAtomicInt *done_jobs;
+
+	public:
+		CatalogRetrievalTask(Catalog *catalog, const map<unsigned, vector<unsigned>> *column_oids, bool *canceled, QAtomicInt *done_jobs)
+		{
+			this->catalog=catalog;
+			this->column_oids=column_oids;
+			this->canceled=canceled;
+			this->done_jobs=done_jobs;
+		}
+
+		void addJob(CatalogRetrievalJob *job)
+		{
+			jobs.push_back(job);
+		}
+
+		void run(void)
+		{
+			vector<CatalogRetrievalJob *>::iterator itr=jobs.begin();
+
+			while(itr!=jobs.end() && !(*canceled))
+			{
+				try
+				{
+					//The columns map is only read here so it can be shared by all tasks
+					if((*itr)->obj_type==OBJ_COLUMN)
+					{
+						SelectedColumnsHandler handler((*itr)->columns, *column_oids, canceled);
+						catalog->getObjectsAttributes((*itr)->obj_type, handler, "", "", (*itr)->oids, (*itr)->extra_attribs);
+					}
+					else
+					{
+						ObjectsMapHandler handler((*itr)->objects, canceled);
+						catalog->getObjectsAttributes((*itr)->obj_type, handler, "", "", (*itr)->oids, (*itr)->extra_attribs);
+					}
+				}
+				catch(Exception &e)
+				{
+					(*itr)->error=e;
+					(*itr)->failed=true;
+				}
+
+				done_jobs->ref();
+				itr++;
+			}
+		}
+};
+
 DatabaseImportHelper::DatabaseImportHelper(QObject *parent) : QObject(parent)
 {
 	import_canceled=ignore_errors=import_sys_objs=import_ext_objs=false;
-	auto_resolve_deps=true;
+	auto_resolve_deps=bulk_retrieval=true;
+	catalog_pool_size=DEF_CATALOG_POOL_SIZE;
+	pool_query_count=0;
 	import_filter=Catalog::LIST_ALL_OBJS | Catalog::EXCL_EXTENSION_OBJS | Catalog::EXCL_SYSTEM_OBJS;
 	model_wgt=nullptr;
 }
@@ -101,6 +246,26 @@ void DatabaseImportHelper::setImportOptions(bool import_sys_objs, bool import_ex
 		import_filter=Catalog::LIST_ALL_OBJS | Catalog::EXCL_BUILTIN_ARRAY_TYPES | Catalog::EXCL_EXTENSION_OBJS | Catalog::EXCL_SYSTEM_OBJS;
 }
 
+void DatabaseImportHelper::setBulkRetrieval(bool value)
+{
+	bulk_retrieval=value;
+}
+
+void DatabaseImportHelper::setCatalogPoolSize(unsigned size)
+{
+	catalog_pool_size=(size > 0 ? size : 1);
+}
+
+unsigned DatabaseImportHelper::getCatalogQueryCount(void)
+{
+	return(catalog.getQueryCount() + pool_query_count);
+}
+
+unsigned DatabaseImportHelper::getCoalescedEventsCount(void)
+{
+	return(progress_throttle.getCoalescedCount());
+}
+
 unsigned DatabaseImportHelper::getLastSystemOID(void)
 {
 	return(catalog.getLastSysObjectOID());
@@ -140,18 +305,17 @@ void DatabaseImportHelper::swapSequencesTablesIds(void)
 void DatabaseImportHelper::retrieveSystemObjects(void)
 {
 	int progress=0;
-	vector<attribs_map>::iterator itr;
 	map<unsigned, attribs_map> *obj_map=nullptr;
-	vector<attribs_map> objects;
 	ObjectType sys_objs[]={ OBJ_SCHEMA, OBJ_ROLE, OBJ_TABLESPACE,
 													OBJ_LANGUAGE, /* OBJ_COLLATION,*/ OBJ_TYPE };
-	unsigned i=0, oid=0, cnt=sizeof(sys_objs)/sizeof(ObjectType);
+	unsigned i=0, cnt=sizeof(sys_objs)/sizeof(ObjectType);
 
 	for(i=0; i < cnt && !import_canceled; i++)
 	{
-		emit s_progressUpdated(progress,
-													 trUtf8("Retrieving system objects... `%1'").arg(BaseObject::getTypeName(sys_objs[i])),
-													 sys_objs[i]);
+		if(progress_throttle.isEmitAllowed())
+			emit s_progressUpdated(progress,
+														 trUtf8("Retrieving system objects... `%1'").arg(BaseObject::getTypeName(sys_objs[i])),
+														 sys_objs[i]);
 
 		if(sys_objs[i]!=OBJ_TYPE)
 		{
@@ -168,19 +332,11 @@ void DatabaseImportHelper::retrieveSystemObjects(void)
 			catalog.setFilter(Catalog::LIST_ALL_OBJS);
 		}
 
-		//Query the objects on the catalog and put them on the map
-		objects=catalog.getObjectsAttributes(sys_objs[i]);
-		itr=objects.begin();
-
-		while(itr!=objects.end() && !import_canceled)
-		{
-			oid=itr->at(ParsersAttributes::OID).toUInt();
-			(*obj_map)[oid]=(*itr);
-			itr++;
-		}
+		//Query the objects on the catalog and put them on the map as they arrive
+		ObjectsMapHandler handler(*obj_map, &import_canceled);
+		catalog.getObjectsAttributes(sys_objs[i], handler);
 
 		progress=(i/static_cast<float>(cnt))*10;
-		sleepThread(5);
 	}
 }
 
@@ -188,36 +344,34 @@ void DatabaseImportHelper::retrieveUserObjects(void)
 {
 	int progress=0;
 	map<ObjectType, vector<unsigned>>::iterator oid_itr=object_oids.begin();
-	vector<attribs_map>::iterator itr;
-	vector<attribs_map> objects;
-	unsigned i=0, oid=0;
+	ObjectsMapHandler user_objs_handler(user_objs, &import_canceled);
+	unsigned i=0;
 	map<unsigned, vector<unsigned>>::iterator col_itr;
 	QStringList names;
 
 	i=0;
 	catalog.setFilter(import_filter);
 
+	if(retrieveUserObjectsInParallel())
+		return;
+
 	//Retrieving selected database level objects and table children objects (except columns)
 	while(oid_itr!=object_oids.end() && !import_canceled)
 	{
-		emit s_progressUpdated(progress,
-													 trUtf8("Retrieving objects... `%1'").arg(BaseObject::getTypeName(oid_itr->first)),
-													 oid_itr->first);
-
-		objects=catalog.getObjectsAttributes(oid_itr->first, "", "", oid_itr->second);
-		itr=objects.begin();
-
-		while(itr!=objects.end() && !import_canceled)
-		{
-			oid=itr->at(ParsersAttributes::OID).toUInt();
-			user_objs[oid]=(*itr);
-			itr++;
-		}
+		if(progress_throttle.isEmitAllowed())
+			emit s_progressUpdated(progress,
+														 trUtf8("Retrieving objects... `%1'").arg(BaseObject::getTypeName(oid_itr->first)),
+														 oid_itr->first);
 
-		objects.clear();
+		catalog.getObjectsAttributes(oid_itr->first, user_objs_handler, "", "", oid_itr->second);
 		progress=(i/static_cast<float>(object_oids.size()))*100;
 		oid_itr++; i++;
-		sleepThread(5);
+	}
+
+	if(bulk_retrieval)
+	{
+		retrieveColumnsInBulk();
+		return;
 	}
 
 	//Retrieving all selected table columns
@@ -225,25 +379,212 @@ void DatabaseImportHelper::retrieveUserObjects(void)
 	col_itr=column_oids.begin();
 	while(col_itr!=column_oids.end())
 	{
-		emit s_progressUpdated(progress,
-													 trUtf8("Retrieving objects... `%1'").arg(BaseObject::getTypeName(OBJ_COLUMN)),
-													 OBJ_COLUMN);
+		if(progress_throttle.isEmitAllowed())
+			emit s_progressUpdated(progress,
+														 trUtf8("Retrieving objects... `%1'").arg(BaseObject::getTypeName(OBJ_COLUMN)),
+														 OBJ_COLUMN);
 
 		names=getObjectName(QString::number(col_itr->first)).split(".");
-		objects=catalog.getObjectsAttributes(OBJ_COLUMN, names[0], names[1], col_itr->second);
-		itr=objects.begin();
 
-		while(itr!=objects.end() && !import_canceled)
+		ObjectsMapHandler handler(columns[col_itr->first], &import_canceled);
+		catalog.getObjectsAttributes(OBJ_COLUMN, handler, names[0], names[1], col_itr->second);
+		progress=(i/static_cast<float>(column_oids.size()))*100;
+		col_itr++; i++;
+	}
+}
+
+void DatabaseImportHelper::retrieveColumnsInBulk(void)
+{
+	map<unsigned, vector<unsigned>>::iterator col_itr;
+	SelectedColumnsHandler handler(columns, column_oids, &import_canceled);
+	QStringList tab_oids;
+
+	if(column_oids.empty() || import_canceled)
+		return;
+
+	emit s_progressUpdated(100,
+												 trUtf8("Retrieving objects... `%1'").arg(BaseObject::getTypeName(OBJ_COLUMN)),
+												 OBJ_COLUMN);
+
+	for(col_itr=column_oids.begin(); col_itr!=column_oids.end(); col_itr++)
+		tab_oids.push_back(QString::number(col_itr->first));
+
+	//Retrieving the columns of all the selected tables at once (only the selected ones are stored)
+	catalog.getObjectsAttributes(OBJ_COLUMN, handler, "", "", {},
+															 {{ParsersAttributes::FILTER_TAB_OIDS, tab_oids.join(",")}});
+}
+
+bool DatabaseImportHelper::retrieveUserObjectsInParallel(void)
+{
+	vector<CatalogRetrievalJob> jobs;
+	vector<CatalogRetrievalTask *> tasks;
+	map<ObjectType, vector<unsigned>>::iterator oid_itr;
+	map<unsigned, vector<unsigned>>::iterator col_itr;
+	CatalogRetrievalJob job;
+	QStringList tab_oids;
+	QString snapshot_id;
+	QAtomicInt done_jobs(0);
+	unsigned i=0, conn_count=0;
+	//The pool is declared after the jobs so it is destroyed (waiting the running tasks) before them
+	QThreadPool pool;
+
+	//Creating one query job for each object type
+	for(oid_itr=object_oids.begin(); oid_itr!=object_oids.end(); oid_itr++)
+	{
+		job.obj_type=oid_itr->first;
+		job.oids=oid_itr->second;
+		jobs.push_back(job);
+	}
+
+	/* The columns are filtered by the parent tables oids so the jobs don't depend on the tables names.
+		 In bulk retrieval mode all columns are retrieved by a single job */
+	job.obj_type=OBJ_COLUMN;
+	job.oids.clear();
+	for(col_itr=column_oids.begin(); col_itr!=column_oids.end(); col_itr++)
+	{
+		if(bulk_retrieval)
+			tab_oids.push_back(QString::number(col_itr->first));
+		else
+		{
+			job.oids=col_itr->second;
+			job.extra_attribs[ParsersAttributes::FILTER_TAB_OIDS]=QString::number(col_itr->first);
+			jobs.push_back(job);
+		}
+	}
+
+	if(!tab_oids.isEmpty())
+	{
+		job.extra_attribs[ParsersAttributes::FILTER_TAB_OIDS]=tab_oids.join(",");
+		jobs.push_back(job);
+	}
+
+	//There is no gain in using the connection pool for a single query
+	conn_count=std::min<unsigned>(catalog_pool_size, jobs.size());
+	if(conn_count < 2)
+		return(false);
+
+	try
+	{
+		snapshot_id=catalog.exportSnapshot();
+	}
+	catch(Exception &)
+	{
+		return(false);
+	}
+
+	pool_mutex.lock();
+
+	try
+	{
+		//Opening the pooled connections and attaching them to the exported snapshot
+		for(i=0; i < conn_count; i++)
 		{
-			oid=itr->at(ParsersAttributes::OID).toUInt();
-			columns[col_itr->first][oid]=(*itr);
-			itr++;
+			pool_catalogs.push_back(new Catalog);
+			(*pool_catalogs.back())=catalog;
+			pool_catalogs.back()->setFilter(import_filter);
+			pool_catalogs.back()->importSnapshot(snapshot_id);
+			tasks.push_back(new CatalogRetrievalTask(pool_catalogs.back(), &column_oids, &import_canceled, &done_jobs));
 		}
+	}
+	catch(Exception &)
+	{
+		//If any of the connections can't be configured the objects are retrieved sequentially
+		for(auto task : tasks)
+			delete(task);
 
-		objects.clear();
-		progress=(i/static_cast<float>(column_oids.size()))*100;
-		col_itr++; i++;
-		sleepThread(5);
+		for(auto cat : pool_catalogs)
+			delete(cat);
+
+		pool_catalogs.clear();
+		pool_mutex.unlock();
+
+		catalog.endTransaction();
+		return(false);
+	}
+
+	pool_mutex.unlock();
+
+	//Distributing the jobs between the connections
+	for(i=0; i < jobs.size(); i++)
+		tasks[i % conn_count]->addJob(&jobs[i]);
+
+	pool.setMaxThreadCount(conn_count);
+	for(auto task : tasks)
+		pool.start(task);
+
+	while(!pool.waitForDone(50))
+	{
+		emit s_progressUpdated((done_jobs.load()/static_cast<float>(jobs.size())) * 100,
+													 trUtf8("Retrieving objects... (`%1' connections)").arg(conn_count),
+													 BASE_OBJECT);
+	}
+
+	//Closing the pooled connections and the transaction that exported the snapshot
+	pool_mutex.lock();
+
+	for(auto cat : pool_catalogs)
+	{
+		pool_query_count+=cat->getQueryCount();
+		delete(cat);
+	}
+
+	pool_catalogs.clear();
+	pool_mutex.unlock();
+
+	catalog.endTransaction();
+
+	//Storing the retrieved objects in the same order they would be retrieved sequentially
+	for(auto &ret_job : jobs)
+	{
+		if(ret_job.failed)
+			throw Exception(ret_job.error.getErrorMessage(), ret_job.error.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &ret_job.error);
+
+		for(auto &obj : ret_job.objects)
+			user_objs[obj.first].swap(obj.second);
+
+		for(auto &tab_cols : ret_job.columns)
+		{
+			for(auto &col : tab_cols.second)
+				columns[tab_cols.first][col.first].swap(col.second);
+		}
+	}
+
+	return(true);
+}
+
+void DatabaseImportHelper::retrieveDependencyObjects(void)
+{
+	int progress=0;
+	ObjectsMapHandler handler(prefetched_objs, &import_canceled);
+	ObjectType dep_types[]={ OBJ_SCHEMA, OBJ_ROLE, OBJ_TABLESPACE, OBJ_LANGUAGE,
+													 OBJ_COLLATION, OBJ_FUNCTION, OBJ_OPERATOR, OBJ_OPCLASS };
+	unsigned i=0, cnt=sizeof(dep_types)/sizeof(ObjectType);
+
+	prefetched_objs.clear();
+	prefetched_types.clear();
+
+	if(!bulk_retrieval || !auto_resolve_deps)
+		return;
+
+	//Objects already retrieved are not stored again
+	handler.addIgnoredMap(user_objs);
+	handler.addIgnoredMap(system_objs);
+
+	/* The import filter retrieves a superset of the objects that getDependencyObject()
+		 is able to resolve by querying the catalog for each oid */
+	catalog.setFilter(import_filter);
+
+	for(i=0; i < cnt && !import_canceled; i++)
+	{
+		if(progress_throttle.isEmitAllowed())
+			emit s_progressUpdated(progress,
+														 trUtf8("Retrieving dependencies... `%1'").arg(BaseObject::getTypeName(dep_types[i])),
+														 dep_types[i]);
+
+		catalog.getObjectsAttributes(dep_types[i], handler);
+
+		prefetched_types.push_back(dep_types[i]);
+		progress=(i/static_cast<float>(cnt))*100;
 	}
 }
 
@@ -266,11 +607,12 @@ void DatabaseImportHelper::createObjects(void)
 				 in order to be created later */
 			if(obj_type!=OBJ_CONSTRAINT)
 			{
-				emit s_progressUpdated(progress,
-															 trUtf8("Creating object `%1' `(%2)'...")
-															 .arg(attribs[ParsersAttributes::NAME])
-															 .arg(BaseObject::getTypeName(obj_type)),
-															 obj_type);
+				if(progress_throttle.isEmitAllowed())
+					emit s_progressUpdated(progress,
+																 trUtf8("Creating object `%1' `(%2)'...")
+																 .arg(attribs[ParsersAttributes::NAME])
+																 .arg(BaseObject::getTypeName(obj_type)),
+																 obj_type);
 
 				createObject(attribs);
 			}
@@ -286,7 +628,6 @@ void DatabaseImportHelper::createObjects(void)
 		}
 
 		progress=(i/static_cast<float>(creation_order.size())) * 100;
-		sleepThread(5);
 	}
 
 	//Creating table inheiritances
@@ -322,11 +663,12 @@ void DatabaseImportHelper::createConstraints(void)
 
 		try
 		{
-			emit s_progressUpdated(progress,
-														 trUtf8("Creating object `%1' `(%2)'...")
-														 .arg(attribs[ParsersAttributes::NAME])
-														 .arg(BaseObject::getTypeName(OBJ_CONSTRAINT)),
-														 OBJ_CONSTRAINT);
+			if(progress_throttle.isEmitAllowed())
+				emit s_progressUpdated(progress,
+															 trUtf8("Creating object `%1' `(%2)'...")
+															 .arg(attribs[ParsersAttributes::NAME])
+															 .arg(BaseObject::getTypeName(OBJ_CONSTRAINT)),
+															 OBJ_CONSTRAINT);
 
 			createObject(attribs);
 		}
@@ -339,7 +681,6 @@ void DatabaseImportHelper::createConstraints(void)
 		}
 
 		progress=(i/static_cast<float>(constr_creation_order.size())) * 100;
-		sleepThread(10);
 	}
 }
 
@@ -354,20 +695,21 @@ void DatabaseImportHelper::createPermissions(void)
 		//Create the object level permission
 		while(itr_obj!=obj_perms.end() && !import_canceled)
 		{
-			emit s_progressUpdated(progress, trUtf8("Creating objects permissions..."), OBJ_PERMISSION);
+			if(progress_throttle.isEmitAllowed())
+				emit s_progressUpdated(progress, trUtf8("Creating objects permissions..."), OBJ_PERMISSION);
 
 			createPermission(user_objs[*itr_obj]);
 			itr_obj++;
 
 			progress=((i++)/static_cast<float>(obj_perms.size())) * 100;
-			sleepThread(10);
 		}
 
 		//Create the column level permission
 		i=0;
 		while(itr_cols!=col_perms.end() && !import_canceled)
 		{
-			emit s_progressUpdated(progress, trUtf8("Creating columns permissions..."), OBJ_PERMISSION);
+			if(progress_throttle.isEmitAllowed())
+				emit s_progressUpdated(progress, trUtf8("Creating columns permissions..."), OBJ_PERMISSION);
 
 			itr=col_perms[itr_cols->first].begin();
 
@@ -379,7 +721,6 @@ void DatabaseImportHelper::createPermissions(void)
 
 			itr_cols++;
 			progress=((i++)/static_cast<float>(col_perms.size())) * 100;
-			sleepThread(10);
 		}
 
 	}
@@ -410,17 +751,17 @@ void DatabaseImportHelper::updateFKRelationships(void)
 		{
 			tab=dynamic_cast<Table *>(*itr_tab);
 
-			emit s_progressUpdated(progress,
-														 trUtf8("Update relationships of `%1' `(%2)'...")
-														 .arg(tab->getName())
-														 .arg(BaseObject::getTypeName(OBJ_TABLE)),
-														 OBJ_TABLE);
+			if(progress_throttle.isEmitAllowed())
+				emit s_progressUpdated(progress,
+															 trUtf8("Update relationships of `%1' `(%2)'...")
+															 .arg(tab->getName())
+															 .arg(BaseObject::getTypeName(OBJ_TABLE)),
+															 OBJ_TABLE);
 
 			dbmodel->updateTableFKRelationships(tab);
 
 			progress=(i/static_cast<float>(count)) * 100;
 			itr_tab++; i++;
-			sleepThread(10);
 		}
 	}
 	catch(Exception &e)
@@ -439,13 +780,24 @@ void DatabaseImportHelper::importDatabase(void)
 {
 	try
 	{
+		catalog.resetQueryCount();
+		progress_throttle.reset();
+		pool_query_count=0;
 		retrieveSystemObjects();
 		retrieveUserObjects();
+		retrieveDependencyObjects();
 		createObjects();
 		createConstraints();
 		createPermissions();
 		updateFKRelationships();
 
+		if(debug_mode)
+		{
+			QTextStream ts(stdout);
+			ts << "-- Catalog queries executed: " << catalog.getQueryCount() << endl;
+			ts << "-- Progress events coalesced: " << progress_throttle.getCoalescedCount() << endl;
+		}
+
 		if(!import_canceled)
 		{
 			swapSequencesTablesIds();
@@ -484,11 +836,16 @@ void DatabaseImportHelper::importDatabase(void)
 	}
 	catch(Exception &e)
 	{
+		bool canceled=import_canceled;
+
 		resetImportParameters();
 
+		//A catalog query interrupted by the cancel request raises an error that is handled as the import cancellation
+		if(canceled)
+			emit s_importCanceled();
 		/* When running in a separated thread (other than the main application thread)
 		redirects the error in form of signal */
-		if(this->thread() && this->thread()!=qApp->thread())
+		else if(this->thread() && this->thread()!=qApp->thread())
 			emit s_importAborted(Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, e.getExtraInfo()));
 		else
 			//Redirects any error to the user
@@ -499,6 +856,14 @@ void DatabaseImportHelper::importDatabase(void)
 void DatabaseImportHelper::cancelImport(void)
 {
 	import_canceled=true;
+
+	//Interrupting the running catalog queries instead of waiting them to finish
+	catalog.cancelQuery();
+
+	pool_mutex.lock();
+	for(auto cat : pool_catalogs)
+		cat->cancelQuery();
+	pool_mutex.unlock();
 }
 
 void DatabaseImportHelper::createObject(attribs_map &attribs)
@@ -506,6 +871,7 @@ void DatabaseImportHelper::createObject(attribs_map &attribs)
 	unsigned oid=attribs[ParsersAttributes::OID].toUInt();
 	ObjectType obj_type=static_cast<ObjectType>(attribs[ParsersAttributes::OBJECT_TYPE].toUInt());
 	QString obj_name=getObjectName(attribs[ParsersAttributes::OID], (obj_type==OBJ_FUNCTION || obj_type==OBJ_OPERATOR));
+	bool build_obj=isDirectlyBuilt(obj_type, attribs);
 
 	try
 	{	
@@ -521,16 +887,19 @@ void DatabaseImportHelper::createObject(attribs_map &attribs)
 
 			//System objects will have the sql disabled by default
 			attribs[ParsersAttributes::SQL_DISABLED]=(oid > catalog.getLastSysObjectOID() ? "" : "1");
-			attribs[ParsersAttributes::COMMENT]=getComment(attribs);
+
+			//Directly built objects use the plain comment and the names of the referenced objects
+			if(!build_obj)
+				attribs[ParsersAttributes::COMMENT]=getComment(attribs);
 
 			if(attribs.count(ParsersAttributes::OWNER))
-				attribs[ParsersAttributes::OWNER]=getDependencyObject(attribs[ParsersAttributes::OWNER], OBJ_ROLE);
+				attribs[ParsersAttributes::OWNER]=getDependencyObject(attribs[ParsersAttributes::OWNER], OBJ_ROLE, false, true, !build_obj);
 
 			if(attribs.count(ParsersAttributes::TABLESPACE))
-				attribs[ParsersAttributes::TABLESPACE]=getDependencyObject(attribs[ParsersAttributes::TABLESPACE], OBJ_TABLESPACE);
+				attribs[ParsersAttributes::TABLESPACE]=getDependencyObject(attribs[ParsersAttributes::TABLESPACE], OBJ_TABLESPACE, false, true, !build_obj);
 
 			if(attribs.count(ParsersAttributes::SCHEMA))
-				attribs[ParsersAttributes::SCHEMA]=getDependencyObject(attribs[ParsersAttributes::SCHEMA], OBJ_SCHEMA);
+				attribs[ParsersAttributes::SCHEMA]=getDependencyObject(attribs[ParsersAttributes::SCHEMA], OBJ_SCHEMA, false, true, !build_obj);
 
 			if(!attribs[ParsersAttributes::PERMISSION].isEmpty())
 				obj_perms.push_back(oid);
@@ -621,8 +990,22 @@ QString DatabaseImportHelper::getDependencyObject(const QString &oid, ObjectType
 						obj_oid > catalog.getLastSysObjectOID() && !catalog.isExtensionObject(obj_oid)) ||
 					(import_sys_objs  && obj_oid <= catalog.getLastSysObjectOID())))
 			{
-				catalog.setFilter(Catalog::LIST_ALL_OBJS);
-				vector<attribs_map> attribs_vect=catalog.getObjectsAttributes(obj_type,"","", { obj_oid });
+				vector<attribs_map> attribs_vect;
+
+				//In bulk retrieval mode the attributes are taken from the prefetched objects instead of querying the catalog
+				if(std::find(prefetched_types.begin(), prefetched_types.end(), obj_type)!=prefetched_types.end())
+				{
+					if(prefetched_objs.count(obj_oid))
+					{
+						attribs_vect.push_back(prefetched_objs[obj_oid]);
+						prefetched_objs.erase(obj_oid);
+					}
+				}
+				else
+				{
+					catalog.setFilter(Catalog::LIST_ALL_OBJS);
+					attribs_vect=catalog.getObjectsAttributes(obj_type,"","", { obj_oid });
+				}
 
 				if(!attribs_vect.empty())
 				{
@@ -706,6 +1089,69 @@ void DatabaseImportHelper::loadObjectXML(ObjectType obj_type, attribs_map &attri
 	}
 }
 
+bool DatabaseImportHelper::isDirectlyBuilt(ObjectType obj_type, attribs_map &attribs)
+{
+	return(obj_type==OBJ_SCHEMA || obj_type==OBJ_TABLE ||
+				 obj_type==OBJ_FUNCTION || obj_type==OBJ_VIEW ||
+				 (obj_type==OBJ_TYPE &&
+					(attribs[ParsersAttributes::CONFIGURATION]==ParsersAttributes::ENUM_TYPE ||
+					 attribs[ParsersAttributes::CONFIGURATION]==ParsersAttributes::COMPOSITE_TYPE)));
+}
+
+void DatabaseImportHelper::setBasicAttributes(BaseObject *object, attribs_map &attribs)
+{
+	try
+	{
+		object->setName(attribs[ParsersAttributes::NAME]);
+		object->setComment(attribs[ParsersAttributes::COMMENT]);
+		object->setSQLDisabled(!attribs[ParsersAttributes::SQL_DISABLED].isEmpty());
+
+		/* The referenced objects are searched by the names returned by getDependencyObject(). Like in the
+		xml based creation (see DatabaseModel::setBasicAttributes) a schema, owner or tablespace name that
+		does not match an object in the model raises an error */
+		QString attr_names[]={ ParsersAttributes::SCHEMA, ParsersAttributes::OWNER, ParsersAttributes::TABLESPACE };
+		ObjectType ref_types[]={ OBJ_SCHEMA, OBJ_ROLE, OBJ_TABLESPACE };
+		bool accepts[]={ object->acceptsSchema(), object->acceptsOwner(), object->acceptsTablespace() };
+		BaseObject *ref_obj=nullptr;
+
+		for(unsigned i=0; i < 3; i++)
+		{
+			if(!attribs.count(attr_names[i]) || !accepts[i])
+				continue;
+
+			ref_obj=dbmodel->getObject(attribs[attr_names[i]], ref_types[i]);
+
+			if(!ref_obj && !attribs[attr_names[i]].isEmpty())
+				throw Exception(Exception::getErrorMessage(ERR_REF_OBJ_INEXISTS_MODEL)
+												.arg(Utf8String::create(object->getName()))
+												.arg(object->getTypeName())
+												.arg(Utf8String::create(attribs[attr_names[i]]))
+												.arg(BaseObject::getTypeName(ref_types[i])),
+												ERR_REF_OBJ_INEXISTS_MODEL,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+			if(ref_types[i]==OBJ_SCHEMA)
+				object->setSchema(ref_obj);
+			else if(ref_types[i]==OBJ_ROLE)
+				object->setOwner(ref_obj);
+			else
+				object->setTablespace(ref_obj);
+		}
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void DatabaseImportHelper::dumpObjectXML(BaseObject *object)
+{
+	if(debug_mode)
+	{
+		QTextStream ts(stdout);
+		ts << object->getCodeDefinition(SchemaParser::XML_DEFINITION) << endl;
+	}
+}
+
 void DatabaseImportHelper::resetImportParameters(void)
 {
 	Connection::setPrintSQL(false);
@@ -720,6 +1166,8 @@ void DatabaseImportHelper::resetImportParameters(void)
 	seq_tab_swap.clear();
 	columns.clear();
 	system_objs.clear();
+	prefetched_objs.clear();
+	prefetched_types.clear();
 	created_objs.clear();
 	errors.clear();
 	constr_creation_order.clear();
@@ -751,18 +1199,18 @@ void DatabaseImportHelper::createSchema(attribs_map &attribs)
 
 	try
 	{
-		attribs[ParsersAttributes::RECT_VISIBLE]="";
-		attribs[ParsersAttributes::FILL_COLOR]=QColor(rand() % 255, rand() % 255, rand() % 255).name();
-		loadObjectXML(OBJ_SCHEMA, attribs);
+		schema=new Schema;
+		setBasicAttributes(schema, attribs);
+		schema->setRectVisible(false);
+		schema->setFillColor(QColor(rand() % 255, rand() % 255, rand() % 255));
 
-		schema=dbmodel->createSchema();
+		dumpObjectXML(schema);
 		dbmodel->addObject(schema);
 	}
 	catch(Exception &e)
 	{
 		if(schema) delete(schema);
-		throw Exception(e.getErrorMessage(), e.getErrorType(),
-										__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, XMLParser::getXMLBuffer());
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 	}
 }
 
@@ -888,14 +1336,19 @@ QStringList DatabaseImportHelper::parseDefaultValues(const QString &def_vals, co
 void DatabaseImportHelper::createFunction(attribs_map &attribs)
 {
 	Function *func=nullptr;
+	BaseObject *lang=nullptr;
 	Parameter param;
 	PgSQLType type;
 	unsigned dim=0;
+	QString lang_name, type_name;
 	QStringList param_types, param_names, param_modes, param_def_vals;
 	int def_val_idx=0;
 
 	try
 	{
+		func=new Function;
+		setBasicAttributes(func, attribs);
+
 		param_types=getTypes(attribs[ParsersAttributes::ARG_TYPES], false);
 		param_names=parseArrayValues(attribs[ParsersAttributes::ARG_NAMES]);
 		param_modes=parseArrayValues(attribs[ParsersAttributes::ARG_MODES]);
@@ -946,43 +1399,77 @@ void DatabaseImportHelper::createFunction(attribs_map &attribs)
 
 			//If the mode is 't' indicates that the current parameter will be used as a return table colum
 			if(!param_modes.isEmpty() && param_modes[i]=="t")
-				attribs[ParsersAttributes::RETURN_TABLE]+=param.getCodeDefinition(SchemaParser::XML_DEFINITION);
+				func->addReturnedTableColumn(param.getName(), param.getType());
 			else
-				attribs[ParsersAttributes::PARAMETERS]+=param.getCodeDefinition(SchemaParser::XML_DEFINITION);
+				func->addParameter(param);
 		}
 
+		//Get the language reference
+		lang_name=getDependencyObject(attribs[ParsersAttributes::LANGUAGE], OBJ_LANGUAGE, false, true, false);
+		lang=dbmodel->getObject(lang_name, OBJ_LANGUAGE);
+
+		if(!lang)
+			throw Exception(Exception::getErrorMessage(ERR_REF_OBJ_INEXISTS_MODEL)
+											.arg(Utf8String::create(func->getName()))
+											.arg(func->getTypeName())
+											.arg(Utf8String::create(lang_name))
+											.arg(BaseObject::getTypeName(OBJ_LANGUAGE)),
+											ERR_REF_OBJ_INEXISTS_MODEL,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+		func->setLanguage(lang);
+
 		//Case the function's language is C the symbol is the 'definition' attribute
-		if(getObjectName(attribs[ParsersAttributes::LANGUAGE])==~LanguageType("c"))
+		if(lang->getName().toLower()==~LanguageType("c"))
 		{
-			attribs[ParsersAttributes::SYMBOL]=attribs[ParsersAttributes::DEFINITION];
-			attribs[ParsersAttributes::DEFINITION]="";
+			func->setLibrary(attribs[ParsersAttributes::LIBRARY]);
+			func->setSymbol(attribs[ParsersAttributes::DEFINITION]);
 		}
+		else
+			func->setSourceCode(attribs[ParsersAttributes::DEFINITION]);
 
-		//Get the language reference code
-		attribs[ParsersAttributes::LANGUAGE]=getDependencyObject(attribs[ParsersAttributes::LANGUAGE], OBJ_LANGUAGE);
-
-		//Get the return type if there is no return table configured
-		if(attribs[ParsersAttributes::RETURN_TABLE].isEmpty())
+		//Set the return type if there is no return table configured
+		if(func->getReturnedTableColumnCount()==0)
 		{
 			/* If the function is to be used as a user-defined data type support functions
 				 the return type will be renamed to "any" (see rules on Type::setFunction()) */
 			if(attribs[ParsersAttributes::REF_TYPE]==ParsersAttributes::INPUT_FUNC ||
 				 attribs[ParsersAttributes::REF_TYPE]==ParsersAttributes::RECV_FUNC ||
 				 attribs[ParsersAttributes::REF_TYPE]==ParsersAttributes::CANONICAL_FUNC)
-				attribs[ParsersAttributes::RETURN_TYPE]=PgSQLType("any").getCodeDefinition(SchemaParser::XML_DEFINITION);
+				type=PgSQLType("any");
 			else
-				attribs[ParsersAttributes::RETURN_TYPE]=getType(attribs[ParsersAttributes::RETURN_TYPE], true);
+			{
+				type_name=getType(attribs[ParsersAttributes::RETURN_TYPE], false);
+				dim=type_name.count("[]");
+				type_name.remove("[]");
+				type=PgSQLType(type_name);
+				type.setDimension(dim);
+			}
+
+			func->setReturnType(type);
 		}
 
-		loadObjectXML(OBJ_FUNCTION, attribs);
-		func=dbmodel->createFunction();
+		func->setReturnSetOf(!attribs[ParsersAttributes::RETURNS_SETOF].isEmpty());
+		func->setWindowFunction(!attribs[ParsersAttributes::WINDOW_FUNC].isEmpty());
+		func->setLeakProof(!attribs[ParsersAttributes::LEAKPROOF].isEmpty());
+		func->setExecutionCost(attribs[ParsersAttributes::EXECUTION_COST].toInt());
+		func->setRowAmount(attribs[ParsersAttributes::ROW_AMOUNT].toInt());
+
+		if(!attribs[ParsersAttributes::BEHAVIOR_TYPE].isEmpty())
+			func->setBehaviorType(BehaviorType(attribs[ParsersAttributes::BEHAVIOR_TYPE]));
+
+		if(!attribs[ParsersAttributes::FUNCTION_TYPE].isEmpty())
+			func->setFunctionType(FunctionType(attribs[ParsersAttributes::FUNCTION_TYPE]));
+
+		if(!attribs[ParsersAttributes::SECURITY_TYPE].isEmpty())
+			func->setSecurityType(SecurityType(attribs[ParsersAttributes::SECURITY_TYPE]));
+
+		dumpObjectXML(func);
 		dbmodel->addFunction(func);
 	}
 	catch(Exception &e)
 	{
 		if(func) delete(func);
-		throw Exception(e.getErrorMessage(), e.getErrorType(),
-										__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, XMLParser::getXMLBuffer());
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 	}
 }
 
@@ -1317,30 +1804,47 @@ void DatabaseImportHelper::createType(attribs_map &attribs)
 
 	try
 	{
-		attribs[attribs[ParsersAttributes::CONFIGURATION]]="1";
-
-		if(!attribs[ParsersAttributes::ENUM_TYPE].isEmpty())
-			attribs[ParsersAttributes::ENUMARATIONS]=parseArrayValues(attribs[ParsersAttributes::ENUMARATIONS]).join(",");
-		else if(!attribs[ParsersAttributes::COMPOSITE_TYPE].isEmpty())
+		//Enumeration and composite types are built directly from the catalog attributes
+		if(isDirectlyBuilt(OBJ_TYPE, attribs))
 		{
-			QStringList comp_attribs, values;
-			TypeAttribute type_attrib;
+			type=new Type;
+			setBasicAttributes(type, attribs);
 
-			comp_attribs=parseArrayValues(attribs[ParsersAttributes::TYPE_ATTRIBUTE]);
-			attribs[ParsersAttributes::TYPE_ATTRIBUTE]="";
+			if(attribs[ParsersAttributes::CONFIGURATION]==ParsersAttributes::ENUM_TYPE)
+			{
+				type->setConfiguration(Type::ENUMERATION_TYPE);
 
-			for(int i=0; i < comp_attribs.size(); i++)
+				for(auto &label : parseArrayValues(attribs[ParsersAttributes::ENUMARATIONS]))
+					type->addEnumeration(label);
+			}
+			else
 			{
-				values=comp_attribs[i].split(":");
+				QStringList comp_attribs, values;
+				TypeAttribute type_attrib;
 
-				type_attrib.setName(values[0].remove("\""));
-				type_attrib.setType(PgSQLType::parseString(values[1].remove("\\")));
-				type_attrib.setCollation(dbmodel->getObject(getObjectName(values[2].remove("\"")),	OBJ_COLLATION));
+				type->setConfiguration(Type::COMPOSITE_TYPE);
+				comp_attribs=parseArrayValues(attribs[ParsersAttributes::TYPE_ATTRIBUTE]);
 
-				attribs[ParsersAttributes::TYPE_ATTRIBUTE]+=type_attrib.getCodeDefinition(SchemaParser::XML_DEFINITION);
+				for(int i=0; i < comp_attribs.size(); i++)
+				{
+					values=comp_attribs[i].split(":");
+
+					type_attrib=TypeAttribute();
+					type_attrib.setName(values[0].remove("\""));
+					type_attrib.setType(PgSQLType::parseString(values[1].remove("\\")));
+					type_attrib.setCollation(dbmodel->getObject(getObjectName(values[2].remove("\"")),	OBJ_COLLATION));
+					type->addAttribute(type_attrib);
+				}
 			}
+
+			dumpObjectXML(type);
+			dbmodel->addType(type);
+			return;
 		}
-		else if(!attribs[ParsersAttributes::RANGE_TYPE].isEmpty())
+
+		attribs[attribs[ParsersAttributes::CONFIGURATION]]="1";
+
+		if(!attribs[ParsersAttributes::RANGE_TYPE].isEmpty())
 		{
 			QStringList range_attr=parseArrayValues(attribs[ParsersAttributes::RANGE_ATTRIBS]);
 
@@ -1389,23 +1893,21 @@ void DatabaseImportHelper::createType(attribs_map &attribs)
 void DatabaseImportHelper::createTable(attribs_map &attribs)
 {
 	Table *table=nullptr;
+	Column *col=nullptr;
 
 	try
 	{
 		unsigned tab_oid=attribs[ParsersAttributes::OID].toUInt();
-		Column col;
-		map<unsigned, attribs_map>::iterator itr, itr1, itr_end;
-		attribs_map pos_attrib={{ ParsersAttributes::X_POS, "0" },
-														{ ParsersAttributes::Y_POS, "0" }};
-
+		map<unsigned, attribs_map>::iterator itr, itr_end;
 
-		attribs[ParsersAttributes::COLUMNS]="";
-		attribs[ParsersAttributes::POSITION]=SchemaParser::getCodeDefinition(ParsersAttributes::POSITION,
-																																				 pos_attrib, SchemaParser::XML_DEFINITION);
+		table=new Table;
+		setBasicAttributes(table, attribs);
+		table->setWithOIDs(!attribs[ParsersAttributes::OIDS].isEmpty());
+		table->setPosition(QPointF(0,0));
 
 		//Creating columns
-		itr=itr1=columns[attribs[ParsersAttributes::OID].toUInt()].begin();
-		itr_end=columns[attribs[ParsersAttributes::OID].toUInt()].end();
+		itr=columns[tab_oid].begin();
+		itr_end=columns[tab_oid].end();
 
 		while(itr!=itr_end)
 		{
@@ -1413,26 +1915,27 @@ void DatabaseImportHelper::createTable(attribs_map &attribs)
 				 !itr->second.at(ParsersAttributes::PERMISSION).isEmpty())
 				col_perms[tab_oid].push_back(itr->second[ParsersAttributes::OID].toUInt());
 
-			col.setName(itr->second[ParsersAttributes::NAME]);
-			col.setType(PgSQLType::parseString(itr->second[ParsersAttributes::TYPE]));
-			col.setNotNull(!itr->second[ParsersAttributes::NOT_NULL].isEmpty());
-			col.setDefaultValue(itr->second[ParsersAttributes::DEFAULT_VALUE]);
-			col.setComment(itr->second[ParsersAttributes::COMMENT]);
-			col.setCollation(dbmodel->getObject(getObjectName(itr->second[ParsersAttributes::COLLATION]),OBJ_COLLATION));
+			col=new Column;
+			col->setName(itr->second[ParsersAttributes::NAME]);
+			col->setType(PgSQLType::parseString(itr->second[ParsersAttributes::TYPE]));
+			col->setNotNull(!itr->second[ParsersAttributes::NOT_NULL].isEmpty());
+			col->setDefaultValue(itr->second[ParsersAttributes::DEFAULT_VALUE]);
+			col->setComment(itr->second[ParsersAttributes::COMMENT]);
+			col->setCollation(dbmodel->getObject(getObjectName(itr->second[ParsersAttributes::COLLATION]),OBJ_COLLATION));
 
-			attribs[ParsersAttributes::COLUMNS]+=col.getCodeDefinition(SchemaParser::XML_DEFINITION);
+			table->addColumn(col);
+			col=nullptr;
 			itr++;
 		}
 
-		loadObjectXML(OBJ_TABLE, attribs);
-		table=dbmodel->createTable();
+		dumpObjectXML(table);
 		dbmodel->addTable(table);
 	}
 	catch(Exception &e)
 	{
+		if(col) delete(col);
 		if(table) delete(table);
-		throw Exception(e.getErrorMessage(), e.getErrorType(),
-										__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, XMLParser::getXMLBuffer());
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 	}
 }
 
@@ -1443,26 +1946,26 @@ void DatabaseImportHelper::createView(attribs_map &attribs)
 
 	try
 	{
-		attribs_map pos_attrib={{ ParsersAttributes::X_POS, "0" },
-														{ ParsersAttributes::Y_POS, "0" }};
-
+		view=new View;
+		setBasicAttributes(view, attribs);
+		view->setMaterialized(!attribs[ParsersAttributes::MATERIALIZED].isEmpty());
+		view->setPosition(QPointF(0,0));
 
-		attribs[ParsersAttributes::POSITION]=SchemaParser::getCodeDefinition(ParsersAttributes::POSITION,
-																																				 pos_attrib, SchemaParser::XML_DEFINITION);
+		//Only materialized views are stored in a tablespace
+		if(!view->isMaterialized())
+			view->setTablespace(nullptr);
 
-    ref=Reference(attribs[ParsersAttributes::DEFINITION],"");
+		ref=Reference(attribs[ParsersAttributes::DEFINITION],"");
 		ref.setDefinitionExpression(true);
-		attribs[ParsersAttributes::REFERENCES]=ref.getXMLDefinition();
+		view->addReference(ref, Reference::SQL_VIEW_DEFINITION);
 
-		loadObjectXML(OBJ_VIEW, attribs);
-		view=dbmodel->createView();
+		dumpObjectXML(view);
 		dbmodel->addView(view);
 	}
 	catch(Exception &e)
 	{
 		if(view) delete(view);
-		throw Exception(e.getErrorMessage(), e.getErrorType(),
-										__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, XMLParser::getXMLBuffer());
+		throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 	}
 }
 
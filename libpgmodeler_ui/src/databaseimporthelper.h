@@ -27,8 +27,10 @@
 
 #include <QObject>
 #include <QThread>
+#include <QMutex>
 #include "catalog.h"
 #include "modelwidget.h"
+#include "progressthrottle.h"
 
 class DatabaseImportHelper: public QObject {
 	private:
@@ -51,7 +53,13 @@ class DatabaseImportHelper: public QObject {
 		Connection connection;
 
 		//! \brief Stores the current configured catalog filter
-		unsigned import_filter;
+		unsigned import_filter,
+
+		//! \brief Maximum amount of catalog connections used to retrieve the user objects concurrently
+		catalog_pool_size,
+
+		//! \brief Amount of queries executed by the pooled catalog connections during the last import
+		pool_query_count;
 
 		//! \brief Indicates that import was canceled by user (only on thread mode)
 		bool import_canceled,
@@ -69,7 +77,12 @@ class DatabaseImportHelper: public QObject {
 		auto_resolve_deps,
 
 		//! \brief Outputs to STDOUT the executed query catalogs as well the generated XML
-		debug_mode;
+		debug_mode,
+
+		/*! \brief Enables the bulk retrieval mode where the dependencies candidates and the columns of all
+		selected tables are fetched in a few queries before the objects creation instead of querying the
+		catalog once per unresolved oid or table */
+		bulk_retrieval;
 
 		//! \brief Stores the selected objects oids to be imported
 		map<ObjectType, vector<unsigned>> object_oids;
@@ -99,6 +112,22 @@ class DatabaseImportHelper: public QObject {
 		//! \brief Stores all selected columns attributes
 		map<unsigned, map<unsigned, attribs_map>> columns;
 
+		/*! \brief Stores the attributes of the objects fetched in bulk retrieval mode that can be used to resolve
+		dependencies. The attributes are moved to user_objs/system_objs as the dependencies are resolved */
+		map<unsigned, attribs_map> prefetched_objs;
+
+		//! \brief Stores the object types that had their objects fetched in bulk retrieval mode
+		vector<ObjectType> prefetched_types;
+
+		//! \brief Catalogs of the pooled connections used while retrieving the objects concurrently
+		vector<Catalog *> pool_catalogs;
+
+		//! \brief Guards the pooled catalogs since they can be cancelled by the thread that called cancelImport()
+		QMutex pool_mutex;
+
+		//! \brief Limits the rate of the progress signals emitted while processing the objects
+		ProgressThrottle progress_throttle;
+
 		//! \brief Stores the oids of all objects that has permissions to be created
 		vector<unsigned> obj_perms;
 
@@ -185,10 +214,37 @@ class DatabaseImportHelper: public QObject {
 		using the specified set of attributes */
 		void loadObjectXML(ObjectType obj_type, attribs_map &attribs);
 
+		/*! \brief Returns if the object represented by the attributes is constructed directly from the catalog attributes
+		instead of being rendered as XML and parsed back by the model (see loadObjectXML()). For these objects the owner,
+		schema and tablespace attributes hold the names of the referenced objects and the comment holds the plain text */
+		bool isDirectlyBuilt(ObjectType obj_type, attribs_map &attribs);
+
+		/*! \brief Configures the name, comment, schema, owner, tablespace and sql disabled state of an object that
+		is directly built from the catalog attributes */
+		void setBasicAttributes(BaseObject *object, attribs_map &attribs);
+
+		//! \brief Outputs to STDOUT the xml definition of a directly built object (only in debug mode)
+		void dumpObjectXML(BaseObject *object);
+
 		//! \brief Clears the vectors and maps used in the import process
 		void resetImportParameters(void);
 
+		/*! \brief Fetches at once all the objects of the types that can be referenced as dependencies (in bulk retrieval mode)
+		so getDependencyObject() is served from memory instead of querying the catalog for each unresolved oid */
+		void retrieveDependencyObjects(void);
+
+		//! \brief Retrieves the selected columns of all tables in a single query (in bulk retrieval mode)
+		void retrieveColumnsInBulk(void);
+
+		/*! \brief Retrieves the selected objects and columns concurrently using a pool of catalog connections that
+		share the snapshot exported by the main catalog connection. Returns false when the objects can't be retrieved
+		this way (e.g. the server doesn't support snapshot exporting) so the sequential retrieval must be used */
+		bool retrieveUserObjectsInParallel(void);
+
 	public:
+		//! \brief Default amount of catalog connections used to retrieve the user objects
+		static const unsigned DEF_CATALOG_POOL_SIZE=4;
+
 		DatabaseImportHelper(QObject *parent=0);
 
 		//! \brief Set the connection used to access the PostgreSQL server
@@ -202,6 +258,19 @@ class DatabaseImportHelper: public QObject {
 
 		void setImportOptions(bool import_sys_objs, bool import_ext_objs, bool auto_resolve_deps, bool ignore_errors, bool debug_mode);
 
+		//! \brief Enables or disables the bulk retrieval mode (enabled by default)
+		void setBulkRetrieval(bool value);
+
+		/*! \brief Defines the maximum amount of catalog connections used to retrieve the user objects concurrently.
+		Using 1 (one) disables the concurrent retrieval */
+		void setCatalogPoolSize(unsigned size);
+
+		//! \brief Returns the amount of catalog queries (round trips) executed by the last import
+		unsigned getCatalogQueryCount(void);
+
+		//! \brief Returns the amount of progress signals coalesced (not emitted) during the last import
+		unsigned getCoalescedEventsCount(void);
+
 		unsigned getLastSystemOID(void);
 
 		/*! \brief Returns an attribute map for the specified object type. The parameters "schema" and "table"
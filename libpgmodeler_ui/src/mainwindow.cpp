@@ -1298,7 +1298,6 @@ void MainWindow::updateDockWidgets(void)
 void MainWindow::__updateDockWidgets(void)
 {
 	oper_list_wgt->updateOperationList();
-	model_objs_wgt->updateObjectsView();
 
 	/* Any operation executed over the model will reset the validation and
 	the finder will execute the search again */
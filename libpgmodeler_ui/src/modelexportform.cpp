@@ -118,6 +118,7 @@ void ModelExportForm::hideEvent(QHideEvent *)
 	pgsqlvers_chk->setChecked(false);
 	ignore_dup_chk->setChecked(false);
 	drop_db_chk->setChecked(false);
+	batch_exec_chk->setChecked(false);
 	export_to_file_rb->setChecked(true);
 	export_btn->setEnabled(false);
 	export_to_dbms_rb->setChecked(true);
@@ -163,7 +164,8 @@ void ModelExportForm::exportModel(void)
 				if(pgsqlvers1_cmb->isEnabled())
 					version=pgsqlvers1_cmb->currentText();
 
-				export_hlp.setExportToDBMSParams(model->db_model, conn, version, ignore_dup_chk->isChecked(), drop_db_chk->isChecked());
+				export_hlp.setExportToDBMSParams(model->db_model, conn, version, ignore_dup_chk->isChecked(),
+																				 drop_db_chk->isChecked(), false, batch_exec_chk->isChecked());
 				export_thread->start();
 				enableExportModes(false);
 				cancel_btn->setEnabled(true);
@@ -226,6 +228,7 @@ void ModelExportForm::enableExportMode(void)
 	hint4_lbl->setEnabled(!exp_file && !exp_png);
 	ignore_dup_chk->setEnabled(!exp_file && !exp_png);
 	drop_db_chk->setEnabled(!exp_file && !exp_png);
+	batch_exec_chk->setEnabled(!exp_file && !exp_png);
 
 	export_btn->setEnabled((export_to_dbms_rb->isChecked() && connections_cmb->count() > 0) ||
 													 (export_to_file_rb->isChecked() && !file_edt->text().isEmpty()) ||
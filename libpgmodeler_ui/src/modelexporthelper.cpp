@@ -3,10 +3,12 @@
 ModelExportHelper::ModelExportHelper(QObject *parent) : QObject(parent)
 {
 	sql_gen_progress=progress=0;
-	db_created=ignore_dup=drop_db=export_canceled=simulate=false;
+	db_created=ignore_dup=drop_db=export_canceled=simulate=batch_exec=false;
 	created_objs[OBJ_ROLE]=created_objs[OBJ_TABLESPACE]=-1;
 	db_model=nullptr;
-	connection=nullptr;
+	connection=exec_conn=nullptr;
+	exec_errors=nullptr;
+	exec_obj_id=0;
 }
 
 void ModelExportHelper::exportToSQL(DatabaseModel *db_model, const QString &filename, const QString &pgsql_ver)
@@ -46,7 +48,7 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
 	{
 		QPixmap pix;
     //QRectF ret=scene->itemsBoundingRect();
-		bool shw_grd, shw_dlm, align_objs;
+		bool shw_grd, shw_dlm, align_objs, compact_mode=scene->isCompactMode();
 		QGraphicsView viewp(scene);
 		QRect retv;
 		QPolygon pol;
@@ -63,6 +65,10 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
 		//Sets the options passed by the user
 		ObjectsScene::setGridOptions(show_grid, false, show_delim);
 
+		//The objects must be exported with all their details
+		scene->setCompactMode(false);
+		scene->configurePendingItems(true);
+
     if(page_by_page)
     {
       QPrinter::Orientation orient;
@@ -146,6 +152,7 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
       {
         //Restoring the scene settings before throw error
         ObjectsScene::setGridOptions(shw_grd, align_objs, shw_dlm);
+        scene->setCompactMode(compact_mode);
         scene->update();
 
         throw Exception(Exception::getErrorMessage(ERR_FILE_NOT_WRITTEN).arg(Utf8String::create(file)),
@@ -155,6 +162,7 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
 
     //Restoring the scene settings
     ObjectsScene::setGridOptions(shw_grd, align_objs, shw_dlm);
+    scene->setCompactMode(compact_mode);
     scene->update();
 
 		emit s_exportFinished();
@@ -171,19 +179,9 @@ void ModelExportHelper::sleepThread(unsigned msecs)
 		QThread::msleep(msecs);
 }
 
-void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, const QString &pgsql_ver, bool ignore_dup, bool drop_db, bool simulate)
+bool ModelExportHelper::isDuplicationError(const QString &error_code)
 {
-	int type_id;
-	QString  version, sql_buf, sql_cmd, lin;
-	Connection new_db_conn;
-	unsigned i, count;
-	ObjectType types[]={OBJ_ROLE, OBJ_TABLESPACE};
-	BaseObject *object=nullptr;
-	vector<Exception> errors;
-	QTextStream ts;
-	bool ddl_tk_found=false;
-
-	/* Error codes treated in this method
+	/* Error codes treated as object duplicity
 			42P04 	duplicate_database
 			42723 	duplicate_function
 			42P06 	duplicate_schema
@@ -194,8 +192,177 @@ void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, c
 
 		 Reference:
 			http://www.postgresql.org/docs/current/static/errcodes-appendix.html*/
-	QString error_codes[]={"42P04", "42723", "42P06", "42P07", "42710", "42701", "42P16"};
-	vector<QString> err_codes_vect(error_codes, error_codes + sizeof(error_codes) / sizeof(QString));
+	static const QString error_codes[]={"42P04", "42723", "42P06", "42P07", "42710", "42701", "42P16"};
+	static const vector<QString> err_codes_vect(error_codes, error_codes + sizeof(error_codes) / sizeof(QString));
+
+	return(std::find(err_codes_vect.begin(), err_codes_vect.end(), error_code)!=err_codes_vect.end());
+}
+
+void ModelExportHelper::executeCommand(Connection &conn, const QString &cmd, bool ignore_dup, bool use_savepoint, vector<Exception> &errors)
+{
+	try
+	{
+		if(use_savepoint)
+			conn.executeDDLCommand("SAVEPOINT pgmodeler_cmd;");
+
+		conn.executeDDLCommand(cmd);
+
+		if(use_savepoint)
+			conn.executeDDLCommand("RELEASE SAVEPOINT pgmodeler_cmd;");
+	}
+	catch(Exception &e)
+	{
+		if(!ignore_dup || !isDuplicationError(e.getExtraInfo()))
+			throw Exception(Exception::getErrorMessage(ERR_EXPORT_FAILURE).arg(Utf8String::create(cmd)),
+											ERR_EXPORT_FAILURE,__PRETTY_FUNCTION__,__FILE__,__LINE__,&e, cmd);
+		else
+		{
+			//Discarding the failed command so the transaction can proceed
+			if(use_savepoint)
+				conn.executeDDLCommand("ROLLBACK TO SAVEPOINT pgmodeler_cmd;");
+
+			errors.push_back(e);
+			sleepThread(10);
+		}
+	}
+}
+
+void ModelExportHelper::handleStatement(const SQLStatement &stmt)
+{
+	QString cmd=stmt.getCommand();
+
+	if(cmd.isEmpty() || export_canceled)
+		return;
+
+	//Only the first command of each object is shown as creation (the others are comments, ownership, etc.)
+	if(stmt.obj_id!=exec_obj_id && stmt.obj_type!=OBJ_DATABASE)
+		emit s_progressUpdated(progress + (sql_gen_progress * 0.7),
+													 trUtf8("Creating object `%1' (%2)...").arg(Utf8String::create(stmt.name)).arg(BaseObject::getTypeName(stmt.obj_type)),
+													 stmt.obj_type);
+	else
+		//General commands like alter / set aren't explicitly shown
+		emit s_progressUpdated(progress + (sql_gen_progress * 0.7), trUtf8("Executing auxiliary command..."));
+
+	exec_obj_id=stmt.obj_id;
+
+	if(!batch_exec)
+		executeCommand(*exec_conn, cmd, ignore_dup, false, *exec_errors);
+	/* Indexes created concurrently can't be executed inside a transaction block so they are
+	 executed only after the whole export transaction is committed */
+	else if(stmt.obj_type==OBJ_INDEX && cmd.contains("CONCURRENTLY"))
+		deferred_cmds.push_back(cmd);
+	else
+	{
+		batch_cmds.push_back(cmd);
+
+		if(static_cast<unsigned>(batch_cmds.size()) >= BATCH_SIZE)
+			executeBatch();
+	}
+}
+
+void ModelExportHelper::executeBatch(void)
+{
+	if(batch_cmds.empty())
+		return;
+
+	try
+	{
+		exec_conn->executeDDLCommand("SAVEPOINT pgmodeler_batch;\n" + batch_cmds.join("") + "RELEASE SAVEPOINT pgmodeler_batch;");
+	}
+	catch(Exception &e)
+	{
+		//A batch interrupted by the cancel request isn't executed again
+		if(export_canceled)
+			throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+
+		/* Discarding the whole batch and executing its commands one by one in order to
+		 identify the failing command or to ignore the duplicated objects */
+		exec_conn->executeDDLCommand("ROLLBACK TO SAVEPOINT pgmodeler_batch;");
+
+		for(auto &cmd : batch_cmds)
+			executeCommand(*exec_conn, cmd, ignore_dup, true, *exec_errors);
+	}
+
+	batch_cmds.clear();
+}
+
+void ModelExportHelper::createServerObjects(DatabaseModel *db_model, Connection &conn, bool ignore_dup, vector<Exception> &errors)
+{
+	int type_id;
+	QString sql_cmd;
+	unsigned i, count;
+	ObjectType types[]={OBJ_ROLE, OBJ_TABLESPACE};
+	BaseObject *object=nullptr;
+
+	//Creates the roles and tablespaces separately from the other objects
+	for(type_id=0; type_id < 2 && !export_canceled; type_id++)
+	{
+		count=db_model->getObjectCount(types[type_id]);
+
+		for(i=0; i < count && !export_canceled; i++)
+		{
+			object=db_model->getObject(i, types[type_id]);
+			progress=((10 * (type_id+1)) + ((i/static_cast<float>(count)) * 10));
+
+			try
+			{
+				if(!object->isSQLDisabled())
+				{
+					//Emits a signal indicating that the object is being exported
+					emit s_progressUpdated(progress,
+																 trUtf8("Creating object `%1' (%2)...").arg(Utf8String::create(object->getName())).arg(object->getTypeName()),
+																 object->getObjectType());
+
+					sql_cmd=object->getCodeDefinition(SchemaParser::SQL_DEFINITION);
+					conn.executeDDLCommand(sql_cmd);
+				}
+			}
+			catch(Exception &e)
+			{
+				/* Raises an error if the object is duplicated and the ignore duplicity is not set or the error
+				returned by the server is other than object duplicity */
+				if(!ignore_dup || !isDuplicationError(e.getExtraInfo()))
+					throw Exception(e.getErrorMessage(),
+													e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e, sql_cmd);
+				else
+					//If the object is duplicated store the error on a vector
+					errors.push_back(e);
+			}
+
+			created_objs[types[type_id]]++;
+		}
+	}
+
+	try
+	{
+		if(!db_model->isSQLDisabled() && !export_canceled)
+		{
+			//Creating the database on the DBMS
+			emit s_progressUpdated(progress,
+														 trUtf8("Creating database `%1'...").arg(Utf8String::create(db_model->getName())),
+														 OBJ_DATABASE);
+			sql_cmd=db_model->__getCodeDefinition(SchemaParser::SQL_DEFINITION);
+			conn.executeDDLCommand(sql_cmd);
+			db_created=true;
+		}
+	}
+	catch(Exception &e)
+	{
+		/* Raises an error if the object is duplicated and the ignore duplicity is not set or the error
+		returned by the server is other than object duplicity */
+		if(!ignore_dup || !isDuplicationError(e.getExtraInfo()))
+			throw Exception(e.getErrorMessage(),
+											e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e, sql_cmd);
+		else
+			errors.push_back(e);
+	}
+}
+
+void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, const QString &pgsql_ver, bool ignore_dup, bool drop_db, bool simulate, bool batch_exec)
+{
+	QString  version;
+	Connection new_db_conn;
+	vector<Exception> errors;
 
 	try
 	{
@@ -248,72 +415,11 @@ void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, c
 		if(simulate)
 			emit s_progressUpdated(progress, trUtf8("Simulation mode activated..."));
 
-		//Creates the roles and tablespaces separately from the other objects
-		for(type_id=0; type_id < 2 && !export_canceled; type_id++)
-		{
-			count=db_model->getObjectCount(types[type_id]);
+		if(batch_exec)
+			emit s_progressUpdated(progress, trUtf8("Executing commands in batches inside a single transaction..."));
 
-			for(i=0; i < count && !export_canceled; i++)
-			{
-				object=db_model->getObject(i, types[type_id]);
-				progress=((10 * (type_id+1)) + ((i/static_cast<float>(count)) * 10));
-
-				try
-				{
-					if(!object->isSQLDisabled())
-					{
-						//Emits a signal indicating that the object is being exported
-						emit s_progressUpdated(progress,
-																	 trUtf8("Creating object `%1' (%2)...").arg(Utf8String::create(object->getName())).arg(object->getTypeName()),
-																	 object->getObjectType());
-
-						sql_cmd=object->getCodeDefinition(SchemaParser::SQL_DEFINITION);
-						conn.executeDDLCommand(sql_cmd);
-					}
-				}
-				catch(Exception &e)
-				{
-					/* Raises an error if the object is duplicated and the ignore duplicity is not set or the error
-					returned by the server is other than object duplicity */
-					if(!ignore_dup ||
-						 (ignore_dup &&
-							std::find(err_codes_vect.begin(), err_codes_vect.end(), e.getExtraInfo())==err_codes_vect.end()))
-						throw Exception(e.getErrorMessage(),
-														e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e, sql_cmd);
-					else
-						//If the object is duplicated store the error on a vector
-						errors.push_back(e);
-				}
-
-				created_objs[types[type_id]]++;
-			}
-		}
-
-		try
-		{
-			if(!db_model->isSQLDisabled() && !export_canceled)
-			{
-				//Creating the database on the DBMS
-				emit s_progressUpdated(progress,
-															 trUtf8("Creating database `%1'...").arg(Utf8String::create(db_model->getName())),
-															 OBJ_DATABASE);
-				sql_cmd=db_model->__getCodeDefinition(SchemaParser::SQL_DEFINITION);
-				conn.executeDDLCommand(sql_cmd);
-				db_created=true;
-			}
-		}
-		catch(Exception &e)
-		{
-			/* Raises an error if the object is duplicated and the ignore duplicity is not set or the error
-			returned by the server is other than object duplicity */
-			if(!ignore_dup ||
-				 (ignore_dup &&
-					std::find(err_codes_vect.begin(), err_codes_vect.end(), e.getExtraInfo())==err_codes_vect.end()))
-				throw Exception(e.getErrorMessage(),
-												e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e, sql_cmd);
-			else
-				errors.push_back(e);
-		}
+		//Creates the roles, tablespaces and the database itself
+		createServerObjects(db_model, conn, ignore_dup, errors);
 
 		if(!export_canceled)
 		{
@@ -329,135 +435,40 @@ void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, c
 			//Creating the other object types
 			emit s_progressUpdated(progress, trUtf8("Creating objects on database `%1'...").arg(Utf8String::create(db_model->getName())));
 
-			//Generates the sql from entire model
-			sql_buf=db_model->getCodeDefinition(SchemaParser::SQL_DEFINITION, false);
+			//The commands are executed as they are generated (see handleStatement())
+			this->ignore_dup=ignore_dup;
+			this->batch_exec=batch_exec;
+			exec_errors=&errors;
+			exec_obj_id=0;
+			batch_cmds.clear();
+			deferred_cmds.clear();
+
+			exec_conn_mutex.lock();
+			exec_conn=&new_db_conn;
+			exec_conn_mutex.unlock();
 
-			/* Extract each SQL command from the buffer and execute them separately. This is done
-			 to permit the user, in case of error, identify what object is wrongly configured. */
-			ts.setString(&sql_buf);
-			unsigned aux_prog=0, curr_size=0, buf_size=sql_buf.size();
+			if(batch_exec)
+				new_db_conn.executeDDLCommand("BEGIN;");
 
-			progress+=(sql_gen_progress/progress);
-			sql_cmd.clear();
+			db_model->getSQLStatements(*this, false);
 
-			while(!ts.atEnd() && !export_canceled)
+			if(batch_exec)
 			{
-				try
-				{
-					//Cleanup single line comments
-					lin=ts.readLine();
-					curr_size+=lin.size();
-					aux_prog=progress + ((curr_size/static_cast<float>(buf_size)) * 70);
-
-					ddl_tk_found=(lin.indexOf(ParsersAttributes::DDL_END_TOKEN) >= 0);
-					lin.remove(QRegExp("^(--)+(.)+$"));
-
-					//If the line isn't empty after cleanup it will be included on sql command
-					if(!lin.isEmpty())
-						sql_cmd += lin + "\n";
-
-					//If the ddl end token is found
-					if(ddl_tk_found || (!sql_cmd.isEmpty() && ts.atEnd()))
-					{
-						//Regexp used to extract the object being created
-						QRegExp reg=QRegExp("(CREATE)(.)+(\n)", Qt::CaseSensitive);
-
-
-						//Check if the regex matches the sql command
-						if(reg.exactMatch(sql_cmd))
-						{
-							QString obj_type, obj_name;
-							QRegExp reg_aux;
-							unsigned obj_id;
-							ObjectType obj_types[]={ OBJ_FUNCTION, OBJ_TRIGGER, OBJ_INDEX,
-																			 OBJ_RULE,	OBJ_TABLE, OBJ_VIEW, OBJ_DOMAIN,
-																			 OBJ_SCHEMA,	OBJ_AGGREGATE, OBJ_OPFAMILY,
-																			 OBJ_OPCLASS, OBJ_OPERATOR,  OBJ_SEQUENCE,
-																			 OBJ_CONVERSION, OBJ_CAST,	OBJ_LANGUAGE,
-																			 OBJ_COLLATION, OBJ_EXTENSION, OBJ_TYPE };
-							unsigned count=sizeof(obj_types)/sizeof(ObjectType);
-							int pos=0;
-
-							//Get the fisrt line of the sql command, that contains the CREATE ... statement
-							lin=sql_cmd.mid(0, sql_cmd.indexOf('\n'));
-
-							for(obj_id=0; obj_id < count; obj_id++)
-							{
-								//Check if the keyword for the current object exists on string
-								reg_aux.setPattern(QString("(CREATE)(.)*(%1)%2")
-																	 .arg(BaseObject::getSQLName(obj_types[obj_id]))
-																	 .arg(obj_types[obj_id]==OBJ_INDEX ? "( )*(CONCURRENTLY)?" : ""));
-								pos=reg_aux.indexIn(lin);
-
-								if(pos >= 0)
-								{
-									//Extracts from the line the string starting with the object's name
-                  lin=lin.mid(reg_aux.matchedLength(), sql_cmd.indexOf('\n')).simplified();
-
-									//Stores the object type name
-									obj_type=BaseObject::getTypeName(obj_types[obj_id]);
-
-									if(obj_types[obj_id]!=OBJ_CAST)
-									{
-                    int last_quote_idx=lin.lastIndexOf('"'),
-                        first_quote_idx=lin.indexOf('"'),
-                        spc_idx=lin.indexOf(' ');
-
-                    if(spc_idx >=0 && spc_idx < first_quote_idx)
-                      //Getting the name at the first space before the first quote
-                      obj_name=lin.split(' ').at(0);
-                    else if(last_quote_idx >=0)
-                      //Getting the name until the last quote
-                      obj_name=lin.mid(0, last_quote_idx +1);
-                    else
-                      //Gettring the name until the first space or end of string
-                      obj_name=lin.mid(0, (spc_idx >= 0 ? spc_idx + 1 : lin.size()));
-
-                    obj_name.remove('(');
-									}
-									else
-									{
-										obj_name="cast" + lin.replace(" AS ",",");
-									}
-
-									obj_name.remove(';');
-									break;
-								}
-							}
-
-							emit s_progressUpdated(aux_prog,
-																		 trUtf8("Creating object `%1' (%2)...").arg(obj_name).arg(obj_type),
-																		 obj_types[obj_id]);
-						}
-						else
-							//General commands like alter / set aren't explicitly shown
-							emit s_progressUpdated(aux_prog, trUtf8("Executing auxiliary command..."));
-
-						//Executes the extracted SQL command
-						if(!sql_cmd.isEmpty())
-							new_db_conn.executeDDLCommand(sql_cmd);
-
-						sql_cmd.clear();
-						ddl_tk_found=false;
-					}
-				}
-				catch(Exception &e)
-				{
-					if(ddl_tk_found) ddl_tk_found=false;
-
-					if(!ignore_dup ||
-						 (ignore_dup &&
-							std::find(err_codes_vect.begin(), err_codes_vect.end(), e.getExtraInfo())==err_codes_vect.end()))
-						throw Exception(Exception::getErrorMessage(ERR_EXPORT_FAILURE).arg(Utf8String::create(sql_cmd)),
-														ERR_EXPORT_FAILURE,__PRETTY_FUNCTION__,__FILE__,__LINE__,&e, sql_cmd);
-					else
-					{
-						sql_cmd.clear();
-						errors.push_back(e);
-						sleepThread(10);
-					}
-				}
+				if(!export_canceled)
+					executeBatch();
+
+				new_db_conn.executeDDLCommand(export_canceled ? "ROLLBACK;" : "COMMIT;");
+
+				for(int i=0; i < deferred_cmds.size() && !export_canceled; i++)
+					executeCommand(new_db_conn, deferred_cmds[i], ignore_dup, false, errors);
+
+				deferred_cmds.clear();
 			}
+
+			exec_conn_mutex.lock();
+			exec_conn=nullptr;
+			exec_conn_mutex.unlock();
+			exec_errors=nullptr;
 		}
 
 		disconnect(db_model, nullptr, this, nullptr);
@@ -486,6 +497,10 @@ void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, c
 	catch(Exception &e)
 	{
 		disconnect(db_model, nullptr, this, nullptr);
+		exec_conn_mutex.lock();
+		exec_conn=nullptr;
+		exec_conn_mutex.unlock();
+		exec_errors=nullptr;
 
 		if(ignore_dup)
 			restoreGenAtlerCmdsStatus();
@@ -502,9 +517,12 @@ void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, c
 
 		if(conn.isStablished())	conn.close();
 
+		//A command interrupted by the cancel request raises an error that is handled as the export cancellation
+		if(export_canceled)
+			emit s_exportCanceled();
 		/* When running in a separated thread (other than the main application thread)
 		redirects the error in form of signal */
-		if(this->thread() && this->thread()!=qApp->thread())
+		else if(this->thread() && this->thread()!=qApp->thread())
 		{
 			errors.push_back(e);
 			emit s_exportAborted(Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, errors));
@@ -618,7 +636,7 @@ void ModelExportHelper::updateProgress(int prog, QString object_id, unsigned obj
 	emit s_progressUpdated(aux_prog, object_id, static_cast<ObjectType>(obj_type));
 }
 
-void ModelExportHelper::setExportToDBMSParams(DatabaseModel *db_model, Connection *conn, const QString &pgsql_ver, bool ignore_dup, bool drop_db, bool simulate)
+void ModelExportHelper::setExportToDBMSParams(DatabaseModel *db_model, Connection *conn, const QString &pgsql_ver, bool ignore_dup, bool drop_db, bool simulate, bool batch_exec)
 {
 	this->db_model=db_model;
 	this->connection=conn;
@@ -626,15 +644,22 @@ void ModelExportHelper::setExportToDBMSParams(DatabaseModel *db_model, Connectio
 	this->ignore_dup=ignore_dup;
 	this->simulate=simulate;
 	this->drop_db=drop_db;
+	this->batch_exec=batch_exec;
 }
 
 void ModelExportHelper::exportToDBMS(void)
 {
 	if(connection)
-		exportToDBMS(db_model, *connection, pgsql_ver, ignore_dup, drop_db, simulate);
+		exportToDBMS(db_model, *connection, pgsql_ver, ignore_dup, drop_db, simulate, batch_exec);
 }
 
 void ModelExportHelper::cancelExport(void)
 {
 	export_canceled=true;
+
+	//Interrupting the command being executed instead of waiting it to finish
+	exec_conn_mutex.lock();
+	if(exec_conn)
+		exec_conn->cancelCommand();
+	exec_conn_mutex.unlock();
 }
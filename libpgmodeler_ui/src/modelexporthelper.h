@@ -27,8 +27,9 @@
 
 #include "modelwidget.h"
 #include "connection.h"
+#include <QMutex>
 
-class ModelExportHelper: public QObject {
+class ModelExportHelper: public QObject, public SQLStatementHandler {
 	private:
 		Q_OBJECT
 
@@ -55,7 +56,10 @@ class ModelExportHelper: public QObject {
 		drop_db,
 
 		//! \brief Indicates if the exporting thread was canceled by the user (only in thread mode)
-		export_canceled;
+		export_canceled,
+
+		//! \brief Indicates to the exporter to execute the commands in batches (only in thread mode)
+		batch_exec;
 
 		//! \brief Database model used as reference on export operation (only in thread mode)
 		DatabaseModel *db_model;
@@ -79,11 +83,55 @@ class ModelExportHelper: public QObject {
 		//! \brief Revert the dbms export process, removing the created database, roles and tablespaces
 		void undoDBMSExport(DatabaseModel *db_model, Connection &conn);
 
+		/*! \brief Creates the roles, tablespaces and the database of the model on the server (the objects that can't be
+		 created inside a transaction block). The created objects are registered so they can be removed by undoDBMSExport() */
+		void createServerObjects(DatabaseModel *db_model, Connection &conn, bool ignore_dup, vector<Exception> &errors);
+
+		//! \brief Returns if the error code returned by the server is related to object duplicity
+		static bool isDuplicationError(const QString &error_code);
+
+		//! \brief Connection where the model's statements are executed (only during dbms export)
+		Connection *exec_conn;
+
+		//! \brief Guards the execution connection since it can be cancelled by the thread that called cancelExport()
+		QMutex exec_conn_mutex;
+
+		//! \brief Stores the ignored errors of the executed statements (only during dbms export)
+		vector<Exception> *exec_errors;
+
+		//! \brief Id of the object which generated the last executed statement
+		unsigned exec_obj_id;
+
+		//! \brief Commands waiting to be sent to the server on the next round trip (only in batch mode)
+		QStringList batch_cmds;
+
+		/*! \brief Commands that can't run inside a transaction block (e.g. indexes created concurrently) and
+		 are executed only after the export transaction is committed (only in batch mode) */
+		QStringList deferred_cmds;
+
+		/*! \brief Executes the statements of the model as they are generated (see DatabaseModel::getSQLStatements()).
+		 In batch mode the commands are executed inside a single transaction and sent to the server in batches
+		 of BATCH_SIZE commands per round trip (see executeBatch()). Commands that can't be executed inside
+		 a transaction block are deferred until the transaction is committed */
+		void handleStatement(const SQLStatement &stmt);
+
+		/*! \brief Sends the pending commands to the server protected by a savepoint. In case of error the batch is rolled back
+		 and its commands are executed one by one, each one with its own savepoint, in order to identify the failing command
+		 or to ignore the duplicated objects */
+		void executeBatch(void);
+
+		/*! \brief Executes a single command of the model on the connection. The boolean parameter indicates if the command
+		 must be protected by a savepoint (used when the command is executed inside a transaction) */
+		void executeCommand(Connection &conn, const QString &cmd, bool ignore_dup, bool use_savepoint, vector<Exception> &errors);
+
 	protected:
 		//! \brief Configures the DBMS export params before start the export thread (only in thread mode)
-		void setExportToDBMSParams(DatabaseModel *db_model, Connection *conn, const QString &pgsql_ver="", bool ignore_dup=false, bool drop_db=false, bool simulate=false);
+		void setExportToDBMSParams(DatabaseModel *db_model, Connection *conn, const QString &pgsql_ver="", bool ignore_dup=false, bool drop_db=false, bool simulate=false, bool batch_exec=false);
 
 	public:
+		//! \brief Number of commands sent to the server on each round trip when exporting in batch mode
+		static const unsigned BATCH_SIZE=100;
+
 		ModelExportHelper(QObject *parent = 0);
 
 		//! \brief Exports the model to a named SQL file. The PostgreSQL version syntax must be specified.
@@ -96,8 +144,9 @@ class ModelExportHelper: public QObject {
 
 		/*! \brief Exports the model directly to the DBMS. A valid connection must be specified. The PostgreSQL
 		version is optional, since the helper identifies the version from the server. The boolean parameter
-		make the helper to ignore object duplicity errors */
-		void exportToDBMS(DatabaseModel *db_model, Connection conn, const QString &pgsql_ver="", bool ignore_dup=false, bool drop_db=false, bool simulate=false);
+		make the helper to ignore object duplicity errors. The 'batch_exec' parameter makes the objects to be created inside
+		a single transaction sending several commands per round trip to the server (see handleStatement()) */
+		void exportToDBMS(DatabaseModel *db_model, Connection conn, const QString &pgsql_ver="", bool ignore_dup=false, bool drop_db=false, bool simulate=false, bool batch_exec=false);
 
 		/*! \brief When the execution of the instance of this class is in another thread instead of main app
 		thread puts the parent thread to sleep for [msecs] ms to give time to external operationsto be correctly
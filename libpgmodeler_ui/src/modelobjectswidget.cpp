@@ -23,6 +23,8 @@ ModelObjectsWidget::ModelObjectsWidget(bool simplified_view, QWidget *parent) :
 	setupUi(this);
 	model_wgt=nullptr;
 	db_model=nullptr;
+	full_update=false;
+	update_timer.setSingleShot(true);
 	setModel(db_model);
 
 	title_wgt->setVisible(!simplified_view);
@@ -68,6 +70,7 @@ ModelObjectsWidget::ModelObjectsWidget(bool simplified_view, QWidget *parent) :
 
 	connect(tree_view_tb,SIGNAL(clicked(void)),this,SLOT(changeObjectsView(void)));
 	connect(list_view_tb,SIGNAL(clicked(void)),this,SLOT(changeObjectsView(void)));
+	connect(&update_timer, SIGNAL(timeout(void)), this, SLOT(applyPendingUpdates(void)));
 }
 
 void ModelObjectsWidget::hide(void)
@@ -212,7 +215,10 @@ QTreeWidgetItem *ModelObjectsWidget::createItemForObject(BaseObject *object, QTr
   item->setData(0, Qt::UserRole, generateItemValue(object));
 
   if(update_perms)
+  {
+    obj_tree_items[object]=item;
     updatePermissionTree(item, object);
+  }
 
   font=item->font(0);
   font.setStrikeOut(object->isSQLDisabled() && !object->isSystemObject());
@@ -371,16 +377,361 @@ void ModelObjectsWidget::collapseAll(void)
 
 void ModelObjectsWidget::updateObjectsView(void)
 {
+	update_timer.stop();
+	changed_objs.clear();
+	full_update=false;
+
 	updateDatabaseTree();
 	updateObjectsList();
 }
 
+void ModelObjectsWidget::requestObjectsViewUpdate(void)
+{
+	full_update=true;
+	update_timer.start(UPDATE_DELAY);
+}
+
+void ModelObjectsWidget::handleObjectModification(BaseObject *object)
+{
+	TableObject *tab_obj=dynamic_cast<TableObject *>(object);
+	ObjectType obj_type;
+
+	//Table objects are updated together with their parent tables
+	if(tab_obj)
+		object=tab_obj->getParentTable();
+
+	if(object)
+	{
+		obj_type=object->getObjectType();
+
+		//Permissions are displayed (as a counter) under the items of the objects they are applied to
+		if(obj_type==OBJ_PERMISSION)
+		{
+			handleObjectModification(dynamic_cast<Permission *>(object)->getObject());
+			return;
+		}
+
+		//The database items are spread all over the tree so the whole view is rebuilt
+		if(obj_type==OBJ_DATABASE)
+			full_update=true;
+		else if(find(changed_objs.begin(), changed_objs.end(), object)==changed_objs.end())
+			changed_objs.push_back(object);
+
+		/* Relationships changes the tables they connect (propagated columns and constraints). Any other table
+		affected by the relationships revalidation is notified by the model itself */
+		if(obj_type==OBJ_RELATIONSHIP || obj_type==BASE_RELATIONSHIP)
+			queueRelationshipTables(dynamic_cast<BaseRelationship *>(object));
+
+		update_timer.start(UPDATE_DELAY);
+	}
+}
+
+void ModelObjectsWidget::queueRelationshipTables(BaseRelationship *rel)
+{
+	BaseTable *table=nullptr;
+
+	for(unsigned tab_id=BaseRelationship::SRC_TABLE; tab_id <= BaseRelationship::DST_TABLE; tab_id++)
+	{
+		table=rel->getTable(tab_id);
+
+		if(table && find(changed_objs.begin(), changed_objs.end(), table)==changed_objs.end())
+			changed_objs.push_back(table);
+	}
+}
+
+void ModelObjectsWidget::handleObjectRemoval(BaseObject *object)
+{
+	QTreeWidgetItem *item=getTreeItem(object), *group=nullptr;
+	BaseTable *table=dynamic_cast<BaseTable *>(object);
+	ObjectType obj_type=object->getObjectType();
+
+	/* The items of the removed object are destroyed immediately (instead of waiting the update timer)
+	because the object can be deallocated right after being removed from the model */
+	changed_objs.erase(remove(changed_objs.begin(), changed_objs.end(), object), changed_objs.end());
+
+	if(item)
+	{
+		group=item->parent();
+		unregisterTreeItems(item);
+		delete(item);
+
+		if(group && !group->data(0, Qt::UserRole).isValid())
+			updateGroupItem(group);
+	}
+
+	removeListItem(object);
+
+	if(table)
+	{
+		vector<BaseObject *> tab_objs=table->getObjects();
+
+		for(auto tab_obj : tab_objs)
+			removeListItem(tab_obj);
+
+		//The tag items list the tables that references them so they must be updated too
+		if(table->getTag() &&
+			 find(changed_objs.begin(), changed_objs.end(), table->getTag())==changed_objs.end())
+			changed_objs.push_back(table->getTag());
+	}
+
+	//The tables connected by the removed relationship lose the columns and constraints propagated by it
+	if(obj_type==OBJ_RELATIONSHIP || obj_type==BASE_RELATIONSHIP)
+		queueRelationshipTables(dynamic_cast<BaseRelationship *>(object));
+	//The permissions counter is displayed under the item of the object the permission is applied to
+	else if(obj_type==OBJ_PERMISSION)
+		handleObjectModification(object);
+
+	if(full_update || !changed_objs.empty())
+		update_timer.start(UPDATE_DELAY);
+}
+
+void ModelObjectsWidget::applyPendingUpdates(void)
+{
+	vector<BaseObject *> objs;
+	bool upd_tags=false;
+
+	if(!db_model || full_update || changed_objs.size() > MAX_CHANGED_OBJECTS)
+	{
+		updateObjectsView();
+		return;
+	}
+
+	objs.swap(changed_objs);
+
+	for(auto obj : objs)
+	{
+		if(obj->getObjectType()==OBJ_TABLE || obj->getObjectType()==OBJ_VIEW)
+			upd_tags=true;
+	}
+
+	if(upd_tags)
+	{
+		vector<BaseObject *> *tags=db_model->getObjectList(OBJ_TAG);
+
+		for(auto tag : *tags)
+		{
+			if(find(objs.begin(), objs.end(), tag)==objs.end())
+				objs.push_back(tag);
+		}
+	}
+
+	try
+	{
+		objectslist_tbw->setSortingEnabled(false);
+
+		for(unsigned i=0; i < objs.size() && !full_update; i++)
+		{
+			//Ignoring the objects that were detached from the model in the meantime
+			if(db_model->getObjectIndex(objs[i]) >= 0)
+			{
+				full_update=!updateTreeItem(objs[i]);
+				updateListItems(objs[i]);
+			}
+		}
+
+		objectslist_tbw->setSortingEnabled(true);
+	}
+	catch(Exception &)
+	{
+		objectslist_tbw->setSortingEnabled(true);
+		full_update=true;
+	}
+
+	if(full_update)
+		updateObjectsView();
+}
+
+bool ModelObjectsWidget::updateTreeItem(BaseObject *object)
+{
+	QTreeWidgetItem *item=nullptr, *group=nullptr, *prev_group=nullptr;
+	ObjectType obj_type=object->getObjectType();
+	bool expanded=false;
+	vector<BaseObject *> tree_state;
+
+	if(obj_type==OBJ_DATABASE)
+		return(false);
+
+	//Base relationships are listed together with the relationships
+	if(obj_type==BASE_RELATIONSHIP)
+		obj_type=OBJ_RELATIONSHIP;
+
+	//Objects of types not displayed in the tree doesn't need to be updated
+	if(!visible_objs_map[OBJ_DATABASE] || !visible_objs_map[obj_type] ||
+		 (BaseObject::acceptsSchema(obj_type) && !visible_objs_map[OBJ_SCHEMA]))
+		return(true);
+
+	group=getGroupItem(object);
+
+	//If the group item of the object can't be found the complete tree must be rebuilt
+	if(!group)
+		return(false);
+
+	item=getTreeItem(object);
+
+	if(item)
+	{
+		prev_group=item->parent();
+		expanded=item->isExpanded();
+
+		if(save_tree_state)
+			saveTreeState(item, tree_state);
+
+		unregisterTreeItems(item);
+		delete(item);
+	}
+
+	item=createSubtreeForObject(object, group);
+	item->setExpanded(expanded);
+	group->sortChildren(0, Qt::AscendingOrder);
+	updateGroupItem(group);
+
+	//Updating the count of the previous group when the object was moved to another schema
+	if(prev_group && prev_group!=group && !prev_group->data(0, Qt::UserRole).isValid())
+		updateGroupItem(prev_group);
+
+	if(save_tree_state)
+		restoreTreeState(tree_state);
+	else if(simplified_view)
+		objectstree_tw->expandItem(item);
+
+	return(true);
+}
+
+void ModelObjectsWidget::updateListItems(BaseObject *object)
+{
+	vector<BaseObject *> objs;
+	BaseTable *table=dynamic_cast<BaseTable *>(object);
+	QTableWidgetItem *item=nullptr;
+	int row;
+
+	objs.push_back(object);
+
+	if(table)
+	{
+		vector<BaseObject *> tab_objs=table->getObjects();
+		QVariant parent_value=generateItemValue(table);
+		BaseObject *obj=nullptr;
+
+		objs.insert(objs.end(), tab_objs.begin(), tab_objs.end());
+
+		/* Removing the rows of the objects that aren't children of the table anymore. Only the references stored
+		in the items are compared because those objects could be already deallocated */
+		for(row=objectslist_tbw->rowCount()-1; row >= 0; row--)
+		{
+			item=objectslist_tbw->item(row, 0);
+			obj=reinterpret_cast<BaseObject *>(item->data(Qt::UserRole).value<void *>());
+
+			if(item->data(Qt::UserRole + 1)==parent_value &&
+				 find(tab_objs.begin(), tab_objs.end(), obj)==tab_objs.end())
+			{
+				obj_list_items.remove(obj);
+				objectslist_tbw->removeRow(row);
+			}
+		}
+	}
+
+	for(auto obj : objs)
+	{
+		item=obj_list_items.value(obj);
+
+		if(item)
+			row=item->row();
+		else
+		{
+			row=objectslist_tbw->rowCount();
+			objectslist_tbw->insertRow(row);
+		}
+
+		ObjectFinderWidget::updateObjectTableRow(objectslist_tbw, row, obj);
+		registerListItem(row, obj);
+	}
+}
+
+void ModelObjectsWidget::registerListItem(int row, BaseObject *object)
+{
+	QTableWidgetItem *item=objectslist_tbw->item(row, 0);
+	TableObject *tab_obj=dynamic_cast<TableObject *>(object);
+
+	obj_list_items[object]=item;
+
+	//Stores the parent table of table objects in order to remove their rows when they are detached from it
+	if(tab_obj && tab_obj->getParentTable())
+		item->setData(Qt::UserRole + 1, generateItemValue(tab_obj->getParentTable()));
+}
+
+void ModelObjectsWidget::removeListItem(BaseObject *object)
+{
+	QTableWidgetItem *item=obj_list_items.value(object);
+
+	if(item)
+	{
+		objectslist_tbw->removeRow(item->row());
+		obj_list_items.remove(object);
+	}
+}
+
+void ModelObjectsWidget::unregisterTreeItems(QTreeWidgetItem *item)
+{
+	BaseObject *object=reinterpret_cast<BaseObject *>(item->data(0,Qt::UserRole).value<void *>());
+
+	if(object && obj_tree_items.value(object)==item)
+		obj_tree_items.remove(object);
+
+	for(int i=0; i < item->childCount(); i++)
+		unregisterTreeItems(item->child(i));
+}
+
+QTreeWidgetItem *ModelObjectsWidget::getGroupItem(BaseObject *object)
+{
+	QTreeWidgetItem *parent=nullptr, *item=nullptr;
+	ObjectType obj_type=object->getObjectType();
+
+	if(obj_type==BASE_RELATIONSHIP)
+		obj_type=OBJ_RELATIONSHIP;
+
+	//Objects that accepts schema are placed on groups at schema level the others at database level
+	if(BaseObject::acceptsSchema(obj_type))
+		parent=getTreeItem(object->getSchema());
+	else
+		parent=objectstree_tw->topLevelItem(0);
+
+	for(int i=0; parent && i < parent->childCount(); i++)
+	{
+		item=parent->child(i);
+
+		//Group items doesn't store object references on the first column
+		if(item->data(1, Qt::UserRole).toUInt()==static_cast<unsigned>(obj_type) &&
+			 !item->data(0, Qt::UserRole).isValid())
+			return(item);
+	}
+
+	return(nullptr);
+}
+
+void ModelObjectsWidget::updateGroupItem(QTreeWidgetItem *group)
+{
+	ObjectType obj_type=static_cast<ObjectType>(group->data(1, Qt::UserRole).toUInt());
+
+	group->setText(0,BaseObject::getTypeName(obj_type) +
+								 QString(" (%1)").arg(group->childCount()));
+}
+
 void ModelObjectsWidget::updateObjectsList(void)
 {
+	obj_list_items.clear();
+
 	if(db_model)
 	{
 		vector<BaseObject *> objects=db_model->findObjects("", BaseObject::getObjectTypes(),true, false, false, false);
+		QTableWidgetItem *item=nullptr;
+
 		ObjectFinderWidget::updateObjectTable(objectslist_tbw, objects);
+
+		for(int row=0; row < objectslist_tbw->rowCount(); row++)
+		{
+			item=objectslist_tbw->item(row, 0);
+			registerListItem(row, reinterpret_cast<BaseObject *>(item->data(Qt::UserRole).value<void *>()));
+		}
 	}
 }
 
@@ -388,20 +739,14 @@ void ModelObjectsWidget::updateSchemaTree(QTreeWidgetItem *root)
 {
 	if(db_model && visible_objs_map[OBJ_SCHEMA])
 	{
-		BaseObject *object=nullptr, *schema=nullptr;
-		vector<BaseObject *> obj_list;
 		QFont font;
-    QTreeWidgetItem *item=nullptr, *item1=nullptr, *item2=nullptr, *item3=nullptr;
-		ObjectType types[]={ OBJ_FUNCTION, OBJ_AGGREGATE,
-												 OBJ_DOMAIN, OBJ_TYPE, OBJ_CONVERSION,
-												 OBJ_OPERATOR, OBJ_OPFAMILY, OBJ_OPCLASS,
-												 OBJ_SEQUENCE, OBJ_COLLATION, OBJ_EXTENSION };
-		int count, count2, type_cnt=sizeof(types)/sizeof(ObjectType), i, i1, i2;
-
-    QPixmap group_icon=QPixmap(QString(":/icones/icones/") +
-														QString(BaseObject::getSchemaName(OBJ_SCHEMA)) +
-														QString("_grp") +
-														QString(".png"));
+		QTreeWidgetItem *item=nullptr;
+		int count, i;
+
+		QPixmap group_icon=QPixmap(QString(":/icones/icones/") +
+															 QString(BaseObject::getSchemaName(OBJ_SCHEMA)) +
+															 QString("_grp") +
+															 QString(".png"));
 
 		//Get the current schema count on database
 		count=(db_model->getObjectCount(OBJ_SCHEMA));
@@ -419,81 +764,77 @@ void ModelObjectsWidget::updateSchemaTree(QTreeWidgetItem *root)
 		try
 		{
 			for(i=0; i < count; i++)
-			{
-				//The first item is the public schema
-				if(i==-1)
-				{
-					//The new sub item to be configured will be the public schema item
-					item2=item1;
-					schema=nullptr;
-				}
-				else
-				{
-					schema=db_model->getObject(i,OBJ_SCHEMA);
-          item2=createItemForObject(schema, item);
-				}
+				createSchemaSubtree(db_model->getObject(i,OBJ_SCHEMA), item);
+		}
+		catch(Exception &e)
+		{
+			throw Exception(e.getErrorMessage(),e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+		}
+	}
+}
 
-        //Updates the table subtree for the current schema
-				updateTableTree(item2, schema);
+QTreeWidgetItem *ModelObjectsWidget::createSchemaSubtree(BaseObject *schema, QTreeWidgetItem *root)
+{
+	vector<BaseObject *> obj_list;
+	QFont font;
+	QTreeWidgetItem *item=nullptr, *item1=nullptr;
+	ObjectType types[]={ OBJ_FUNCTION, OBJ_AGGREGATE,
+											 OBJ_DOMAIN, OBJ_TYPE, OBJ_CONVERSION,
+											 OBJ_OPERATOR, OBJ_OPFAMILY, OBJ_OPCLASS,
+											 OBJ_SEQUENCE, OBJ_COLLATION, OBJ_EXTENSION };
+	int count, type_cnt=sizeof(types)/sizeof(ObjectType), i, i1;
 
-				//Updates the view subtree for the current schema
-				updateViewTree(item2, schema);
+	item=createItemForObject(schema, root);
 
-				//Creates the object group at schema level (function, domain, sequences, etc)
-				for(i1=0; i1 < type_cnt; i1++)
-				{
-					if(visible_objs_map[types[i1]])
-					{
-						item3=new QTreeWidgetItem(item2);
-						item3->setIcon(0,QPixmap(QString(":/icones/icones/") +
-																		 QString(BaseObject::getSchemaName(types[i1])) +
-																		 QString("_grp") +
-																		 QString(".png")));
-
-						//Get the objects that belongs to the current schema
-						obj_list=db_model->getObjects(types[i1], schema);
-
-						count2=obj_list.size();
-						item3->setText(0,
-													 BaseObject::getTypeName(types[i1]) +
-													 QString(" (%1)").arg(count2));
-						item3->setData(1, Qt::UserRole, QVariant::fromValue<unsigned>(types[i1]));
-
-						font=item3->font(0);
-						font.setItalic(true);
-						item3->setFont(0, font);
+	//Updates the table subtree for the current schema
+	updateTableTree(item, schema);
 
-						for(i2=0; i2 < count2; i2++)
-						{
-							object=obj_list[i2];
-              createItemForObject(object, item3);
-						}
-					}
-				}
-			}
-		}
-		catch(Exception &e)
+	//Updates the view subtree for the current schema
+	updateViewTree(item, schema);
+
+	//Creates the object group at schema level (function, domain, sequences, etc)
+	for(i=0; i < type_cnt; i++)
+	{
+		if(visible_objs_map[types[i]])
 		{
-			throw Exception(e.getErrorMessage(),e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+			item1=new QTreeWidgetItem(item);
+			item1->setIcon(0,QPixmap(QString(":/icones/icones/") +
+															 QString(BaseObject::getSchemaName(types[i])) +
+															 QString("_grp") +
+															 QString(".png")));
+
+			//Get the objects that belongs to the current schema
+			obj_list=db_model->getObjects(types[i], schema);
+
+			count=obj_list.size();
+			item1->setText(0,
+										 BaseObject::getTypeName(types[i]) +
+										 QString(" (%1)").arg(count));
+			item1->setData(1, Qt::UserRole, QVariant::fromValue<unsigned>(types[i]));
+
+			font=item1->font(0);
+			font.setItalic(true);
+			item1->setFont(0, font);
+
+			for(i1=0; i1 < count; i1++)
+				createItemForObject(obj_list[i1], item1);
 		}
 	}
+
+	return(item);
 }
 
 void ModelObjectsWidget::updateTableTree(QTreeWidgetItem *root, BaseObject *schema)
 {
 	if(db_model && visible_objs_map[OBJ_TABLE])
 	{
-		BaseObject *object=nullptr;
 		vector<BaseObject *> obj_list;
-		Table *table=nullptr;
-    QTreeWidgetItem *item=nullptr, *item1=nullptr, *item2=nullptr;
-    QFont font;
-		ObjectType types[]={ OBJ_COLUMN, OBJ_CONSTRAINT, OBJ_RULE,
-												 OBJ_TRIGGER, OBJ_INDEX };
-		int count, count1, type_cnt=sizeof(types)/sizeof(ObjectType), i, i1, i2;
+		QTreeWidgetItem *item=nullptr;
+		QFont font;
+		int count, i;
 		QPixmap group_icon=QPixmap(QString(":/icones/icones/") +
-														QString(BaseObject::getSchemaName(OBJ_TABLE)) +
-														QString("_grp") + QString(".png"));
+															 QString(BaseObject::getSchemaName(OBJ_TABLE)) +
+															 QString("_grp") + QString(".png"));
 
 		try
 		{
@@ -513,36 +854,7 @@ void ModelObjectsWidget::updateTableTree(QTreeWidgetItem *root, BaseObject *sche
 
 			count=obj_list.size();
 			for(i=0; i < count; i++)
-			{
-				table=dynamic_cast<Table *>(obj_list[i]);
-        item1=createItemForObject(table, item);
-
-				//Creating the group for the child objects (column, rules, triggers, indexes and constraints)
-				for(i1=0; i1 < type_cnt; i1++)
-				{
-					if(visible_objs_map[types[i1]])
-					{
-						item2=new QTreeWidgetItem(item1);
-						item2->setIcon(0,QPixmap(QString(":/icones/icones/") +
-																		 QString(BaseObject::getSchemaName(types[i1])) +
-																		 QString("_grp") +
-																		 QString(".png")));
-						font=item2->font(0);
-						font.setItalic(true);
-						item2->setFont(0, font);
-
-						count1=table->getObjectCount(types[i1]);
-						item2->setText(0,BaseObject::getTypeName(types[i1]) +
-													 QString(" (%1)").arg(count1));
-
-						for(i2=0; i2 < count1; i2++)
-						{
-							object=table->getObject(i2,types[i1]);
-              createItemForObject(object, item2);
-						}
-					}
-				}
-			}
+				createTableSubtree(dynamic_cast<BaseTable *>(obj_list[i]), item);
 		}
 		catch(Exception &e)
 		{
@@ -555,23 +867,20 @@ void ModelObjectsWidget::updateViewTree(QTreeWidgetItem *root, BaseObject *schem
 {
 	if(db_model && visible_objs_map[OBJ_VIEW])
 	{
-		BaseObject *object=nullptr;
 		vector<BaseObject *> obj_list;
-		View *view=nullptr;
-    QTreeWidgetItem *item=nullptr, *item1=nullptr, *item2=nullptr;
+		QTreeWidgetItem *item=nullptr;
 		QFont font;
-		ObjectType types[]={ OBJ_RULE, OBJ_TRIGGER };
-		int count, count1, type_cnt=sizeof(types)/sizeof(ObjectType), i, i1, i2;
+		int count, i;
 		QPixmap group_icon=QPixmap(QString(":/icones/icones/") +
-														QString(BaseObject::getSchemaName(OBJ_VIEW)) +
-														QString("_grp") + QString(".png"));
+															 QString(BaseObject::getSchemaName(OBJ_VIEW)) +
+															 QString("_grp") + QString(".png"));
 
 		try
 		{
 			//Get all views that belongs to the specified schema
 			obj_list=db_model->getObjects(OBJ_VIEW, schema);
 
-			//Create a table group item
+			//Create a view group item
 			item=new QTreeWidgetItem(root);
 			item->setIcon(0,group_icon);
 			item->setText(0,BaseObject::getTypeName(OBJ_VIEW) +
@@ -584,42 +893,89 @@ void ModelObjectsWidget::updateViewTree(QTreeWidgetItem *root, BaseObject *schem
 
 			count=obj_list.size();
 			for(i=0; i < count; i++)
-			{
-				view=dynamic_cast<View *>(obj_list[i]);
-        item1=createItemForObject(view, item);
+				createTableSubtree(dynamic_cast<BaseTable *>(obj_list[i]), item);
+		}
+		catch(Exception &e)
+		{
+			throw Exception(e.getErrorMessage(),e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+		}
+	}
+}
 
-        //Creating the group for the child objects (rules, triggers)
-				for(i1=0; i1 < type_cnt; i1++)
-				{
-					if(visible_objs_map[types[i1]])
-					{
-						item2=new QTreeWidgetItem(item1);
-						item2->setIcon(0,QPixmap(QString(":/icones/icones/") +
-																		 QString(BaseObject::getSchemaName(types[i1])) +
-																		 QString("_grp") +
-																		 QString(".png")));
-						font=item2->font(0);
-						font.setItalic(true);
-						item2->setFont(0, font);
+QTreeWidgetItem *ModelObjectsWidget::createTableSubtree(BaseTable *table, QTreeWidgetItem *root)
+{
+	QTreeWidgetItem *item=nullptr, *item1=nullptr;
+	QFont font;
+	ObjectType tab_types[]={ OBJ_COLUMN, OBJ_CONSTRAINT, OBJ_RULE,
+													 OBJ_TRIGGER, OBJ_INDEX },
+						 view_types[]={ OBJ_RULE, OBJ_TRIGGER },
+						 *types=nullptr;
+	int count, type_cnt, i, i1;
+
+	if(table->getObjectType()==OBJ_TABLE)
+	{
+		types=tab_types;
+		type_cnt=sizeof(tab_types)/sizeof(ObjectType);
+	}
+	else
+	{
+		types=view_types;
+		type_cnt=sizeof(view_types)/sizeof(ObjectType);
+	}
 
-						count1=view->getObjectCount(types[i1]);
-						item2->setText(0,BaseObject::getTypeName(types[i1]) +
-													 QString(" (%1)").arg(count1));
+	item=createItemForObject(table, root);
 
-						for(i2=0; i2 < count1; i2++)
-						{
-							object=view->getObject(i2,types[i1]);
-              createItemForObject(object, item2);
-						}
-					}
-				}
-			}
+	//Creating the group for the child objects (columns, rules, triggers, indexes and constraints)
+	for(i=0; i < type_cnt; i++)
+	{
+		if(visible_objs_map[types[i]])
+		{
+			item1=new QTreeWidgetItem(item);
+			item1->setIcon(0,QPixmap(QString(":/icones/icones/") +
+															 QString(BaseObject::getSchemaName(types[i])) +
+															 QString("_grp") +
+															 QString(".png")));
+			font=item1->font(0);
+			font.setItalic(true);
+			item1->setFont(0, font);
+
+			count=table->getObjectCount(types[i]);
+			item1->setText(0,BaseObject::getTypeName(types[i]) +
+										 QString(" (%1)").arg(count));
+
+			for(i1=0; i1 < count; i1++)
+				createItemForObject(table->getObject(i1,types[i]), item1);
 		}
-		catch(Exception &e)
+	}
+
+	return(item);
+}
+
+QTreeWidgetItem *ModelObjectsWidget::createSubtreeForObject(BaseObject *object, QTreeWidgetItem *root)
+{
+	ObjectType obj_type=object->getObjectType();
+	QTreeWidgetItem *item=nullptr;
+
+	if(obj_type==OBJ_SCHEMA)
+		item=createSchemaSubtree(object, root);
+	else if(obj_type==OBJ_TABLE || obj_type==OBJ_VIEW)
+		item=createTableSubtree(dynamic_cast<BaseTable *>(object), root);
+	else
+	{
+		item=createItemForObject(object, root);
+
+		if(obj_type==OBJ_TAG)
 		{
-			throw Exception(e.getErrorMessage(),e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+			vector<BaseObject *> ref_list;
+
+			db_model->getObjectReferences(object, ref_list);
+
+			for(auto ref : ref_list)
+				createItemForObject(ref, item, false);
 		}
 	}
+
+	return(item);
 }
 
 void ModelObjectsWidget::updatePermissionTree(QTreeWidgetItem *root, BaseObject *object)
@@ -654,15 +1010,16 @@ void ModelObjectsWidget::updatePermissionTree(QTreeWidgetItem *root, BaseObject
 
 void ModelObjectsWidget::updateDatabaseTree(void)
 {
+	obj_tree_items.clear();
+
 	if(!db_model)
 		objectstree_tw->clear();
 	else
 	{
 		QString str_aux;
-		BaseObject *object=nullptr;
-    QTreeWidgetItem *root=nullptr,*item1=nullptr, *item2=nullptr;
+		QTreeWidgetItem *root=nullptr,*item1=nullptr;
 		QFont font;
-    vector<BaseObject *> ref_list, tree_state, obj_list;
+		vector<BaseObject *> tree_state, obj_list;
 		ObjectType types[]={ OBJ_ROLE, OBJ_TABLESPACE,
 												 OBJ_LANGUAGE, OBJ_CAST, OBJ_TEXTBOX,
                          OBJ_RELATIONSHIP, OBJ_TAG };
@@ -711,18 +1068,7 @@ void ModelObjectsWidget::updateDatabaseTree(void)
 						item1->setFont(0, font);
 
 						for(i1=0; i1 < count; i1++)
-						{
-							object=obj_list.at(i1);
-              item2=createItemForObject(object, item1);
-
-              if(types[i]==OBJ_TAG)
-              {
-                db_model->getObjectReferences(object, ref_list);
-
-                for(auto ref : ref_list)
-                  createItemForObject(ref, item2, false);
-              }
-            }
+							createSubtreeForObject(obj_list.at(i1), item1);
 					}
 				}
 
@@ -781,7 +1127,20 @@ void ModelObjectsWidget::setModel(DatabaseModel *db_model)
 {
 	bool enable = (db_model!=nullptr);
 
+	//Disconnecting the previous model (the connection handlers are safe to use even if it was destroyed)
+	for(auto &conn : model_conns)
+		disconnect(conn);
+
+	model_conns.clear();
 	this->db_model=db_model;
+
+	if(db_model && !simplified_view)
+	{
+		model_conns.push_back(connect(db_model, SIGNAL(s_objectAdded(BaseObject*)), this, SLOT(handleObjectModification(BaseObject*))));
+		model_conns.push_back(connect(db_model, SIGNAL(s_objectModified(BaseObject*)), this, SLOT(handleObjectModification(BaseObject*))));
+		model_conns.push_back(connect(db_model, SIGNAL(s_objectRemoved(BaseObject*)), this, SLOT(handleObjectRemoval(BaseObject*))));
+	}
+
 	content_wgt->setEnabled(enable);
 	updateObjectsView();
 	visaoobjetos_stw->setEnabled(true);
@@ -863,6 +1222,17 @@ void ModelObjectsWidget::saveTreeState(bool value)
 	save_tree_state=(!simplified_view && value);
 }
 
+void ModelObjectsWidget::saveTreeState(QTreeWidgetItem *root, vector<BaseObject *> &tree_items)
+{
+	BaseObject *obj=reinterpret_cast<BaseObject *>(root->data(0,Qt::UserRole).value<void *>());
+
+	if(obj && root->parent() && root->parent()->isExpanded())
+		tree_items.push_back(obj);
+
+	for(int i=0; i < root->childCount(); i++)
+		saveTreeState(root->child(i), tree_items);
+}
+
 void ModelObjectsWidget::saveTreeState(vector<BaseObject *> &tree_items)
 {
 	QTreeWidgetItemIterator itr(objectstree_tw);
@@ -907,26 +1277,7 @@ void ModelObjectsWidget::restoreTreeState(vector<BaseObject *> &tree_items)
 QTreeWidgetItem *ModelObjectsWidget::getTreeItem(BaseObject *object)
 {
 	if(object)
-	{
-		QTreeWidgetItemIterator itr(objectstree_tw);
-		BaseObject *aux_obj=nullptr;
-		QTreeWidgetItem *item=nullptr;
-
-		while(*itr)
-		{
-			aux_obj=reinterpret_cast<BaseObject *>((*itr)->data(0,Qt::UserRole).value<void *>());
-
-			if(aux_obj==object)
-			{
-				item=*itr;
-				break;
-			}
-
-			++itr;
-		}
-
-		return(item);
-	}
+		return(obj_tree_items.value(object));
 	else
 		return(nullptr);
 }
@@ -60,9 +60,42 @@ class ModelObjectsWidget: public QWidget, public Ui::ModelObjectsWidget {
 		//! \brief Stores which object types are visible on the view
 		map<ObjectType, bool> visible_objs_map;
 
+		//! \brief Delay (in miliseconds) used to coalesce the successive changes on the model in a single view update
+		static const int UPDATE_DELAY=300;
+
+		//! \brief Maximum amount of pending changed objects. Above this value the whole view is rebuilt
+		static const unsigned MAX_CHANGED_OBJECTS=100;
+
+		//! \brief Timer used to defer the update of the view until the model stops changing
+		QTimer update_timer;
+
+		//! \brief Indicates that the whole view (tree and list) must be rebuilt when the update timer expires
+		bool full_update;
+
+		//! \brief Objects added/modified on the model which items are pending to be updated
+		vector<BaseObject *> changed_objs;
+
+		//! \brief Stores the tree item related to each object (used to find the items without scanning the whole tree)
+		QHash<BaseObject *, QTreeWidgetItem *> obj_tree_items;
+
+		//! \brief Stores the item on the first column of the list related to each object
+		QHash<BaseObject *, QTableWidgetItem *> obj_list_items;
+
+		//! \brief Connections made to the signals of the current database model
+		vector<QMetaObject::Connection> model_conns;
+
 		//! \brief Updates only a schema tree starting from the 'root' item
 		void updateSchemaTree(QTreeWidgetItem *root);
 
+		//! \brief Creates the item for the schema and its children objects under the 'root' item
+		QTreeWidgetItem *createSchemaSubtree(BaseObject *schema, QTreeWidgetItem *root);
+
+		//! \brief Creates the item for the table (or view) and its children objects under the 'root' item
+		QTreeWidgetItem *createTableSubtree(BaseTable *table, QTreeWidgetItem *root);
+
+		//! \brief Creates the item for the object under the 'root' item including the subtree of schemas, tables, views and tags
+		QTreeWidgetItem *createSubtreeForObject(BaseObject *object, QTreeWidgetItem *root);
+
 		//! \brief Updates only a table tree starting from the 'root' item
 		void updateTableTree(QTreeWidgetItem *root, BaseObject *schema);
 
@@ -81,6 +114,31 @@ class ModelObjectsWidget: public QWidget, public Ui::ModelObjectsWidget {
 		//! \brief Returns an item from the tree related to the specified object reference
 		QTreeWidgetItem *getTreeItem(BaseObject *object);
 
+		//! \brief Returns the group item (e.g. "Tables (n)") where the specified object item must be placed
+		QTreeWidgetItem *getGroupItem(BaseObject *object);
+
+		//! \brief Updates the text of the group item with its current children count
+		void updateGroupItem(QTreeWidgetItem *group);
+
+		/*! \brief Recreates the subtree of the specified object in place. Returns false when the
+		object can't be updated separately and the whole tree must be rebuilt */
+		bool updateTreeItem(BaseObject *object);
+
+		//! \brief Removes the references to the item and its children from the tree items index
+		void unregisterTreeItems(QTreeWidgetItem *item);
+
+		//! \brief Updates (or inserts) the rows of the object and its children (for tables and views) on the list
+		void updateListItems(BaseObject *object);
+
+		//! \brief Stores the item on the specified row of the list as the one related to the object
+		void registerListItem(int row, BaseObject *object);
+
+		//! \brief Removes the row related to the object from the list
+		void removeListItem(BaseObject *object);
+
+		//! \brief Marks the tables connected by the relationship as pending to be updated
+		void queueRelationshipTables(BaseRelationship *rel);
+
 		//! \brief Generates a QVariant containing the passed object reference as data
 		QVariant generateItemValue(BaseObject *object);
 
@@ -99,6 +157,9 @@ class ModelObjectsWidget: public QWidget, public Ui::ModelObjectsWidget {
 		//! \brief Saves the currently expanded items on the specified vector
 		void saveTreeState(vector<BaseObject *> &tree_items);
 
+		//! \brief Saves the currently expanded items of the subtree starting from the 'root' item
+		void saveTreeState(QTreeWidgetItem *root, vector<BaseObject *> &tree_items);
+
 		//! \brief Restores the tree at a previous state when the specified items were expanded
 		void restoreTreeState(vector<BaseObject *> &tree_items);
 
@@ -110,6 +171,9 @@ class ModelObjectsWidget: public QWidget, public Ui::ModelObjectsWidget {
 		void setModel(DatabaseModel *db_model);
 		void changeObjectsView(void);
 		void updateObjectsView(void);
+
+		//! \brief Schedules a rebuild of the whole view. Successive requests are merged in a single update
+		void requestObjectsViewUpdate(void);
 		void setObjectVisible(ObjectType obj_type, bool visible);
 		void close(void);
 		void hide(void);
@@ -122,6 +186,15 @@ class ModelObjectsWidget: public QWidget, public Ui::ModelObjectsWidget {
 		void editObject(void);
 		void collapseAll(void);
 
+		//! \brief Enqueues the object added/modified on the model to have its items updated
+		void handleObjectModification(BaseObject *object);
+
+		//! \brief Removes the items of the object removed from the model
+		void handleObjectRemoval(BaseObject *object);
+
+		//! \brief Updates the items of the pending objects or rebuilds the whole view if needed
+		void applyPendingUpdates(void);
+
 	signals:
 		void s_visibilityChanged(BaseObject *,bool);
 		void s_visibilityChanged(bool);
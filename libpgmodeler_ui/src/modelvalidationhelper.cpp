@@ -17,13 +17,214 @@
 */
 
 #include "modelvalidationhelper.h"
+#include <QThreadPool>
+
+//Collects the executable commands of the statements generated by DatabaseModel::getSQLStatements()
+class SQLCommandCollector: public SQLStatementHandler {
+	public:
+		vector<SQLStatement> statements;
+
+		void handleStatement(const SQLStatement &stmt)
+		{
+			SQLStatement cmd_stmt=stmt;
+
+			cmd_stmt.sql=stmt.getCommand();
+
+			/* Indexes can't be created concurrently inside a transaction block, since the option
+				 doesn't change the index definition it is discarded during the validation */
+			if(stmt.obj_type==OBJ_INDEX)
+				cmd_stmt.sql.replace("INDEX CONCURRENTLY", "INDEX");
+
+			if(!cmd_stmt.sql.isEmpty())
+				statements.push_back(cmd_stmt);
+		}
+};
+
+//Disjoint sets of objects used to join the objects that must be validated in the same transaction
+class ObjectGroups {
+	private:
+		map<BaseObject *, BaseObject *> parents;
+
+	public:
+		BaseObject *find(BaseObject *object)
+		{
+			BaseObject *root=object, *next=nullptr;
+
+			if(parents.count(object)==0)
+				parents[object]=object;
+
+			while(parents[root]!=root)
+				root=parents[root];
+
+			//Linking the visited objects directly to the root to speed up the next searches
+			while(object!=root)
+			{
+				next=parents[object];
+				parents[object]=root;
+				object=next;
+			}
+
+			return(root);
+		}
+
+		void join(BaseObject *object1, BaseObject *object2)
+		{
+			BaseObject *root1=find(object1), *root2=find(object2);
+
+			if(root1!=root2)
+				parents[root2]=root1;
+		}
+
+		/* Returns the object which represents the group of the specified one. Table objects, permissions
+			 and relationships belong to the group of their tables, the other objects to the group of their schemas */
+		static BaseObject *getGroupObject(BaseObject *object)
+		{
+			TableObject *tab_obj=dynamic_cast<TableObject *>(object);
+			Permission *perm=dynamic_cast<Permission *>(object);
+			Relationship *rel=dynamic_cast<Relationship *>(object);
+
+			if(perm && perm->getObject())
+				return(getGroupObject(perm->getObject()));
+			else if(tab_obj && tab_obj->getParentTable())
+				return(getGroupObject(tab_obj->getParentTable()));
+			else if(rel)
+				return(getGroupObject(rel->getTable(Relationship::SRC_TABLE)));
+			else if(object->getSchema())
+				return(object->getSchema());
+			else
+				return(object);
+		}
+};
+
+//Statements of a group of objects validated in a single transaction and the errors raised by them
+struct SQLValidationGroup {
+	vector<SQLStatement *> statements;
+
+	//Errors raised by the statements and the ids of the objects that generated them (zero for general errors)
+	vector<Exception> errors;
+	vector<unsigned> error_obj_ids;
+
+	static bool isBigger(const vector<SQLStatement *> &stmts1, const vector<SQLStatement *> &stmts2)
+	{
+		return(stmts1.size() > stmts2.size());
+	}
+};
+
+/* Executes on a pool thread the statements of one or more groups using a dedicated connection. Each group is executed
+	 inside a transaction that is rolled back at the end, so the groups can be validated concurrently on the same database.
+	 The statements are sent in batches protected by savepoints, when a batch fails its statements are executed one by one
+	 in order to identify the failing ones and the validation of the group proceeds */
+class SQLValidationTask: public QRunnable {
+	private:
+		Connection *conn;
+		vector<SQLValidationGroup *> groups;
+		QString session_cmds;
+		bool *canceled;
+		QAtomicInt *done_stmts;
+
+		void executeStatement(SQLValidationGroup *group, SQLStatement *stmt)
+		{
+			try
+			{
+				conn->executeDDLCommand("SAVEPOINT pgmodeler_cmd;\n" + stmt->sql + "RELEASE SAVEPOINT pgmodeler_cmd;");
+			}
+			catch(Exception &e)
+			{
+				if(*canceled)
+					throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+
+				conn->executeDDLCommand("ROLLBACK TO SAVEPOINT pgmodeler_cmd;");
+				group->errors.push_back(Exception(Exception::getErrorMessage(ERR_EXPORT_FAILURE).arg(Utf8String::create(stmt->sql)),
+																					ERR_EXPORT_FAILURE,__PRETTY_FUNCTION__,__FILE__,__LINE__,&e, stmt->sql));
+				group->error_obj_ids.push_back(stmt->obj_id);
+			}
+		}
+
+		void executeGroup(SQLValidationGroup *group)
+		{
+			unsigned start=0, end=0, i, count=group->statements.size();
+			QString batch;
+
+			conn->executeDDLCommand("BEGIN;\n" + session_cmds);
+
+			while(start < count && !(*canceled))
+			{
+				end=std::min(start + ModelExportHelper::BATCH_SIZE, count);
+				batch.clear();
+
+				for(i=start; i < end; i++)
+					batch+=group->statements[i]->sql;
+
+				try
+				{
+					conn->executeDDLCommand("SAVEPOINT pgmodeler_batch;\n" + batch + "RELEASE SAVEPOINT pgmodeler_batch;");
+				}
+				catch(Exception &e)
+				{
+					if(*canceled)
+						throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+
+					conn->executeDDLCommand("ROLLBACK TO SAVEPOINT pgmodeler_batch;");
+
+					for(i=start; i < end && !(*canceled); i++)
+						executeStatement(group, group->statements[i]);
+				}
+
+				done_stmts->fetchAndAddRelaxed(end - start);
+				start=end;
+			}
+
+			conn->executeDDLCommand("ROLLBACK;");
+		}
+
+	public:
+		SQLValidationTask(Connection *conn, const QString &session_cmds, bool *canceled, QAtomicInt *done_stmts)
+		{
+			this->conn=conn;
+			this->session_cmds=session_cmds;
+			this->canceled=canceled;
+			this->done_stmts=done_stmts;
+		}
+
+		void addGroup(SQLValidationGroup *group)
+		{
+			groups.push_back(group);
+		}
+
+		void run(void)
+		{
+			vector<SQLValidationGroup *>::iterator itr=groups.begin();
+
+			while(itr!=groups.end() && !(*canceled))
+			{
+				try
+				{
+					executeGroup(*itr);
+				}
+				catch(Exception &e)
+				{
+					//Errors raised outside the savepoints (e.g. lost connection) abort the validation of the group
+					(*itr)->errors.push_back(e);
+					(*itr)->error_obj_ids.push_back(0);
+
+					try
+					{
+						conn->executeDDLCommand("ROLLBACK;");
+					}
+					catch(Exception &){}
+				}
+
+				itr++;
+			}
+		}
+};
 
 ModelValidationHelper::ModelValidationHelper(void)
 {
 	warn_count=error_count=progress=0;
 	db_model=nullptr;
 	conn=nullptr;
-	valid_canceled=fix_mode=false;
+	valid_canceled=fix_mode=parallel_sql=false;
 	export_thread=new QThread(this);
 	export_helper.moveToThread(export_thread);
 
@@ -33,12 +234,6 @@ ModelValidationHelper::ModelValidationHelper(void)
 	connect(&export_helper, SIGNAL(s_exportAborted(Exception)), this, SLOT(captureThreadError(Exception)));
 }
 
-void ModelValidationHelper::sleepThread(unsigned msecs)
-{
-	if(qApp->thread()!=this->thread())
-		QThread::msleep(msecs);
-}
-
 void  ModelValidationHelper::resolveConflict(ValidationInfo &info)
 {
 	try
@@ -66,8 +261,6 @@ void  ModelValidationHelper::resolveConflict(ValidationInfo &info)
 			//Swap the id of the validation object and the found object (minor id)
 			if(obj)
 				BaseObject::swapObjectsIds(info.getObject(), obj, true);
-
-			sleepThread(5);
 		}
 		//Resolving no unique name by renaming the constraints/indexes
 		else if(info.getValidationType()==ValidationInfo::NO_UNIQUE_NAME)
@@ -127,7 +320,6 @@ void  ModelValidationHelper::resolveConflict(ValidationInfo &info)
 				}
 
 				refs.pop_back();
-				sleepThread(5);
 			}
 		}
 	}
@@ -147,13 +339,18 @@ unsigned ModelValidationHelper::getErrorCount(void)
 	return(error_count);
 }
 
+unsigned ModelValidationHelper::getCoalescedEventsCount(void)
+{
+	return(progress_throttle.getCoalescedCount());
+}
+
 void ModelValidationHelper::redirectExportProgress(int prog, QString msg, ObjectType obj_type)
 {
 	progress=41 + (prog * 0.55);
 	emit s_progressUpdated(progress, msg, obj_type);
 }
 
-void ModelValidationHelper::setValidationParams(DatabaseModel *model, Connection *conn, const QString &pgsql_ver)
+void ModelValidationHelper::setValidationParams(DatabaseModel *model, Connection *conn, const QString &pgsql_ver, bool parallel_sql)
 {
 	fix_mode=false;
 	valid_canceled=false;
@@ -161,6 +358,7 @@ void ModelValidationHelper::setValidationParams(DatabaseModel *model, Connection
 	this->db_model=model;
 	this->conn=conn;
 	this->pgsql_ver=pgsql_ver;
+	this->parallel_sql=parallel_sql;
 	export_helper.setExportToDBMSParams(model, conn, pgsql_ver, false, false, true);
 }
 
@@ -201,6 +399,7 @@ void ModelValidationHelper::validateModel(void)
 		QString name, signal_msg="`%1' (%2)";
 
 		warn_count=error_count=progress=0;
+		progress_throttle.reset();
 		val_infos.clear();
 		valid_canceled=false;
 
@@ -219,7 +418,8 @@ void ModelValidationHelper::validateModel(void)
 				//Excluding the validation of system objects (created automatically)
 				if(!object->isSystemObject())
 				{
-					emit s_objectProcessed(signal_msg.arg(object->getName()).arg(object->getTypeName()), object->getObjectType());
+					if(progress_throttle.isEmitAllowed())
+						emit s_objectProcessed(signal_msg.arg(object->getName()).arg(object->getTypeName()), object->getObjectType());
 
 					/* Special validation case: For generalization and copy relationships validates the ids of participant tables.
 					 * Reference table cannot own an id greater thant receiver table */
@@ -292,8 +492,6 @@ void ModelValidationHelper::validateModel(void)
 			//Emit a signal containing the validation progress
 			progress=((i+1)/static_cast<float>(count))*20;
 			emit s_progressUpdated(progress, "");
-
-			sleepThread(5);
 		}
 
 
@@ -307,7 +505,8 @@ void ModelValidationHelper::validateModel(void)
 		{
 			table=dynamic_cast<Table *>(*itr);
 
-			emit s_objectProcessed(signal_msg.arg(table->getName()).arg(object->getTypeName()), table->getObjectType());
+			if(progress_throttle.isEmitAllowed())
+				emit s_objectProcessed(signal_msg.arg(table->getName()).arg(table->getTypeName()), table->getObjectType());
 
 			itr++;
 
@@ -336,8 +535,6 @@ void ModelValidationHelper::validateModel(void)
 						dup_objects[name].push_back(tab_obj);
 				}
 			}
-
-			sleepThread(5);
 		}
 
 		/* Inserting the tables and views to the map in order to check if there is table objects
@@ -351,8 +548,6 @@ void ModelValidationHelper::validateModel(void)
 				dup_objects[(*itr)->getName(true).remove("\"")].push_back(*itr);
 				itr++;
 			}
-
-			sleepThread(5);
 		}
 
 		//Checking the map of duplicated objects
@@ -379,10 +574,11 @@ void ModelValidationHelper::validateModel(void)
 
 			//Emit a signal containing the validation progress
 			progress=20 + ((i/static_cast<float>(dup_objects.size()))*20);
-			emit s_progressUpdated(progress, "");
+
+			if(progress_throttle.isEmitAllowed())
+				emit s_progressUpdated(progress, "");
 
 			i++; mitr++;
-			sleepThread(5);
 		}
 
 		if(!valid_canceled && !fix_mode)
@@ -398,11 +594,17 @@ void ModelValidationHelper::validateModel(void)
 			else
 			{
 				//If there is no errors start the dbms export thread
-				if(error_count==0)
+				if(error_count==0 && !parallel_sql)
 				{
 					export_thread->start();
 					emit s_sqlValidationStarted(true);
 				}
+				//In parallel mode the SQL code is validated by the validation thread itself
+				else if(error_count==0)
+				{
+					emit s_sqlValidationStarted(true);
+					validateSQLCode();
+				}
 				else
 				{
 					warn_count++;
@@ -436,7 +638,6 @@ void ModelValidationHelper::applyFixes(void)
 			emit s_fixApplied();
 
 			validateModel();
-			sleepThread(5);
 		}
 
 		if(!valid_canceled && val_infos.empty())
@@ -456,9 +657,276 @@ void ModelValidationHelper::cancelValidation(void)
 	val_infos.clear();
 	export_thread->quit();
 	export_helper.cancelExport();
+
+	//Interrupting the commands being executed by the parallel SQL validation
+	sql_conns_mutex.lock();
+
+	for(auto sql_conn : sql_conns)
+		sql_conn->cancelCommand();
+
+	sql_conns_mutex.unlock();
+
 	emitValidationCanceled();
 }
 
+void ModelValidationHelper::validateSQLCode(void)
+{
+	Connection srv_conn, db_conn;
+	SQLCommandCollector collector;
+	map<unsigned, BaseObject *> objects;
+	vector<vector<SQLStatement *> > stmt_groups;
+	vector<SQLValidationGroup> groups;
+	vector<SQLValidationTask *> tasks;
+	vector<unsigned> task_loads;
+	vector<Exception> errors;
+	QString session_cmds;
+	QAtomicInt done_stmts(0);
+	unsigned i, conn_count=0, stmt_count=0, group_errors=0, task_idx;
+	//The pool is declared after the groups so it is destroyed (waiting the running tasks) before them
+	QThreadPool pool;
+
+	try
+	{
+		export_helper.export_canceled=export_helper.db_created=false;
+		export_helper.progress=0;
+		export_helper.created_objs[OBJ_ROLE]=export_helper.created_objs[OBJ_TABLESPACE]=-1;
+
+		srv_conn=(*conn);
+		srv_conn.connect();
+		SchemaParser::setPgSQLVersion(!pgsql_ver.isEmpty() ? pgsql_ver : srv_conn.getPgSQLVersion().mid(0,3));
+		export_helper.createServerObjects(db_model, srv_conn, false, errors);
+
+		if(!valid_canceled)
+		{
+			progress=60;
+			emit s_progressUpdated(progress, trUtf8("Generating the SQL code of the objects..."));
+
+			for(auto obj_itr : db_model->getCreationOrder(SchemaParser::SQL_DEFINITION))
+				objects[obj_itr.second->getObjectId()]=obj_itr.second;
+
+			db_model->getSQLStatements(collector, false);
+			groupStatements(collector.statements, objects, stmt_groups, session_cmds);
+
+			//Distributing the bigger groups first between the connections in order to balance the load
+			std::sort(stmt_groups.begin(), stmt_groups.end(), SQLValidationGroup::isBigger);
+
+			groups.resize(stmt_groups.size());
+			for(i=0; i < stmt_groups.size(); i++)
+			{
+				groups[i].statements=stmt_groups[i];
+				stmt_count+=stmt_groups[i].size();
+			}
+
+			conn_count=(groups.size() < SQL_POOL_SIZE ? groups.size() : SQL_POOL_SIZE);
+			db_conn=srv_conn;
+			db_conn.setConnectionParam(Connection::PARAM_DB_NAME, db_model->getName());
+
+			sql_conns_mutex.lock();
+
+			try
+			{
+				for(i=0; i < conn_count; i++)
+				{
+					sql_conns.push_back(new Connection);
+					(*sql_conns.back())=db_conn;
+					sql_conns.back()->connect();
+					tasks.push_back(new SQLValidationTask(sql_conns.back(), session_cmds, &valid_canceled, &done_stmts));
+					task_loads.push_back(0);
+				}
+			}
+			catch(Exception &e)
+			{
+				sql_conns_mutex.unlock();
+				throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+			}
+
+			sql_conns_mutex.unlock();
+
+			for(auto &group : groups)
+			{
+				task_idx=std::min_element(task_loads.begin(), task_loads.end()) - task_loads.begin();
+				tasks[task_idx]->addGroup(&group);
+				task_loads[task_idx]+=group.statements.size();
+			}
+
+			pool.setMaxThreadCount(conn_count);
+			for(auto task : tasks)
+				pool.start(task);
+
+			tasks.clear();
+
+			while(!pool.waitForDone(50))
+			{
+				progress=60 + ((done_stmts.load()/static_cast<float>(stmt_count)) * 36);
+				emit s_progressUpdated(progress, trUtf8("Validating `%1' group(s) of objects... (`%2' connections)")
+																				 .arg(groups.size()).arg(conn_count));
+			}
+
+			for(auto &group : groups)
+				group_errors+=group.errors.size();
+
+			/* References written as free text (e.g. function bodies, default values) aren't considered when grouping
+				 the objects so the errors are confirmed by executing all the statements in a single transaction */
+			if(group_errors > 0 && groups.size() > 1 && !valid_canceled)
+			{
+				SQLValidationTask task(sql_conns.front(), session_cmds, &valid_canceled, &done_stmts);
+
+				emit s_progressUpdated(progress, trUtf8("Confirming the SQL validation errors..."));
+
+				groupStatements(collector.statements, objects, stmt_groups, session_cmds, true);
+				groups.clear();
+				groups.resize(1);
+				groups[0].statements=stmt_groups[0];
+				task.addGroup(&groups[0]);
+				task.run();
+			}
+		}
+
+		sql_conns_mutex.lock();
+
+		for(auto sql_conn : sql_conns)
+			delete(sql_conn);
+
+		sql_conns.clear();
+		sql_conns_mutex.unlock();
+
+		export_helper.undoDBMSExport(db_model, srv_conn);
+		srv_conn.close();
+
+		if(!valid_canceled)
+		{
+			for(auto &group : groups)
+			{
+				for(i=0; i < group.errors.size(); i++)
+				{
+					warn_count++;
+					emit s_validationInfoGenerated(ValidationInfo(group.errors[i],
+																												(objects.count(group.error_obj_ids[i]) ?
+																												 objects[group.error_obj_ids[i]] : nullptr)));
+				}
+			}
+
+			emitValidationFinished();
+		}
+	}
+	catch(Exception &e)
+	{
+		pool.waitForDone();
+
+		for(auto task : tasks)
+			delete(task);
+
+		sql_conns_mutex.lock();
+
+		for(auto sql_conn : sql_conns)
+			delete(sql_conn);
+
+		sql_conns.clear();
+		sql_conns_mutex.unlock();
+
+		try
+		{
+			export_helper.undoDBMSExport(db_model, srv_conn);
+		}
+		catch(Exception &){}
+
+		if(srv_conn.isStablished())
+			srv_conn.close();
+
+		if(!valid_canceled)
+			captureThreadError(e);
+	}
+}
+
+void ModelValidationHelper::groupStatements(vector<SQLStatement> &stmts, map<unsigned, BaseObject *> &objects,
+																						vector<vector<SQLStatement *> > &groups, QString &session_cmds, bool single_group)
+{
+	ObjectGroups obj_groups;
+	map<BaseObject *, unsigned> group_idxs;
+	vector<BaseObject *> deps;
+	vector<SQLStatement *> all_stmts;
+	map<unsigned, BaseObject *>::iterator itr;
+	BaseObject *object=nullptr, *root=nullptr;
+	ObjectType obj_type;
+	Table *table=nullptr;
+	Constraint *constr=nullptr;
+	unsigned i;
+
+	//Joining the groups of the objects and the groups of their dependencies
+	for(itr=objects.begin(); itr!=objects.end() && !single_group; itr++)
+	{
+		object=itr->second;
+		obj_type=object->getObjectType();
+
+		//Roles, tablespaces and database are created outside the transactions
+		if(obj_type==OBJ_DATABASE || obj_type==OBJ_ROLE || obj_type==OBJ_TABLESPACE)
+			continue;
+
+		deps.clear();
+		db_model->getObjectDependecies(object, deps, false);
+
+		//Foreign keys aren't listed as dependencies of the tables
+		table=dynamic_cast<Table *>(object);
+		for(i=0; table && i < table->getConstraintCount(); i++)
+		{
+			constr=table->getConstraint(i);
+
+			if(constr->getConstraintType()==ConstraintType::foreign_key && constr->getReferencedTable())
+				deps.push_back(constr->getReferencedTable());
+		}
+
+		for(auto dep : deps)
+		{
+			obj_type=dep->getObjectType();
+
+			//System objects aren't created by the model's code so they don't join groups
+			if(!dep->isSystemObject() &&
+				 obj_type!=OBJ_DATABASE && obj_type!=OBJ_ROLE && obj_type!=OBJ_TABLESPACE)
+				obj_groups.join(ObjectGroups::getGroupObject(object), ObjectGroups::getGroupObject(dep));
+		}
+	}
+
+	session_cmds.clear();
+	groups.clear();
+
+	for(auto &stmt : stmts)
+	{
+		object=(objects.count(stmt.obj_id) ? objects[stmt.obj_id] : nullptr);
+
+		/* The SET commands generated by the database model configure the session of each group. Any other command
+			 of the database model (e.g. the appended SQL code) may reference any object so all the statements are
+			 executed in a single group */
+		if(!object || object->getObjectType()==OBJ_DATABASE)
+		{
+			if(stmt.sql.trimmed().startsWith("SET ", Qt::CaseInsensitive))
+			{
+				session_cmds+=stmt.sql;
+				continue;
+			}
+
+			single_group=true;
+			root=db_model;
+		}
+		else
+			root=obj_groups.find(ObjectGroups::getGroupObject(object));
+
+		if(group_idxs.count(root)==0)
+		{
+			group_idxs[root]=groups.size();
+			groups.push_back(vector<SQLStatement *>());
+		}
+
+		groups[group_idxs[root]].push_back(&stmt);
+		all_stmts.push_back(&stmt);
+	}
+
+	if(single_group)
+	{
+		groups.clear();
+		groups.push_back(all_stmts);
+	}
+}
+
 void ModelValidationHelper::captureThreadError(Exception e)
 {
 	export_thread->quit();
@@ -26,10 +26,12 @@
 #define MODEL_VALIDATION_HELPER_H
 
 #include <QObject>
+#include <QMutex>
 #include "validationinfo.h"
 #include "databasemodel.h"
 #include "connection.h"
 #include "modelexporthelper.h"
+#include "progressthrottle.h"
 
 class ModelValidationHelper: public QObject {
 	private:
@@ -65,17 +67,43 @@ class ModelValidationHelper: public QObject {
 		This vector is read when applying fixes */
 		vector<ValidationInfo> val_infos;
 
-		/*! \brief When the execution of the instance of this class is in another thread instead of main app
-		thread puts the parent thread to sleep for [msecs] ms to give time to external operationsto be correctly
-		finished before completely quit the thread itself otherwise the method don't do anything. */
-		void sleepThread(unsigned msecs);
+		//! \brief Limits the rate of the progress signals emitted while validating the objects
+		ProgressThrottle progress_throttle;
+
+		/*! \brief Indicates that the SQL code is validated by groups of independent objects executed concurrently
+		inside transactions that are rolled back instead of exporting the whole model serially (see validateSQLCode()) */
+		bool parallel_sql;
+
+		//! \brief Connections used by the running SQL validation tasks (used to interrupt them on cancellation)
+		vector<Connection *> sql_conns;
+
+		//! \brief Controls the access to the SQL validation connections
+		QMutex sql_conns_mutex;
+
+		/*! \brief Validates the SQL code of the model on the server. The roles, tablespaces and the database are created
+		as in the export process since they can't be created inside a transaction. The other objects are split in groups
+		(the schemas and the objects of other schemas they depend on) and each group is executed inside a transaction
+		that is rolled back, using up to SQL_POOL_SIZE connections concurrently. The errors are reported
+		in form of validation infos related to the objects that generated the failing commands */
+		void validateSQLCode(void);
+
+		/*! \brief Splits the statements in groups that can be executed independently (or in a single group when
+		'single_group' is true). The statements are stored in the groups in the same order they were generated.
+		The SET commands generated by the database model are returned separately since they must be executed
+		at the start of each group */
+		void groupStatements(vector<SQLStatement> &stmts, map<unsigned, BaseObject *> &objects,
+												 vector<vector<SQLStatement *> > &groups, QString &session_cmds, bool single_group=false);
 
 	public:
+		//! \brief Maximum amount of connections used to validate the SQL code in parallel mode
+		static const unsigned SQL_POOL_SIZE=4;
+
 		ModelValidationHelper(void);
 
 		/*! \brief Validates the specified model. If a connection is specifies executes the
-		SQL validation directly on DBMS */
-		void setValidationParams(DatabaseModel *model, Connection *conn=nullptr, const QString &pgsql_ver="");
+		SQL validation directly on DBMS. The 'parallel_sql' parameter makes the SQL code to be
+		validated concurrently inside transactions that are rolled back (see validateSQLCode()) */
+		void setValidationParams(DatabaseModel *model, Connection *conn=nullptr, const QString &pgsql_ver="", bool parallel_sql=false);
 
 		//! \brief Switch the validator to fix mode
 		void switchToFixMode(bool value);
@@ -89,6 +117,9 @@ class ModelValidationHelper: public QObject {
 		//! \brief Returns the warning count
 		unsigned getWarningCount(void);
 
+		//! \brief Returns the amount of progress signals coalesced (not emitted) during the last validation
+		unsigned getCoalescedEventsCount(void);
+
 		//! \brief Try to resolve the conflict specified by validation info
 		void resolveConflict(ValidationInfo &info);
 
@@ -53,9 +53,11 @@ ModelValidationWidget::ModelValidationWidget(QWidget *parent): QWidget(parent)
 		connect(options_btn, SIGNAL(toggled(bool)), options_frm, SLOT(setVisible(bool)));
 		connect(sql_validation_chk, SIGNAL(toggled(bool)), connections_cmb, SLOT(setEnabled(bool)));
 		connect(sql_validation_chk, SIGNAL(toggled(bool)), version_cmb, SLOT(setEnabled(bool)));
+		connect(sql_validation_chk, SIGNAL(toggled(bool)), parallel_sql_chk, SLOT(setEnabled(bool)));
 		connect(version_cmb, SIGNAL(currentIndexChanged(int)), this, SLOT(configureValidation(void)));
 		connect(connections_cmb, SIGNAL(currentIndexChanged(int)), this, SLOT(configureValidation(void)));
 		connect(sql_validation_chk, SIGNAL(toggled(bool)), this, SLOT(configureValidation(void)));
+		connect(parallel_sql_chk, SIGNAL(toggled(bool)), this, SLOT(configureValidation(void)));
 		connect(validation_thread, SIGNAL(started(void)), &validation_helper, SLOT(validateModel(void)));
 		connect(validate_btn, SIGNAL(clicked(void)), this, SLOT(validateModel(void)));
 		connect(validation_thread, SIGNAL(started(void)), &validation_helper, SLOT(applyFixes(void)));
@@ -196,6 +198,10 @@ void ModelValidationWidget::updateValidation(ValidationInfo val_info)
 									 .arg(val_info.getReferences().size()));
 
 	}
+	else if(val_info.getValidationType()==ValidationInfo::SQL_VALIDATION_ERR && val_info.getObject())
+		label->setText(trUtf8("The SQL code of the object <strong>%1</strong> <em>(%2)</em> failed due to error(s) below. <strong>NOTE:</strong><em> These errors does not invalidates the model thus you can save it without any problem.</em>")
+									 .arg(Utf8String::create(val_info.getObject()->getName(true).remove("\"")))
+									 .arg(val_info.getObject()->getTypeName()));
 	else if(val_info.getValidationType()==ValidationInfo::SQL_VALIDATION_ERR)
 		label->setText(trUtf8("SQL validation failed due to error(s) below. <strong>NOTE:</strong><em> These errors does not invalidates the model thus you can save it without any problem.</em>"));
 	else
@@ -208,8 +214,13 @@ void ModelValidationWidget::updateValidation(ValidationInfo val_info)
 		QStringList errors=val_info.getErrors();
 		QFont fnt;
 		item->setIcon(0, QPixmap(QString(":/icones/icones/msgbox_alerta.png")));
-		validation_prog_pb->setValue(validation_prog_pb->maximum());		
-		reenableValidation();
+
+		//Errors related to objects are reported while the SQL validation is still running
+		if(!val_info.getObject())
+		{
+			validation_prog_pb->setValue(validation_prog_pb->maximum());
+			reenableValidation();
+		}
 
 		if(val_info.getValidationType()==ValidationInfo::SQL_VALIDATION_ERR)
 		{
@@ -388,7 +399,7 @@ void ModelValidationWidget::configureValidation(void)
 			conn=reinterpret_cast<Connection *>(connections_cmb->itemData(connections_cmb->currentIndex()).value<void *>());
 		}
 
-		validation_helper.setValidationParams(model_wgt->getDatabaseModel(), conn, ver);
+		validation_helper.setValidationParams(model_wgt->getDatabaseModel(), conn, ver, parallel_sql_chk->isChecked());
 	}
 }
 
@@ -175,6 +175,10 @@ ModelWidget::ModelWidget(QWidget *parent) : QWidget(parent)
 	//Force the scene to be drawn from the left to right and from top to bottom
 	viewport->setAlignment(Qt::AlignLeft | Qt::AlignTop);
 	viewport->setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
+
+	//The frame time overlay is refreshed only if the whole viewport is redrawn on each frame
+	if(ObjectsScene::isFrameTimeVisible())
+		viewport->setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
 	viewport->centerOn(0,0);
 	this->applyZoom(1);
 
@@ -454,6 +458,9 @@ void ModelWidget::applyZoom(float zoom)
 		viewport->resetTransform();
 		viewport->scale(zoom, zoom);
 
+		//Tables and views are drawn without their children objects when the zoom is too low
+		scene->setZoomFactor(zoom);
+
 		this->current_zoom=zoom;
 		emit s_zoomModified(zoom);
 	}
@@ -963,7 +970,7 @@ void ModelWidget::printModel(QPrinter *printer, bool print_grid, bool print_page
 {
 	if(printer)
 	{
-		bool show_grid, align_objs, show_delims;
+		bool show_grid, align_objs, show_delims, compact_mode=scene->isCompactMode();
 		unsigned page_cnt, page, h_page_cnt, v_page_cnt, h_pg_id, v_pg_id;
 		vector<QRectF> pages;
 		QRectF margins;
@@ -981,6 +988,10 @@ void ModelWidget::printModel(QPrinter *printer, bool print_grid, bool print_page
 		//Reconfigure the grid options based upon the passed settings
 		ObjectsScene::setGridOptions(print_grid, align_objs, false);
 
+		//The objects must be printed with all their details
+		scene->setCompactMode(false);
+		scene->configurePendingItems(true);
+
 		scene->update();
 		scene->clearSelection();
 
@@ -1097,6 +1108,7 @@ void ModelWidget::printModel(QPrinter *printer, bool print_grid, bool print_page
 
 		//Restore the grid option backup
 		ObjectsScene::setGridOptions(show_grid, align_objs, show_delims);
+		scene->setCompactMode(compact_mode);
 		scene->update();
 	}
 }
@@ -1637,6 +1649,8 @@ void ModelWidget::protectObject(void)
 
 				this->selected_objects[0]->setProtected(!this->selected_objects[0]->isProtected());
 			}
+
+			db_model->notifyObjectModified(this->selected_objects[0]);
 		}
 		//Protects the whole model if there is no selected object
 		else if(this->selected_objects.empty())
@@ -1676,6 +1690,7 @@ void ModelWidget::protectObject(void)
 				}
 
 				object->setProtected(protect);
+				db_model->notifyObjectModified(object);
 			}
 		}
 
@@ -178,106 +178,109 @@ void ObjectFinderWidget::updateObjectTable(QTableWidget *tab_wgt, vector<BaseObj
 {
 	if(tab_wgt && tab_wgt->columnCount()!=0)
 	{
-		unsigned lin_idx, i;
-		QTableWidgetItem *tab_item=nullptr;
-		BaseObject *parent_obj=nullptr;
-		QFont fnt;
-		QString str_aux;
+		unsigned i;
 
 		while(tab_wgt->rowCount() > 0)
 			tab_wgt->removeRow(0);
 
 		tab_wgt->setSortingEnabled(false);
+		tab_wgt->setRowCount(objs.size());
 
-		for(lin_idx=0, i=0; i < objs.size(); i++)
-		{
-			if(objs[i]->getObjectType()==BASE_RELATIONSHIP)
-				str_aux="tv";
-			else
-				str_aux.clear();
+		for(i=0; i < objs.size(); i++)
+			updateObjectTableRow(tab_wgt, i, objs[i]);
 
-			//First column: Object name
-			tab_wgt->insertRow(lin_idx);		
-			tab_item=new QTableWidgetItem;
-			tab_item->setData(Qt::UserRole, QVariant::fromValue<void *>(reinterpret_cast<void *>(objs[i])));
-			fnt=tab_item->font();
+		tab_wgt->setSortingEnabled(true);
+	}
+}
 
-			tab_item->setText(Utf8String::create(objs[i]->getName()));
-			tab_item->setIcon(QPixmap(QString(":/icones/icones/") +
-																BaseObject::getSchemaName(objs[i]->getObjectType()) + str_aux + QString(".png")));
-			tab_wgt->setItem(lin_idx, 0, tab_item);
+void ObjectFinderWidget::updateObjectTableRow(QTableWidget *tab_wgt, int lin_idx, BaseObject *object)
+{
+	if(tab_wgt && object && lin_idx >= 0 && lin_idx < tab_wgt->rowCount())
+	{
+		QTableWidgetItem *tab_item=nullptr;
+		BaseObject *parent_obj=nullptr;
+		QFont fnt;
+		QString str_aux;
 
-			if(objs[i]->isProtected() || objs[i]->isSystemObject())
-			{
-				fnt.setItalic(true);
-				tab_item->setForeground(BaseObjectView::getFontStyle(ParsersAttributes::PROT_COLUMN).foreground());
-			}
-			else if(dynamic_cast<TableObject *>(objs[i]) &&
-							dynamic_cast<TableObject *>(objs[i])->isAddedByRelationship())
-			{
-				fnt.setItalic(true);
-				tab_item->setForeground(BaseObjectView::getFontStyle(ParsersAttributes::INH_COLUMN).foreground());
-			}
+		if(object->getObjectType()==BASE_RELATIONSHIP)
+			str_aux="tv";
 
-			fnt.setStrikeOut(objs[i]->isSQLDisabled() && !objs[i]->isSystemObject());
-			tab_item->setFont(fnt);
-			fnt.setStrikeOut(false);
+		//First column: Object name
+		tab_item=new QTableWidgetItem;
+		tab_item->setData(Qt::UserRole, QVariant::fromValue<void *>(reinterpret_cast<void *>(object)));
+		fnt=tab_item->font();
 
-			//Second column: Object type
-			if(tab_wgt->columnCount() > 1)
-			{
-				fnt.setItalic(true);
-				tab_item=new QTableWidgetItem;
-				tab_item->setFont(fnt);
-				tab_item->setText(objs[i]->getTypeName());
-				tab_wgt->setItem(lin_idx, 1, tab_item);
-			}
+		tab_item->setText(Utf8String::create(object->getName()));
+		tab_item->setIcon(QPixmap(QString(":/icones/icones/") +
+															BaseObject::getSchemaName(object->getObjectType()) + str_aux + QString(".png")));
+		tab_wgt->setItem(lin_idx, 0, tab_item);
 
-			//Third column: Parent object name
-			if(tab_wgt->columnCount() > 2)
-			{
-				tab_item=new QTableWidgetItem;
+		if(object->isProtected() || object->isSystemObject())
+		{
+			fnt.setItalic(true);
+			tab_item->setForeground(BaseObjectView::getFontStyle(ParsersAttributes::PROT_COLUMN).foreground());
+		}
+		else if(dynamic_cast<TableObject *>(object) &&
+						dynamic_cast<TableObject *>(object)->isAddedByRelationship())
+		{
+			fnt.setItalic(true);
+			tab_item->setForeground(BaseObjectView::getFontStyle(ParsersAttributes::INH_COLUMN).foreground());
+		}
+
+		fnt.setStrikeOut(object->isSQLDisabled() && !object->isSystemObject());
+		tab_item->setFont(fnt);
+		fnt.setStrikeOut(false);
 
-				if(dynamic_cast<TableObject *>(objs[i]))
-					parent_obj=dynamic_cast<TableObject *>(objs[i])->getParentTable();
-				else if(objs[i]->getSchema())
-					parent_obj=objs[i]->getSchema();
-				else if(dynamic_cast<Permission *>(objs[i]))
-					parent_obj=dynamic_cast<Permission *>(objs[i])->getObject();
-				else
-					parent_obj=objs[i]->getDatabase();
+		//Second column: Object type
+		if(tab_wgt->columnCount() > 1)
+		{
+			fnt.setItalic(true);
+			tab_item=new QTableWidgetItem;
+			tab_item->setFont(fnt);
+			tab_item->setText(object->getTypeName());
+			tab_wgt->setItem(lin_idx, 1, tab_item);
+		}
 
-				tab_item->setText(parent_obj ? Utf8String::create(parent_obj->getName()) : "-");
-				tab_wgt->setItem(lin_idx, 2, tab_item);
+		//Third column: Parent object name
+		if(tab_wgt->columnCount() > 2)
+		{
+			tab_item=new QTableWidgetItem;
 
-				if(parent_obj)
+			if(dynamic_cast<TableObject *>(object))
+				parent_obj=dynamic_cast<TableObject *>(object)->getParentTable();
+			else if(object->getSchema())
+				parent_obj=object->getSchema();
+			else if(dynamic_cast<Permission *>(object))
+				parent_obj=dynamic_cast<Permission *>(object)->getObject();
+			else
+				parent_obj=object->getDatabase();
+
+			tab_item->setText(parent_obj ? Utf8String::create(parent_obj->getName()) : "-");
+			tab_wgt->setItem(lin_idx, 2, tab_item);
+
+			if(parent_obj)
+			{
+				if(parent_obj->isProtected() || parent_obj->isSystemObject())
 				{
-					if(parent_obj->isProtected() || parent_obj->isSystemObject())
-					{
-						fnt.setItalic(true);
-						tab_item->setFont(fnt);
-						tab_item->setForeground(BaseObjectView::getFontStyle(ParsersAttributes::PROT_COLUMN).foreground());
-					}
-
-					tab_item->setIcon(QPixmap(QString(":/icones/icones/") +
-																		BaseObject::getSchemaName(parent_obj->getObjectType())+ QString(".png")));
+					fnt.setItalic(true);
+					tab_item->setFont(fnt);
+					tab_item->setForeground(BaseObjectView::getFontStyle(ParsersAttributes::PROT_COLUMN).foreground());
 				}
-			}
 
-			//Fourth column: Parent object type
-			if(tab_wgt->columnCount() > 3)
-			{
-				tab_item=new QTableWidgetItem;
-				fnt.setItalic(true);
-				tab_item->setFont(fnt);
-				tab_item->setText(parent_obj ? parent_obj->getTypeName() : "-");
-				tab_wgt->setItem(lin_idx, 3, tab_item);
+				tab_item->setIcon(QPixmap(QString(":/icones/icones/") +
+																	BaseObject::getSchemaName(parent_obj->getObjectType())+ QString(".png")));
 			}
-
-			lin_idx++;
 		}
 
-		tab_wgt->setSortingEnabled(true);
+		//Fourth column: Parent object type
+		if(tab_wgt->columnCount() > 3)
+		{
+			tab_item=new QTableWidgetItem;
+			fnt.setItalic(true);
+			tab_item->setFont(fnt);
+			tab_item->setText(parent_obj ? parent_obj->getTypeName() : "-");
+			tab_wgt->setItem(lin_idx, 3, tab_item);
+		}
 	}
 }
 
@@ -54,6 +54,10 @@ class ObjectFinderWidget : public QWidget, public Ui::ObjectFinderWidget {
 		/*! \brief Lists the objects of a vector in a QTableWidget. Any row of table contains the
 		reference to the object on the first column */
 		static void updateObjectTable(QTableWidget *tab_wgt, vector<BaseObject *> &objects);
+
+		/*! \brief Fills the row 'lin_idx' of the table with the attributes of the specified object replacing
+		the items currently in that row. The row must already exist in the table */
+		static void updateObjectTableRow(QTableWidget *tab_wgt, int lin_idx, BaseObject *object);
 		
 		//! \brief Sets the database model to work on
 		void setModel(ModelWidget *model_wgt);
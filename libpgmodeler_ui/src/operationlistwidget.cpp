@@ -63,6 +63,7 @@ void OperationListWidget::updateOperationList(void)
 		operations_tw->clear();
 		op_count_lbl->setText("-");
 		current_pos_lbl->setText("-");
+		mem_usage_lbl->setText("-");
 	}
 	else
 	{
@@ -75,6 +76,7 @@ void OperationListWidget::updateOperationList(void)
 
 		op_count_lbl->setText(QString("%1").arg(model_wgt->op_list->getCurrentSize()));
 		current_pos_lbl->setText(QString("%1").arg(model_wgt->op_list->getCurrentIndex()));
+		mem_usage_lbl->setText(QString("%1 KB").arg(model_wgt->op_list->getMemoryUsage()/1024.0f, 0, 'f', 1));
 		redo_tb->setEnabled(model_wgt->op_list->isRedoAvailable());
 		undo_tb->setEnabled(model_wgt->op_list->isUndoAvailable());
 
@@ -145,7 +145,10 @@ void PermissionWidget::hideEvent(QHideEvent *event)
 	permissions_tab->blockSignals(false);
 
 	if(perms_changed)
+	{
+		model->notifyObjectModified(object);
 		emit s_objectManipulated();
+	}
 
 	BaseObjectWidget::hideEvent(event);
 }
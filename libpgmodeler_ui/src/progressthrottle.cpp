@@ -0,0 +1,53 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2014 - Raphael Araújo e Silva <rkhaotix@gmail.com>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "progressthrottle.h"
+
+ProgressThrottle::ProgressThrottle(unsigned max_rate)
+{
+	setMaxRate(max_rate);
+	coalesced_count=0;
+}
+
+void ProgressThrottle::setMaxRate(unsigned max_rate)
+{
+	min_interval=(max_rate > 0 ? 1000/max_rate : 0);
+}
+
+bool ProgressThrottle::isEmitAllowed(void)
+{
+	if(!timer.isValid() || timer.elapsed() >= static_cast<qint64>(min_interval))
+	{
+		timer.start();
+		return(true);
+	}
+
+	coalesced_count++;
+	return(false);
+}
+
+void ProgressThrottle::reset(void)
+{
+	timer.invalidate();
+	coalesced_count=0;
+}
+
+unsigned ProgressThrottle::getCoalescedCount(void)
+{
+	return(coalesced_count);
+}
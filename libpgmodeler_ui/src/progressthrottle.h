@@ -0,0 +1,63 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2014 - Raphael Araújo e Silva <rkhaotix@gmail.com>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libpgmodeler_ui
+\class ProgressThrottle
+\brief Limits the rate in which the progress signals of long running helpers (import, validation) are emitted.
+Instead of pausing the worker thread between the processed objects (giving the GUI time to handle the queued
+signals) the helpers ask the throttle whether an event can be emitted and the remaining events are coalesced.
+*/
+
+#ifndef PROGRESS_THROTTLE_H
+#define PROGRESS_THROTTLE_H
+
+#include <QElapsedTimer>
+
+class ProgressThrottle {
+	private:
+		//! \brief Measures the time elapsed since the last emitted event
+		QElapsedTimer timer;
+
+		//! \brief Minimum interval (in ms) between two emitted events
+		unsigned min_interval,
+
+		//! \brief Amount of events discarded since the last reset
+		coalesced_count;
+
+	public:
+		//! \brief Default maximum amount of events emitted per second
+		static const unsigned DEF_MAX_RATE=20;
+
+		ProgressThrottle(unsigned max_rate=DEF_MAX_RATE);
+
+		//! \brief Defines the maximum amount of events emitted per second (zero disables the throttling)
+		void setMaxRate(unsigned max_rate);
+
+		/*! \brief Returns if an event can be emitted at the moment. When the interval since the last
+		emitted event is too short the event is counted as coalesced and false is returned */
+		bool isEmitAllowed(void);
+
+		//! \brief Resets the coalesced events counter and allows the next event to be emitted
+		void reset(void);
+
+		//! \brief Returns the amount of events coalesced since the last reset
+		unsigned getCoalescedCount(void);
+};
+
+#endif
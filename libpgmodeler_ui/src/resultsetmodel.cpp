@@ -0,0 +1,211 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2014 - Raphael Araújo e Silva <rkhaotix@gmail.com>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "resultsetmodel.h"
+#include <algorithm>
+
+const QString ResultSetModel::CURSOR_NAME="pgmodeler_sqltool_cursor";
+
+ResultSetModel::ResultSetModel(QObject *parent) : QAbstractTableModel(parent)
+{
+	row_count=0;
+	cursor_conn=nullptr;
+	end_trans=true;
+}
+
+ResultSetModel::~ResultSetModel(void)
+{
+	clear();
+}
+
+void ResultSetModel::clear(void)
+{
+	beginResetModel();
+
+	closeCursor();
+
+	for(auto res : res_pages)
+		delete(res);
+
+	res_pages.clear();
+	page_start_rows.clear();
+	col_names.clear();
+	binary_cols.clear();
+	row_count=0;
+
+	endResetModel();
+}
+
+void ResultSetModel::closeCursor(void)
+{
+	if(cursor_conn)
+	{
+		try
+		{
+			//Finishing the transaction also closes the cursor
+			if(cursor_conn->isStablished() && end_trans)
+				cursor_conn->executeDDLCommand("COMMIT");
+			//The user's transaction is kept open
+			else if(cursor_conn->isStablished())
+				cursor_conn->executeDDLCommand(QString("CLOSE %1").arg(CURSOR_NAME));
+		}
+		catch(Exception &)
+		{}
+
+		cursor_conn=nullptr;
+	}
+}
+
+void ResultSetModel::setResultSet(ResultSet &res, Connection *cursor_conn, bool end_trans)
+{
+	int col_cnt=0;
+
+	clear();
+	this->cursor_conn=cursor_conn;
+	this->end_trans=end_trans;
+
+	if(!res.isEmpty())
+	{
+		beginResetModel();
+
+		col_cnt=res.getColumnCount();
+		for(int col=0; col < col_cnt; col++)
+		{
+			col_names.push_back(res.getColumnName(col));
+			binary_cols.push_back(res.isColumnBinaryFormat(col));
+		}
+
+		endResetModel();
+	}
+
+	//A first page smaller than the fetch size means that the cursor is already exhausted
+	if(res.isEmpty() || res.getTupleCount() < FETCH_SIZE)
+		closeCursor();
+
+	if(!res.isEmpty())
+		appendResultSet(res);
+}
+
+void ResultSetModel::appendResultSet(ResultSet &res)
+{
+	int tup_cnt=res.getTupleCount();
+	ResultSet *page=nullptr;
+
+	if(tup_cnt > 0)
+	{
+		page=new ResultSet;
+		(*page)=res;
+
+		beginInsertRows(QModelIndex(), row_count, row_count + tup_cnt - 1);
+		res_pages.push_back(page);
+		page_start_rows.push_back(row_count);
+		row_count+=tup_cnt;
+		endInsertRows();
+	}
+
+	emit s_rowsFetched(row_count, hasPendingRows());
+}
+
+bool ResultSetModel::hasPendingRows(void) const
+{
+	return(cursor_conn!=nullptr);
+}
+
+void ResultSetModel::fetchAll(void)
+{
+	while(hasPendingRows())
+		fetchMore(QModelIndex());
+}
+
+bool ResultSetModel::canFetchMore(const QModelIndex &parent) const
+{
+	return(!parent.isValid() && hasPendingRows());
+}
+
+void ResultSetModel::fetchMore(const QModelIndex &parent)
+{
+	if(!parent.isValid() && cursor_conn)
+	{
+		try
+		{
+			ResultSet res;
+
+			cursor_conn->executeDMLCommand(QString("FETCH %1 FROM %2").arg(FETCH_SIZE).arg(CURSOR_NAME), res);
+
+			if(res.getTupleCount() < FETCH_SIZE)
+				closeCursor();
+
+			appendResultSet(res);
+		}
+		catch(Exception &e)
+		{
+			closeCursor();
+			emit s_fetchFailed(e.getErrorMessage());
+		}
+	}
+}
+
+QString ResultSetModel::getValue(int row, int col) const
+{
+	vector<int>::const_iterator itr;
+	ResultSet *page=nullptr;
+	int page_idx;
+
+	if(row < 0 || row >= row_count || col < 0 || col >= col_names.size())
+		return("");
+
+	//Locating the page that contains the row
+	itr=upper_bound(page_start_rows.begin(), page_start_rows.end(), row);
+	page_idx=(itr - page_start_rows.begin()) - 1;
+	page=res_pages[page_idx];
+
+	if(binary_cols[col])
+		return(trUtf8("[binary data]"));
+
+	page->seekTuple(row - page_start_rows[page_idx]);
+	return(QString(page->getColumnValue(col)));
+}
+
+int ResultSetModel::rowCount(const QModelIndex &parent) const
+{
+	return(parent.isValid() ? 0 : row_count);
+}
+
+int ResultSetModel::columnCount(const QModelIndex &parent) const
+{
+	return(parent.isValid() ? 0 : col_names.size());
+}
+
+QVariant ResultSetModel::data(const QModelIndex &index, int role) const
+{
+	if(!index.isValid() || (role!=Qt::DisplayRole && role!=Qt::ToolTipRole))
+		return(QVariant());
+
+	return(getValue(index.row(), index.column()));
+}
+
+QVariant ResultSetModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if(role!=Qt::DisplayRole)
+		return(QVariant());
+
+	if(orientation==Qt::Horizontal)
+		return(section < col_names.size() ? col_names[section] : QVariant());
+	else
+		return(section + 1);
+}
@@ -0,0 +1,113 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2014 - Raphael Araújo e Silva <rkhaotix@gmail.com>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libpgmodeler_ui
+\class ResultSetModel
+\brief Implements a table model that exposes the tuples of result sets to the views without copying them.
+The tuples can be retrieved in pages from a server-side cursor as the view requests more rows (e.g. on scroll).
+*/
+
+#ifndef RESULT_SET_MODEL_H
+#define RESULT_SET_MODEL_H
+
+#include <QAbstractTableModel>
+#include <QStringList>
+#include <vector>
+#include "connection.h"
+
+using namespace std;
+
+class ResultSetModel: public QAbstractTableModel {
+	private:
+		Q_OBJECT
+
+		//! \brief Result sets (pages) that holds the tuples retrieved until the moment
+		vector<ResultSet *> res_pages;
+
+		//! \brief Index of the first row of each page
+		vector<int> page_start_rows;
+
+		//! \brief Names of the columns of the result
+		QStringList col_names;
+
+		//! \brief Indicates the columns which values are binary data
+		vector<bool> binary_cols;
+
+		//! \brief Amount of rows retrieved until the moment
+		int row_count;
+
+		//! \brief Connection in which the cursor used to fetch the remaining rows was declared
+		Connection *cursor_conn;
+
+		/*! \brief Indicates that the transaction where the cursor was declared must be finished when closing
+		the cursor. When false the transaction belongs to the user and only the cursor is closed */
+		bool end_trans;
+
+		//! \brief Appends the tuples of the result set as a new page (the result set is moved to the model)
+		void appendResultSet(ResultSet &res);
+
+		/*! \brief Closes the cursor. The transaction where it was declared is finished too when it was
+		started only to declare the cursor */
+		void closeCursor(void);
+
+	public:
+		//! \brief Name of the cursor declared on the connection to fetch the rows on demand
+		static const QString CURSOR_NAME;
+
+		//! \brief Amount of rows retrieved at once from the cursor
+		static const int FETCH_SIZE=1000;
+
+		ResultSetModel(QObject *parent=0);
+		~ResultSetModel(void);
+
+		/*! \brief Configures the model from the result set (which is moved to the model). When 'cursor_conn' is specified
+		the result is considered the first page of the cursor CURSOR_NAME (declared in an open transaction on that
+		connection) and the remaining rows are fetched as needed by the views. The cursor is closed when it's exhausted
+		or the model is cleared. The 'end_trans' parameter indicates that the transaction must be finished at that moment
+		(it was started only to declare the cursor) */
+		void setResultSet(ResultSet &res, Connection *cursor_conn=nullptr, bool end_trans=true);
+
+		//! \brief Removes all the pages and closes the cursor if there is one open
+		void clear(void);
+
+		//! \brief Returns if there are rows to be fetched from the cursor
+		bool hasPendingRows(void) const;
+
+		//! \brief Fetches all the remaining rows from the cursor
+		void fetchAll(void);
+
+		//! \brief Returns the value of the specified cell as text
+		QString getValue(int row, int col) const;
+
+		int rowCount(const QModelIndex &parent=QModelIndex()) const;
+		int columnCount(const QModelIndex &parent=QModelIndex()) const;
+		QVariant data(const QModelIndex &index, int role=Qt::DisplayRole) const;
+		QVariant headerData(int section, Qt::Orientation orientation, int role=Qt::DisplayRole) const;
+		bool canFetchMore(const QModelIndex &parent) const;
+		void fetchMore(const QModelIndex &parent);
+
+	signals:
+		//! \brief Signal emitted when new rows are retrieved from the cursor
+		void s_rowsFetched(int row_count, bool pending_rows);
+
+		//! \brief Signal emitted when an error occurs while fetching rows from the cursor
+		void s_fetchFailed(QString error_msg);
+};
+
+#endif
@@ -0,0 +1,162 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2014 - Raphael Araújo e Silva <rkhaotix@gmail.com>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "sqlexecutionthread.h"
+#include "resultsetmodel.h"
+
+const QString SQLExecutionThread::SAVEPOINT_NAME="pgmodeler_sqltool_savepoint";
+
+SQLExecutionThread::SQLExecutionThread(QObject *parent) : QThread(parent)
+{
+	connection=nullptr;
+	use_cursor=trans_started=false;
+	cancelled.store(0);
+	error_type=ERR_CUSTOM;
+}
+
+void SQLExecutionThread::setCommand(Connection *conn, const QString &cmd)
+{
+	if(this->isRunning())
+		return;
+
+	connection=conn;
+	command=cmd.trimmed();
+	trans_started=false;
+	cancelled.store(0);
+	error_msg.clear();
+
+	//Removing the trailing semicolons since the command will be part of the cursor declaration
+	while(command.endsWith(';'))
+	{
+		command.chop(1);
+		command=command.trimmed();
+	}
+
+	use_cursor=isCursorCompatible(command);
+}
+
+bool SQLExecutionThread::isCursorCompatible(const QString &cmd)
+{
+	QString aux_cmd=cmd.trimmed();
+
+	while(aux_cmd.endsWith(';'))
+	{
+		aux_cmd.chop(1);
+		aux_cmd=aux_cmd.trimmed();
+	}
+
+	/* Commands with more than one statement (or semicolons inside literals) are executed as is.
+	SELECT ... INTO creates a table so it can't be declared as a cursor */
+	return(!aux_cmd.contains(';') &&
+				 aux_cmd.contains(QRegExp("^(select|values|table)(\\s|\\()", Qt::CaseInsensitive)) &&
+				 !aux_cmd.contains(QRegExp("\\binto\\b", Qt::CaseInsensitive)));
+}
+
+void SQLExecutionThread::cancel(void)
+{
+	if(this->isRunning() && connection)
+	{
+		cancelled.store(1);
+		connection->cancelCommand();
+	}
+}
+
+bool SQLExecutionThread::isCursorUsed(void)
+{
+	return(use_cursor);
+}
+
+bool SQLExecutionThread::isTransactionStarted(void)
+{
+	return(trans_started);
+}
+
+bool SQLExecutionThread::isCancelled(void)
+{
+	return(cancelled.load()!=0);
+}
+
+void SQLExecutionThread::getResult(ResultSet &res)
+{
+	res=result;
+}
+
+void SQLExecutionThread::raiseError(void)
+{
+	if(!error_msg.isEmpty())
+		throw Exception(error_msg, error_type, __PRETTY_FUNCTION__,__FILE__,__LINE__);
+}
+
+void SQLExecutionThread::run(void)
+{
+	if(!connection)
+		return;
+
+	try
+	{
+		if(use_cursor)
+		{
+			/* Inside a transaction opened by the user the cursor is declared under a savepoint so an error
+			(or a cancellation) doesn't abort the user's transaction. Otherwise a new transaction is started */
+			trans_started=!connection->isTransactionOpen();
+
+			if(trans_started)
+				connection->executeDDLCommand("BEGIN");
+			else
+				connection->executeDDLCommand(QString("SAVEPOINT %1").arg(SAVEPOINT_NAME));
+
+			try
+			{
+				connection->executeDDLCommand(QString("DECLARE %1 NO SCROLL CURSOR FOR %2").arg(ResultSetModel::CURSOR_NAME).arg(command));
+				connection->executeDMLCommand(QString("FETCH %1 FROM %2").arg(ResultSetModel::FETCH_SIZE).arg(ResultSetModel::CURSOR_NAME), result);
+
+				//Releasing the savepoint keeps the cursor open on the user's transaction
+				if(!trans_started)
+					connection->executeDDLCommand(QString("RELEASE SAVEPOINT %1").arg(SAVEPOINT_NAME));
+			}
+			catch(Exception &e)
+			{
+				try
+				{
+					if(trans_started)
+						connection->executeDDLCommand("ROLLBACK");
+					else
+					{
+						connection->executeDDLCommand(QString("ROLLBACK TO SAVEPOINT %1").arg(SAVEPOINT_NAME));
+						connection->executeDDLCommand(QString("RELEASE SAVEPOINT %1").arg(SAVEPOINT_NAME));
+					}
+				}
+				catch(Exception &)
+				{}
+
+				trans_started=false;
+
+				/* Only queries are executed through cursors so the error is the same the command would raise
+				if executed directly, thus it isn't executed again */
+				throw Exception(e.getErrorMessage(), e.getErrorType(), __PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+			}
+		}
+		else
+			connection->executeDMLCommand(command, result);
+	}
+	catch(Exception &e)
+	{
+		error_msg=e.getErrorMessage();
+		error_type=e.getErrorType();
+	}
+}
@@ -0,0 +1,100 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2014 - Raphael Araújo e Silva <rkhaotix@gmail.com>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libpgmodeler_ui
+\class SQLExecutionThread
+\brief Implements a thread that runs a SQL command on a connection keeping the user interface responsive,
+so the command can be cancelled while it's running. Queries are executed through a server-side cursor
+(see ResultSetModel) so only the first rows are retrieved. When the connection has a transaction opened by
+the user the cursor is declared inside it (under a savepoint) instead of starting a new transaction.
+*/
+
+#ifndef SQL_EXECUTION_THREAD_H
+#define SQL_EXECUTION_THREAD_H
+
+#include <QThread>
+#include <QAtomicInt>
+#include "connection.h"
+
+class SQLExecutionThread: public QThread {
+	private:
+		Q_OBJECT
+
+		//! \brief Connection in which the command is executed
+		Connection *connection;
+
+		//! \brief Command to be executed
+		QString command;
+
+		//! \brief Result of the command
+		ResultSet result;
+
+		//! \brief Indicates if the command was executed through a cursor
+		bool use_cursor,
+
+		/*! \brief Indicates that the transaction where the cursor was declared was started by the thread.
+		When false the cursor lives in a transaction opened by the user */
+		trans_started;
+
+		//! \brief Indicates that the user requested the cancellation of the command (set from other threads)
+		QAtomicInt cancelled;
+
+		//! \brief Error raised by the command execution
+		QString error_msg;
+		ErrorType error_type;
+
+	public:
+		SQLExecutionThread(QObject *parent=0);
+
+		//! \brief Name of the savepoint used to declare the cursor inside a transaction opened by the user
+		static const QString SAVEPOINT_NAME;
+
+		/*! \brief Configures the command to be executed on the connection. Single SELECT, VALUES and TABLE
+		commands are executed through a cursor in an open transaction */
+		void setCommand(Connection *conn, const QString &cmd);
+
+		//! \brief Sends a cancel request for the running command
+		void cancel(void);
+
+		//! \brief Returns if the last command was executed through a cursor
+		bool isCursorUsed(void);
+
+		/*! \brief Returns if the transaction where the cursor was declared was started by the thread, this is,
+		it must be finished when the cursor is closed */
+		bool isTransactionStarted(void);
+
+		//! \brief Returns if the user requested the cancellation of the last command
+		bool isCancelled(void);
+
+		//! \brief Returns the result of the last command. The result set is moved to the parameter
+		void getResult(ResultSet &res);
+
+		/*! \brief Raises the error generated by the last command execution (if any). This method
+		must be called from the thread that will handle the exception */
+		void raiseError(void);
+
+		/*! \brief Returns if the command can be executed via cursor, this is, it's a single
+		SELECT, VALUES or TABLE command */
+		static bool isCursorCompatible(const QString &cmd);
+
+	protected:
+		void run(void) override;
+};
+
+#endif
@@ -31,6 +31,9 @@ SQLToolWidget::SQLToolWidget(QWidget * parent) : QWidget(parent)
                                 GlobalAttributes::SQL_HIGHLIGHT_CONF +
                                 GlobalAttributes::CONFIGURATION_EXT);
 
+  results_model=new ResultSetModel(this);
+  results_tbw->setModel(results_model);
+
   h_splitter->setSizes({0, 10000});
   h_splitter1->setSizes({1000, 250});
   results_parent->setVisible(false);
@@ -72,7 +75,11 @@ SQLToolWidget::SQLToolWidget(QWidget * parent) : QWidget(parent)
   connect(load_tb, SIGNAL(clicked(void)), this, SLOT(loadCommands(void)));
   connect(export_tb, SIGNAL(clicked(void)), this, SLOT(exportResults(void)));
   connect(history_tb, SIGNAL(toggled(bool)), cmd_history_gb, SLOT(setVisible(bool)));
-  connect(results_tbw, SIGNAL(itemPressed(QTableWidgetItem*)), this, SLOT(copySelection(void)));
+  connect(results_tbw, SIGNAL(pressed(QModelIndex)), this, SLOT(copySelection(void)));
+  connect(cancel_sql_tb, SIGNAL(clicked(void)), this, SLOT(cancelSQLCommand(void)));
+  connect(&sql_exec_thread, SIGNAL(finished(void)), this, SLOT(handleSQLCommandResult(void)));
+  connect(results_model, SIGNAL(s_rowsFetched(int,bool)), this, SLOT(updateRowCount(int,bool)));
+  connect(results_model, SIGNAL(s_fetchFailed(QString)), this, SLOT(showFetchError(QString)));
   connect(objects_trw, SIGNAL(itemPressed(QTreeWidgetItem*,int)), this, SLOT(handleObject(QTreeWidgetItem *,int)));
   connect(clear_history_btn, SIGNAL(clicked(void)), cmd_history_lst, SLOT(clear(void)));
   connect(hide_ext_objs_chk, SIGNAL(toggled(bool)), this, SLOT(listObjects(void)));
@@ -92,6 +99,23 @@ SQLToolWidget::SQLToolWidget(QWidget * parent) : QWidget(parent)
   objects_trw->installEventFilter(this);
 }
 
+SQLToolWidget::~SQLToolWidget(void)
+{
+  finishSQLExecution();
+}
+
+void SQLToolWidget::finishSQLExecution(void)
+{
+  if(sql_exec_thread.isRunning())
+  {
+    sql_exec_thread.cancel();
+    sql_exec_thread.wait();
+  }
+
+  //Clearing the model closes the cursor (if any) opened on the sql command connection
+  results_model->clear();
+}
+
 void SQLToolWidget::updateConnections(map<QString, Connection *> &conns)
 {
   map<QString, Connection *>::iterator itr=conns.begin();
@@ -290,48 +314,13 @@ void SQLToolWidget::enableCommandButtons(void)
   save_tb->setEnabled(run_sql_tb->isEnabled());
 }
 
-void SQLToolWidget::fillResultsTable(ResultSet &res)
+void SQLToolWidget::fillResultsTable(ResultSet &res, bool use_cursor)
 {
   try
   {
-    int col=0, row=0, row_cnt=res.getTupleCount(), col_cnt=res.getColumnCount();
-    QTableWidgetItem *item=nullptr;
-
-    row_cnt_lbl->setText(QString::number(row_cnt));
-    export_tb->setEnabled(row_cnt > 0);
-    results_tbw->setRowCount(0);
-    results_tbw->setColumnCount(col_cnt);
-
-    //Configuring the grid columns with the names of retrived table columns
-    for(col=0; col < col_cnt; col++)
-      results_tbw->setHorizontalHeaderItem(col, new QTableWidgetItem(res.getColumnName(col)));
-
-    if(res.accessTuple(ResultSet::FIRST_TUPLE))
-    {
-      results_tbw->setRowCount(row_cnt);
-
-      do
-      {
-        //Fills the current row with the values of current tuple
-        for(col=0; col < col_cnt; col++)
-        {
-          item=new QTableWidgetItem;
-
-          if(res.isColumnBinaryFormat(col))
-            item->setText(trUtf8("[binary data]"));
-          else
-            item->setText(res.getColumnValue(col));
-
-          results_tbw->setItem(row, col, item);
-        }
-
-        //Configure the vertical header to show the current tuple id
-        results_tbw->setVerticalHeaderItem(row, new QTableWidgetItem(QString::number(row + 1)));
-        row++;
-      }
-      while(res.accessTuple(ResultSet::NEXT_TUPLE));
-    }
-
+    //The rows are not copied to the grid, they are read directly from the result set as needed
+    results_model->setResultSet(res, (use_cursor ? &sql_cmd_conn : nullptr), sql_exec_thread.isTransactionStarted());
+    export_tb->setEnabled(results_model->rowCount() > 0);
     results_tbw->resizeColumnsToContents();
   }
   catch(Exception &e)
@@ -340,6 +329,20 @@ void SQLToolWidget::fillResultsTable(ResultSet &res)
   }
 }
 
+void SQLToolWidget::updateRowCount(int row_count, bool pending_rows)
+{
+  //A plus sign indicates that there are more rows to be retrieved from the server
+  row_cnt_lbl->setText(QString::number(row_count) + (pending_rows ? "+" : ""));
+}
+
+void SQLToolWidget::showFetchError(QString error_msg)
+{
+  Messagebox msg_box;
+  Exception e(error_msg, ERR_CUSTOM, __PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+  msg_box.show(e);
+}
+
 void SQLToolWidget::showError(Exception &e)
 {
   QListWidgetItem *item=new QListWidgetItem(QIcon(":/icones/icones/msgbox_erro.png"), e.getErrorMessage());
@@ -352,7 +355,7 @@ void SQLToolWidget::showError(Exception &e)
 
 bool SQLToolWidget::eventFilter(QObject *object, QEvent *event)
 {
-  if(object==objects_trw && event->type()==QEvent::KeyPress)
+  if(object==objects_trw && event->type()==QEvent::KeyPress && !sql_exec_thread.isRunning())
   {
     QKeyEvent *k_event=dynamic_cast<QKeyEvent *>(event);
 
@@ -394,23 +397,48 @@ void SQLToolWidget::registerSQLCommand(const QString &cmd)
 
 void SQLToolWidget::runSQLCommand(void)
 {
+  QString cmd=sql_cmd_txt->textCursor().selectedText();
+
+  if(sql_exec_thread.isRunning())
+    return;
+
+  if(cmd.isEmpty())
+    cmd=sql_cmd_txt->toPlainText();
+
+  //Closing the cursor of the previous command before running a new one on the same connection
+  results_model->clear();
+  registerSQLCommand(cmd);
+
+  sql_exec_thread.setCommand(&sql_cmd_conn, cmd);
+  run_sql_tb->setEnabled(false);
+  cancel_sql_tb->setEnabled(true);
+  export_tb->setEnabled(false);
+  sql_exec_thread.start();
+}
+
+void SQLToolWidget::cancelSQLCommand(void)
+{
+  sql_exec_thread.cancel();
+}
+
+void SQLToolWidget::handleSQLCommandResult(void)
+{
+  run_sql_tb->setEnabled(!sql_cmd_txt->toPlainText().isEmpty());
+  cancel_sql_tb->setEnabled(false);
+
   try
   {
     ResultSet res;
-    QString cmd=sql_cmd_txt->textCursor().selectedText();
-
-    if(cmd.isEmpty())
-      cmd=sql_cmd_txt->toPlainText();
 
-    sql_cmd_conn.executeDMLCommand(cmd, res);
-    registerSQLCommand(cmd);
+    sql_exec_thread.raiseError();
+    sql_exec_thread.getResult(res);
 
     results_parent->setVisible(!res.isEmpty());
     export_tb->setEnabled(!res.isEmpty());
     msgoutput_lst->setVisible(res.isEmpty());
 
-    if(results_tbw->isVisible())
-      fillResultsTable(res);
+    if(!res.isEmpty())
+      fillResultsTable(res, sql_exec_thread.isCursorUsed());
     else
     {
       QLabel *label=new QLabel(trUtf8("SQL command successfully executed. <em>Rows affected <strong>%1</strong></em>").arg(res.getTupleCount()));
@@ -485,7 +513,9 @@ void SQLToolWidget::exportResults(void)
                       .arg(csv_file_dlg.selectedFiles().at(0))
                       , ERR_FILE_DIR_NOT_ACCESSED ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-    file.write(generateCSVBuffer(0, 0, results_tbw->rowCount(), results_tbw->columnCount()));
+    //Retrieving the rows not fetched yet by the grid
+    results_model->fetchAll();
+    file.write(generateCSVBuffer(0, 0, results_model->rowCount(), results_model->columnCount()));
     file.close();
   }
 }
@@ -496,8 +526,8 @@ QByteArray SQLToolWidget::generateCSVBuffer(int start_row, int start_col, int ro
 
   //If the selection interval is valid
   if(start_row >=0 && start_col >=0 &&
-     start_row + row_cnt <= results_tbw->rowCount() &&
-     start_col + col_cnt <= results_tbw->columnCount())
+     start_row + row_cnt <= results_model->rowCount() &&
+     start_col + col_cnt <= results_model->columnCount())
   {
     int col=0, row=0,
         max_col=start_col + col_cnt,
@@ -506,7 +536,7 @@ QByteArray SQLToolWidget::generateCSVBuffer(int start_row, int start_col, int ro
     //Creating the header of csv
     for(col=start_col; col < max_col; col++)
     {
-      buf.append(QString("\"%1\"").arg(results_tbw->horizontalHeaderItem(col)->text()));
+      buf.append(QString("\"%1\"").arg(results_model->headerData(col, Qt::Horizontal).toString()));
       buf.append(';');
     }
 
@@ -517,7 +547,7 @@ QByteArray SQLToolWidget::generateCSVBuffer(int start_row, int start_col, int ro
     {
       for(col=start_col; col < max_col; col++)
       {
-        buf.append(QString("\"%1\"").arg(results_tbw->item(row, col)->text()));
+        buf.append(QString("\"%1\"").arg(results_model->getValue(row, col)));
         buf.append(';');
       }
 
@@ -594,6 +624,10 @@ void SQLToolWidget::dropObject(QTreeWidgetItem *item)
         drop_cmd=SchemaParser::getCodeDefinition(ParsersAttributes::DROP, attribs, SchemaParser::SQL_DEFINITION);
         drop_cmd.remove(QRegExp("^(--)"));
 
+        /* Closing the cursor of the current results (if any) otherwise the drop command would be
+           executed inside the transaction opened for it */
+        finishSQLExecution();
+
         //Executes the drop cmd
         sql_cmd_conn.executeDDLCommand(drop_cmd);
 
@@ -628,7 +662,6 @@ void SQLToolWidget::showObjectData(QTreeWidgetItem *item)
   try
   {
     QString cmd;
-    ResultSet res;
 
     cmd=QString("SELECT * FROM %1.%2;")
         .arg(BaseObject::formatName(item->data(DatabaseImportForm::OBJECT_SCHEMA, Qt::UserRole).toString()))
@@ -636,12 +669,7 @@ void SQLToolWidget::showObjectData(QTreeWidgetItem *item)
 
     registerSQLCommand(sql_cmd_txt->toPlainText());
     sql_cmd_txt->setText(cmd);
-    sql_cmd_conn.executeDMLCommand(cmd, res);
-
-    results_parent->setVisible(true);
-    msgoutput_lst->setVisible(false);
-
-    fillResultsTable(res);
+    runSQLCommand();
   }
   catch(Exception &e)
   {
@@ -659,6 +687,7 @@ void SQLToolWidget::clearAll(void)
 
   if(msg_box.result()==QDialog::Accepted)
   {
+    finishSQLExecution();
     sql_cmd_txt->setText("");
     msgoutput_lst->clear();
     msgoutput_lst->setVisible(true);
@@ -672,15 +701,15 @@ void SQLToolWidget::copySelection(void)
   {
     if(copy_menu.exec(QCursor::pos()))
     {
-      QList<QTableWidgetSelectionRange> sel_range=results_tbw->selectedRanges();
+      QItemSelection sel_range=results_tbw->selectionModel()->selection();
 
       if(!sel_range.isEmpty())
       {
-        QTableWidgetSelectionRange selection=sel_range.at(0);
+        QItemSelectionRange selection=sel_range.at(0);
 
         //Generates the csv buffer and assigns it to application's clipboard
-        QByteArray buf=generateCSVBuffer(selection.topRow(), selection.leftColumn(),
-                                         selection.rowCount(), selection.columnCount());
+        QByteArray buf=generateCSVBuffer(selection.top(), selection.left(),
+                                         selection.height(), selection.width());
         qApp->clipboard()->setText(buf);
       }
     }
@@ -689,7 +718,8 @@ void SQLToolWidget::copySelection(void)
 
 void SQLToolWidget::handleObject(QTreeWidgetItem *item, int)
 {
-  if(QApplication::mouseButtons()==Qt::RightButton)
+  //The objects can't be handled while a command is running on the connection
+  if(QApplication::mouseButtons()==Qt::RightButton && !sql_exec_thread.isRunning())
   {
     ObjectType obj_type=static_cast<ObjectType>(item->data(DatabaseImportForm::OBJECT_TYPE, Qt::UserRole).toUInt());
     unsigned obj_id=item->data(DatabaseImportForm::OBJECT_ID, Qt::UserRole).toUInt();
@@ -734,6 +764,8 @@ void SQLToolWidget::enableSQLExecution(bool enable)
     if(history_tb->isChecked() && !enable)
       history_tb->setChecked(false);
 
+    finishSQLExecution();
+
     if(enable)
       sql_cmd_conn.switchToDatabase(database_cmb->currentText());
     else if(!enable && sql_cmd_conn.isStablished())
@@ -29,6 +29,8 @@
 #include "syntaxhighlighter.h"
 #include "connection.h"
 #include "databaseimportform.h"
+#include "resultsetmodel.h"
+#include "sqlexecutionthread.h"
 
 class SQLToolWidget: public QWidget, public Ui::SQLToolWidget {
   private:
@@ -43,6 +45,12 @@ class SQLToolWidget: public QWidget, public Ui::SQLToolWidget {
     //! brief Connection used to run commands specified on sql input field
     Connection sql_cmd_conn;
 
+    //! brief Model that exposes the rows returned by the commands to the results grid
+    ResultSetModel *results_model;
+
+    //! brief Thread that runs the commands keeping the interface responsive
+    SQLExecutionThread sql_exec_thread;
+
     //! brief Dialog for SQL save/load
     QFileDialog sql_file_dlg,
 
@@ -71,8 +79,12 @@ class SQLToolWidget: public QWidget, public Ui::SQLToolWidget {
     //! brief Shows the data of the object represented by the specified item
     void showObjectData(QTreeWidgetItem *item);
 
-    //! brief Fills up the results grid based upon the specified result set
-    void fillResultsTable(ResultSet &res);
+    /*! brief Fills up the results grid based upon the specified result set. When 'use_cursor' is true
+        the result is the first page of the cursor opened on the sql command connection */
+    void fillResultsTable(ResultSet &res, bool use_cursor=false);
+
+    //! brief Waits the running command (if any) to finish and clears the results grid
+    void finishSQLExecution(void);
 
     //! brief Stores the command on the sql command history
     void registerSQLCommand(const QString &cmd);
@@ -83,6 +95,7 @@ class SQLToolWidget: public QWidget, public Ui::SQLToolWidget {
 
   public:
     SQLToolWidget(QWidget * parent = 0);
+    ~SQLToolWidget(void);
 
     //! \brief Updates the connections combo
     void updateConnections(map<QString, Connection *> &conns);
@@ -106,6 +119,18 @@ class SQLToolWidget: public QWidget, public Ui::SQLToolWidget {
     //! brief Runs the current typed sql command
     void runSQLCommand(void);
 
+    //! brief Shows the result of the command executed by the sql execution thread
+    void handleSQLCommandResult(void);
+
+    //! brief Cancels the command currently running
+    void cancelSQLCommand(void);
+
+    //! brief Updates the amount of rows retrieved by the results grid
+    void updateRowCount(int row_count, bool pending_rows);
+
+    //! brief Shows the error raised while fetching rows to the results grid
+    void showFetchError(QString error_msg);
+
     //! brief Save the current typed sql command on a file
     void saveCommands(void);
 
@@ -37,11 +37,12 @@ ValidationInfo::ValidationInfo(unsigned val_type, BaseObject *object, vector<Bas
  this->references=references;
 }
 
-ValidationInfo::ValidationInfo(Exception e)
+ValidationInfo::ValidationInfo(Exception e, BaseObject *object)
 {
 	vector<Exception> err_list;
 
 	val_type=SQL_VALIDATION_ERR;
+	this->object=object;
 	e.getExceptionsList(err_list);
 
 	while(!err_list.empty())
@@ -53,7 +53,10 @@ class ValidationInfo {
 		ValidationInfo(void);
 		ValidationInfo(unsigned val_type, BaseObject *object, vector<BaseObject *> references);
 		ValidationInfo(const QString &msg);
-		ValidationInfo(Exception e);
+
+		/*! \brief Creates a SQL validation info from the errors of the exception. The object
+		is the one that generated the failing command (when it can be identified) */
+		ValidationInfo(Exception e, BaseObject *object=nullptr);
 
 		//! \brief Returns the validation type
 		unsigned getValidationType(void);
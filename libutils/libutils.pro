@@ -6,8 +6,10 @@ TARGET = utils
 
 HEADERS += src/exception.h \
 	   src/globalattributes.h \
-	   src/utf8string.h
+	   src/utf8string.h \
+	   src/dependencygraph.h
 
-SOURCES += src/exception.cpp
+SOURCES += src/exception.cpp \
+	   src/dependencygraph.cpp
 
 LIBS -=
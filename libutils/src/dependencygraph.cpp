@@ -0,0 +1,181 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2014 - Raphael Araújo e Silva <rkhaotix@gmail.com>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "dependencygraph.h"
+#include <algorithm>
+#include <queue>
+#include <functional>
+
+DependencyGraph::DependencyGraph(unsigned item_count)
+{
+	reset(item_count);
+}
+
+void DependencyGraph::reset(unsigned item_count)
+{
+	deps.clear();
+	deps.resize(item_count);
+	next_idx=0;
+}
+
+unsigned DependencyGraph::getItemCount(void)
+{
+	return(deps.size());
+}
+
+void DependencyGraph::addDependency(unsigned item, unsigned dep_item)
+{
+	if(item >= deps.size() || dep_item >= deps.size())
+		throw Exception(ERR_REF_ELEM_INV_INDEX,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	if(item!=dep_item)
+		deps[item].push_back(dep_item);
+}
+
+void DependencyGraph::visit(unsigned root)
+{
+	//Each entry holds an item being visited and the position of the next dependency to be visited
+	vector<pair<unsigned, unsigned> > visiting;
+	vector<unsigned> component;
+	unsigned item, dep_item, comp_item;
+
+	visit_idxs[root]=low_idxs[root]=next_idx++;
+	stack.push_back(root);
+	stacked[root]=true;
+	visiting.push_back(make_pair(root, 0u));
+
+	while(!visiting.empty())
+	{
+		item=visiting.back().first;
+
+		if(visiting.back().second < deps[item].size())
+		{
+			dep_item=deps[item][visiting.back().second++];
+
+			if(visit_idxs[dep_item] < 0)
+			{
+				visit_idxs[dep_item]=low_idxs[dep_item]=next_idx++;
+				stack.push_back(dep_item);
+				stacked[dep_item]=true;
+				visiting.push_back(make_pair(dep_item, 0u));
+			}
+			//The dependency is on the stack so it is part of the same component (circular dependency)
+			else if(stacked[dep_item])
+				low_idxs[item]=std::min(low_idxs[item], visit_idxs[dep_item]);
+		}
+		else
+		{
+			visiting.pop_back();
+
+			//Propagating the lowest reachable visiting order to the item that depends on the finished one
+			if(!visiting.empty())
+				low_idxs[visiting.back().first]=std::min(low_idxs[visiting.back().first], low_idxs[item]);
+
+			//The item is the root of a component so the items above it on the stack form that component
+			if(low_idxs[item]==visit_idxs[item])
+			{
+				component.clear();
+
+				do
+				{
+					comp_item=stack.back();
+					stack.pop_back();
+					stacked[comp_item]=false;
+					comp_idxs[comp_item]=components.size();
+					component.push_back(comp_item);
+				}
+				while(comp_item!=item);
+
+				std::sort(component.begin(), component.end());
+				components.push_back(component);
+			}
+		}
+	}
+}
+
+void DependencyGraph::getCreationOrder(vector<unsigned> &order, vector<vector<unsigned> > &cycles)
+{
+	unsigned item, comp, count=deps.size();
+	vector<unsigned> pending_deps;
+	vector<vector<unsigned> > dependents;
+	//Components ready to be placed keyed by their lowest item so the preferred order is kept
+	priority_queue<pair<unsigned, unsigned>, vector<pair<unsigned, unsigned> >, greater<pair<unsigned, unsigned> > > ready;
+
+	order.clear();
+	cycles.clear();
+	visit_idxs.assign(count, -1);
+	low_idxs.assign(count, -1);
+	stacked.assign(count, false);
+	comp_idxs.assign(count, 0);
+	components.clear();
+	stack.clear();
+	next_idx=0;
+
+	for(item=0; item < count; item++)
+	{
+		std::sort(deps[item].begin(), deps[item].end());
+		deps[item].erase(std::unique(deps[item].begin(), deps[item].end()), deps[item].end());
+	}
+
+	//Grouping the items with circular dependencies in components
+	for(item=0; item < count; item++)
+	{
+		if(visit_idxs[item] < 0)
+			visit(item);
+	}
+
+	//Counting the dependencies between the components
+	pending_deps.assign(components.size(), 0);
+	dependents.resize(components.size());
+
+	for(item=0; item < count; item++)
+	{
+		for(auto dep_item : deps[item])
+		{
+			if(comp_idxs[dep_item]!=comp_idxs[item])
+			{
+				dependents[comp_idxs[dep_item]].push_back(comp_idxs[item]);
+				pending_deps[comp_idxs[item]]++;
+			}
+		}
+	}
+
+	for(comp=0; comp < components.size(); comp++)
+	{
+		if(pending_deps[comp]==0)
+			ready.push(make_pair(components[comp].front(), comp));
+	}
+
+	//Placing the lowest ready component at each step and releasing the components that depend on it
+	while(!ready.empty())
+	{
+		comp=ready.top().second;
+		ready.pop();
+
+		order.insert(order.end(), components[comp].begin(), components[comp].end());
+
+		if(components[comp].size() > 1)
+			cycles.push_back(components[comp]);
+
+		for(auto dep_comp : dependents[comp])
+		{
+			if(--pending_deps[dep_comp]==0)
+				ready.push(make_pair(components[dep_comp].front(), dep_comp));
+		}
+	}
+}
@@ -0,0 +1,80 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2014 - Raphael Araújo e Silva <rkhaotix@gmail.com>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libutils
+\class DependencyGraph
+\brief Computes the order in which a set of items must be created so each item comes after the items it depends on.
+The items are identified by their indexes, which also denote the preferred order of creation: at each step the lowest
+index item whose dependencies were already placed is the next one, so an item only comes before a lower index item
+when the latter depends on it (directly or not). The items that form circular dependencies are grouped in strongly
+connected components (Tarjan's algorithm), placed together (in the preferred order) and reported as cycles instead
+of making the sort to fail. Both steps avoid recursion so long dependency chains can be sorted on threads with small stacks.
+*/
+
+#ifndef DEPENDENCY_GRAPH_H
+#define DEPENDENCY_GRAPH_H
+
+#include <vector>
+#include "exception.h"
+
+using namespace std;
+
+class DependencyGraph {
+	private:
+		//! \brief Items which each item depends on
+		vector<vector<unsigned> > deps;
+
+		//! \brief Visiting order and lowest reachable visiting order of each item (-1 for items not visited yet)
+		vector<int> visit_idxs, low_idxs;
+
+		//! \brief Indicates the items stored on the stack of the component being visited
+		vector<bool> stacked;
+
+		//! \brief Items of the components being visited
+		vector<unsigned> stack;
+
+		//! \brief Visiting order of the next item
+		int next_idx;
+
+		//! \brief Component of each item and the items of each component (sorted by index)
+		vector<unsigned> comp_idxs;
+		vector<vector<unsigned> > components;
+
+		/*! \brief Visits the item and everything it depends on (using an explicit stack instead of recursion)
+		storing the completed strongly connected components */
+		void visit(unsigned item);
+
+	public:
+		DependencyGraph(unsigned item_count=0);
+
+		//! \brief Removes all the dependencies and resizes the graph to the specified amount of items
+		void reset(unsigned item_count);
+
+		//! \brief Returns the amount of items of the graph
+		unsigned getItemCount(void);
+
+		//! \brief Indicates that the item depends on 'dep_item' (the self dependencies are ignored)
+		void addDependency(unsigned item, unsigned dep_item);
+
+		/*! \brief Returns the items in creation order. The items that depend on each other (directly or not)
+		are returned in the 'cycles' list, one vector per circular dependency */
+		void getCreationOrder(vector<unsigned> &order, vector<vector<unsigned> > &cycles);
+};
+
+#endif
@@ -228,7 +228,9 @@ QString Exception::messages[ERROR_COUNT][2]={
 	{"ERR_MODEL_FILE_NOT_LOADED", QT_TR_NOOP("Could not load the database model file `%1'. Check the error stack to see details. Try to run `pgmodeler-cli --fix-model' in order to correct the structure of the file if that is the case.")},
   {"ERR_INV_COLUMN_TABLE_TYPE", QT_TR_NOOP("The column `%1' cannot reference it's parent table `%2' as data type!")},
   {"ERR_OPR_INV_ELEMENT_ID", QT_TR_NOOP("Operation with an invalid element id `%1'!")},
-  {"ERR_REF_ELEMENT_COLOR_ID", QT_TR_NOOP("Reference to an invalid color id `%1' for element `%2'!")}
+  {"ERR_REF_ELEMENT_COLOR_ID", QT_TR_NOOP("Reference to an invalid color id `%1' for element `%2'!")},
+  {"ERR_CMD_SQL_TIMEOUT", QT_TR_NOOP("The SQL command was cancelled because its execution exceeded the timeout of `%1' ms!")},
+  {"ERR_CMD_CANCEL_NOT_ANSWERED", QT_TR_NOOP("The connection was closed because the server didn't answer the cancel request of the SQL command within `%1' ms!")}
 };
 
 Exception::Exception(void)
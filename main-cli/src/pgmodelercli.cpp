@@ -40,6 +40,7 @@ QString PgModelerCLI::INITIAL_DB="--initial-db";
 QString PgModelerCLI::SILENT="--silent";
 QString PgModelerCLI::LIST_CONNS="--list-conns";
 QString PgModelerCLI::SIMULATE="--simulate";
+QString PgModelerCLI::BATCH_EXEC="--batch-exec";
 QString PgModelerCLI::FIX_MODEL="--fix-model";
 QString PgModelerCLI::FIX_TRIES="--fix-tries";
 QString PgModelerCLI::ZOOM_FACTOR="--zoom";
@@ -186,6 +187,7 @@ void PgModelerCLI::initializeOptions(void)
 	long_opts[INITIAL_DB]=true;
 	long_opts[LIST_CONNS]=false;
 	long_opts[SIMULATE]=false;
+	long_opts[BATCH_EXEC]=false;
 	long_opts[FIX_MODEL]=false;
 	long_opts[FIX_TRIES]=true;
 	long_opts[ZOOM_FACTOR]=true;
@@ -212,6 +214,7 @@ void PgModelerCLI::initializeOptions(void)
 	short_opts[SILENT]="-s";
 	short_opts[LIST_CONNS]="-L";
 	short_opts[SIMULATE]="-S";
+	short_opts[BATCH_EXEC]="-B";
 	short_opts[FIX_MODEL]="-F";
 	short_opts[FIX_TRIES]="-t";
 	short_opts[ZOOM_FACTOR]="-z";
@@ -249,7 +252,7 @@ accepted structure. All available options are described below.") << endl;
 	out << trUtf8("   %1, %2=[FILE]\t\t Input model file (.dbm). Mandatory use when fixing a model or exporting it.").arg(short_opts[INPUT]).arg(INPUT) << endl;
 	out << trUtf8("   %1, %2=[FILE]\t\t Output file. Mandatory use when fixing model or export to file or png.").arg(short_opts[OUTPUT]).arg(OUTPUT) << endl;
 	out << trUtf8("   %1, %2\t\t Try to fix the structure of the input model file in order to make it loadable on pgModeler 0.6.x.").arg(short_opts[FIX_MODEL]).arg(FIX_MODEL) << endl;
-	out << trUtf8("   %1, %2\t\t Model fix tries. When reaching the maximum count the invalid objects will be discard.").arg(short_opts[FIX_TRIES]).arg(FIX_TRIES) << endl;
+	out << trUtf8("   %1, %2\t\t Maximum retries of the objects that couldn't be fixed in dependency order. By default the retries stop when no object is fixed.").arg(short_opts[FIX_TRIES]).arg(FIX_TRIES) << endl;
 	out << trUtf8("   %1, %2\t\t Export to a sql script file.").arg(short_opts[EXPORT_TO_FILE]).arg(EXPORT_TO_FILE)<< endl;
 	out << trUtf8("   %1, %2\t\t Export to a png image.").arg(short_opts[EXPORT_TO_PNG]).arg(EXPORT_TO_PNG) << endl;
 	out << trUtf8("   %1, %2\t\t Export directly to a PostgreSQL server.").arg(short_opts[EXPORT_TO_DBMS]).arg(EXPORT_TO_DBMS) << endl;
@@ -268,6 +271,7 @@ accepted structure. All available options are described below.") << endl;
 	out << trUtf8("   %1, %2\t Ignores errors related to duplicated objects that eventually exists on server side.").arg(short_opts[IGNORE_DUPLICATES]).arg(IGNORE_DUPLICATES) << endl;
 	out << trUtf8("   %1, %2\t\t Drop the database before execute a export process.").arg(short_opts[DROP_DATABASE]).arg(DROP_DATABASE) << endl;
 	out << trUtf8("   %1, %2\t\t Simulates a export process. Actually executes all steps but undoing any modification.").arg(short_opts[SIMULATE]).arg(SIMULATE) << endl;
+	out << trUtf8("   %1, %2\t\t Creates the objects inside a single transaction sending the commands in batches.").arg(short_opts[BATCH_EXEC]).arg(BATCH_EXEC) << endl;
 	out << trUtf8("   %1, %2=[ALIAS]\t Connection configuration alias to be used.").arg(short_opts[CONN_ALIAS]).arg(CONN_ALIAS) << endl;
 	out << trUtf8("   %1, %2=[HOST]\t\t PostgreSQL host which export will operate.").arg(short_opts[HOST]).arg(HOST) << endl;
 	out << trUtf8("   %1, %2=[PORT]\t\t PostgreSQL host listening port.").arg(short_opts[PORT]).arg(PORT) << endl;
@@ -406,7 +410,7 @@ int PgModelerCLI::exec(void)
 					if(!silent_mode)
 						out << trUtf8("Export to DBMS: ") <<  connection.getConnectionString() << endl;
 
-					export_hlp.exportToDBMS(model, connection, parsed_opts[PGSQL_VER], parsed_opts.count(IGNORE_DUPLICATES) > 0, parsed_opts.count(DROP_DATABASE) > 0, parsed_opts.count(SIMULATE) > 0);
+					export_hlp.exportToDBMS(model, connection, parsed_opts[PGSQL_VER], parsed_opts.count(IGNORE_DUPLICATES) > 0, parsed_opts.count(DROP_DATABASE) > 0, parsed_opts.count(SIMULATE) > 0, parsed_opts.count(BATCH_EXEC) > 0);
 				}
 
 				if(!silent_mode)
@@ -578,6 +582,146 @@ void PgModelerCLI::extractObjectXML(void)
 	}
 }
 
+void PgModelerCLI::sortObjectsXML(void)
+{
+	QRegExp name_regexp("\\sname=\"([^\"]*)\""),
+			schema_regexp(QString("<%1 name=\"([^\"]*)\"").arg(BaseObject::getSchemaName(OBJ_SCHEMA))),
+			ref_regexp(QString("(<(%1|%2|%3|%4|%5|%6|%7|%8|object) name=\"([^\"]*)\")|"
+													"(\\s(table|src-table|dst-table|ref-table|signature|owner-col)=\"([^\"]*)\")")
+								 .arg(BaseObject::getSchemaName(OBJ_SCHEMA))
+								 .arg(BaseObject::getSchemaName(OBJ_ROLE))
+								 .arg(BaseObject::getSchemaName(OBJ_TABLESPACE))
+								 .arg(BaseObject::getSchemaName(OBJ_LANGUAGE))
+								 .arg(BaseObject::getSchemaName(OBJ_COLLATION))
+								 .arg(BaseObject::getSchemaName(OBJ_DOMAIN))
+								 .arg(BaseObject::getSchemaName(OBJ_TAG))
+								 .arg("type"));
+	ObjectType prov_types[]={ OBJ_SCHEMA, OBJ_ROLE, OBJ_TABLESPACE, OBJ_LANGUAGE, OBJ_COLLATION, OBJ_TYPE,
+														OBJ_DOMAIN, OBJ_TAG, OBJ_TABLE, OBJ_VIEW, OBJ_SEQUENCE, OBJ_FUNCTION, OBJ_OPERATOR,
+														OBJ_OPFAMILY, OBJ_OPCLASS, OBJ_EXTENSION };
+	QStringList prov_tags, elem_names, sorted_xml;
+	QString root_tag, elem_name, key, ref, quot="&quot;";
+	map<QString, vector<unsigned> > providers, rels;
+	vector<unsigned> order;
+	vector<vector<unsigned> > cycles;
+	DependencyGraph graph(objs_xml.size());
+	unsigned i, count=sizeof(prov_types)/sizeof(ObjectType);
+	int pos=0, root_end=0;
+
+	for(i=0; i < count; i++)
+		prov_tags.push_back(BaseObject::getSchemaName(prov_types[i]));
+
+	/* Registering the names provided by the objects that can be referenced by other ones (qualified by the schema
+		 when there is one) as well the tables linked by each relationship */
+	for(i=0; i < static_cast<unsigned>(objs_xml.size()); i++)
+	{
+		const QString &xml_def=objs_xml[i];
+
+		root_end=xml_def.indexOf('>');
+		root_tag=xml_def.left(root_end + 1);
+		elem_name=root_tag.mid(root_tag.indexOf('<') + 1).section(QRegExp("[\\s>/]"), 0, 0);
+		elem_names.push_back(elem_name);
+
+		if(name_regexp.indexIn(root_tag) >= 0 && prov_tags.contains(elem_name))
+		{
+			key=name_regexp.cap(1);
+
+			if(schema_regexp.indexIn(xml_def, root_end) >= 0)
+				key=schema_regexp.cap(1) + "." + key;
+
+			//Names are compared without quotes since the references are stored quoted
+			providers[key.remove(quot)].push_back(i);
+		}
+		//Fk and table-view relationships don't add columns to the tables
+		else if(elem_name==ParsersAttributes::RELATIONSHIP &&
+						!root_tag.contains(QString("\"%1\"").arg(ParsersAttributes::RELATIONSHIP_FK)) &&
+						!root_tag.contains(QString("\"%1\"").arg(ParsersAttributes::RELATION_TAB_VIEW)))
+		{
+			pos=0;
+			while((pos=ref_regexp.indexIn(root_tag, pos)) >= 0)
+			{
+				if(ref_regexp.cap(5)=="src-table" || ref_regexp.cap(5)=="dst-table")
+					rels[ref_regexp.cap(6).remove(quot)].push_back(i);
+
+				pos+=ref_regexp.matchedLength();
+			}
+		}
+	}
+
+	/* Each object depends on the objects that provide the names it references. The objects that reference a table
+		 (special objects and views, not the table's own constraints) also depend on the relationships linked to that
+		 table since they can reference columns added by them */
+	for(i=0; i < static_cast<unsigned>(objs_xml.size()); i++)
+	{
+		const QString &xml_def=objs_xml[i];
+
+		root_end=xml_def.indexOf('>');
+		pos=0;
+
+		while((pos=ref_regexp.indexIn(xml_def, pos)) >= 0)
+		{
+			//Name references from child tags are considered only after the object's own tag
+			if(!ref_regexp.cap(1).isEmpty())
+			{
+				if(pos > root_end)
+					ref=ref_regexp.cap(3).remove(quot);
+				else
+					ref.clear();
+			}
+			else
+			{
+				ref=ref_regexp.cap(6).remove(quot);
+
+				//Signatures are reduced to the object name and column references to the table name
+				if(ref_regexp.cap(5)=="signature")
+					ref=ref.section(QRegExp("[\\(\\s]"), 0, 0);
+				else if(ref_regexp.cap(5)=="owner-col")
+					ref=ref.left(ref.lastIndexOf('.'));
+				//Foreign keys are extracted from the tables and created at the end (see recreateObjects())
+				else if(ref_regexp.cap(5)=="ref-table" && elem_names[i]==BaseObject::getSchemaName(OBJ_TABLE))
+					ref.clear();
+				else if(ref_regexp.cap(5)=="table" && rels.count(ref) &&
+								elem_names[i]!=BaseObject::getSchemaName(OBJ_TABLE))
+				{
+					for(auto rel : rels[ref])
+						graph.addDependency(i, rel);
+				}
+			}
+
+			if(!ref.isEmpty() && providers.count(ref))
+			{
+				for(auto prov : providers[ref])
+					graph.addDependency(i, prov);
+			}
+
+			pos+=ref_regexp.matchedLength();
+		}
+	}
+
+	graph.getCreationOrder(order, cycles);
+
+	if(!silent_mode)
+	{
+		for(auto &cycle : cycles)
+		{
+			out << trUtf8("WARNING: Circular dependency between the objects:");
+
+			for(auto idx : cycle)
+			{
+				if(name_regexp.indexIn(objs_xml[idx]) >= 0)
+					out << " " << name_regexp.cap(1);
+			}
+
+			out << endl;
+		}
+	}
+
+	for(auto idx : order)
+		sorted_xml.push_back(objs_xml[idx]);
+
+	objs_xml=sorted_xml;
+}
+
 void PgModelerCLI::recreateObjects(void)
 {
 	QStringList fail_objs, constr, list;
@@ -585,32 +729,24 @@ void PgModelerCLI::recreateObjects(void)
 	BaseObject *object=nullptr;
 	ObjectType obj_type;
 	attribs_map attribs;
-	bool use_fail_obj=false;
+	bool created=false;
 	unsigned tries=0, max_tries=parsed_opts[FIX_TRIES].toUInt();
 
 	if(!silent_mode)
 		out << trUtf8("Recreating objects...") << endl;
 
-	if(max_tries==0)
-		max_tries=1;
+	for(auto &obj_xml : objs_xml)
+		fixObjectAttributes(obj_xml);
+
+	//Placing the objects in dependency order so each one is created after the objects it references
+	sortObjectsXML();
 
 	model->createSystemObjects(false);
 
 	while(!objs_xml.isEmpty())
 	{
-		//If there are failed objects and the flag is set
-		if(use_fail_obj && !fail_objs.isEmpty())
-		{
-			xml_def=fail_objs.front();
-			fail_objs.pop_front();
-			use_fail_obj=false;
-		}
-		else
-		{
-			xml_def=objs_xml.front();
-			objs_xml.pop_front();
-			fixObjectAttributes(xml_def);
-		}
+		xml_def=objs_xml.front();
+		objs_xml.pop_front();
 
 		try
 		{
@@ -650,11 +786,10 @@ void PgModelerCLI::recreateObjects(void)
 						if(!dynamic_cast<TableObject *>(object) && obj_type!=OBJ_RELATIONSHIP && obj_type!=BASE_RELATIONSHIP)
 							model->addObject(object);
 					}
-
-					//For each sucessful created object the method will try to create a failed one
-					use_fail_obj=(!fail_objs.isEmpty());
 				}
 			}
+
+			created=true;
 		}
 		catch(Exception &e)
 		{
@@ -664,15 +799,19 @@ void PgModelerCLI::recreateObjects(void)
 				throw Exception(e.getErrorMessage(), e.getErrorType(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 		}
 
+		/* Since the objects are created in dependency order the remaining ones are the foreign keys and the objects
+		that couldn't be created (e.g. referencing columns not yet added by relationships). They are created again after
+		validating the relationships, while the previous pass creates at least one object (or until the maximum tries) */
 		if(objs_xml.isEmpty() && (!fail_objs.isEmpty() || !constr.isEmpty()))
 		{
 			tries++;
 
-			//If the maximum creation tries reaches the maximum value
-			if(tries > max_tries)
+			if(!created || (max_tries > 0 && tries > max_tries))
 			{
 				//Outputs the code of the objects that wasn't created
 				out << trUtf8("\n** Object(s) that couldn't fixed: ") << endl;
+				fail_objs.append(constr);
+
 				while(!fail_objs.isEmpty())
 				{
 					out << fail_objs.front() << endl;
@@ -683,14 +822,15 @@ void PgModelerCLI::recreateObjects(void)
 			}
 			else
 			{
-				if(!silent_mode)
-					out << trUtf8("WARNING: There are objects that maybe can't be fixed. Trying again... (tries %1/%2)").arg(tries).arg(max_tries) << endl;
+				if(!silent_mode && !fail_objs.isEmpty())
+					out << trUtf8("WARNING: There are objects that maybe can't be fixed. Trying again... (tries %1)").arg(tries) << endl;
 
 				model->validateRelationships();
 				objs_xml=fail_objs;
 				objs_xml.append(constr);
 				fail_objs.clear();
 				constr.clear();
+				created=false;
 			}
 		}
 	}
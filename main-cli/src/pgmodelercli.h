@@ -34,6 +34,7 @@
 #include "modelexporthelper.h"
 #include "generalconfigwidget.h"
 #include "connectionsconfigwidget.h"
+#include "dependencygraph.h"
 
 class PgModelerCLI: public QApplication {
 	private:
@@ -100,6 +101,7 @@ class PgModelerCLI: public QApplication {
 		SILENT,
 		LIST_CONNS,
 		SIMULATE,
+		BATCH_EXEC,
 		FIX_MODEL,
 		FIX_TRIES,
 		ZOOM_FACTOR;
@@ -120,6 +122,10 @@ class PgModelerCLI: public QApplication {
 		in order to be parsed by the recreateObjects() method */
 		void extractObjectXML(void);
 
+		/*! \brief Sorts the obj_xml list in dependency order based on the names referenced by each object definition
+		(see DependencyGraph). The objects with circular dependencies are kept in file order and reported */
+		void sortObjectsXML(void);
+
 		//! \brief Recreates the objects from the obj_xml list fixing the creation order for them
 		void recreateObjects(void);
 
@@ -1,14 +1,428 @@
 #include <iostream>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QFile>
+#include <QDir>
+#include <QRegExp>
 #include "exception.h"
-#include "mainwindow.h"
+#include "databasemodel.h"
 
 using namespace std;
 
-int main(int, char **)
+//Counts the statements and the amount of code streamed by DatabaseModel::getSQLStatements()
+class StatementCounter: public SQLStatementHandler {
+	public:
+		unsigned stmt_count, chars_count;
+
+		StatementCounter(void) : stmt_count(0), chars_count(0) {}
+
+		void handleStatement(const SQLStatement &stmt)
+		{
+			stmt_count++;
+			chars_count+=stmt.sql.size();
+		}
+};
+
+//Joins the statements streamed by DatabaseModel::getSQLStatements() in the order they are received
+class StatementCollector: public SQLStatementHandler {
+	public:
+		QString code;
+
+		void handleStatement(const SQLStatement &stmt)
+		{
+			code+=stmt.sql;
+		}
+};
+
+//Removes the whitespaces of the code so the comparison ignores the blank lines placed between the statements
+QString normalizeCode(const QString &code)
+{
+	QString aux_code=code;
+	return(aux_code.remove(QRegExp("\\s+")));
+}
+
+/* Checks the consistency of the model's code generation and references graph: the SQL code generated in parallel
+	 must be the same as the one generated sequentially, the statements streamed by getSQLStatements() must compose
+	 the model's SQL code and the references graph must match the references found by scanning the whole model.
+	 The failures are printed on the error output. Returns the amount of failed checks */
+unsigned checkModelConsistency(DatabaseModel &model, const QString &label)
+{
+	QString seq_code, par_code;
+	StatementCollector collector;
+	vector<BaseObject *> inv_objs;
+	unsigned failures=0;
+
+	model.setParallelCodeGeneration(false);
+	seq_code=model.getCodeDefinition(SchemaParser::SQL_DEFINITION);
+
+	model.setParallelCodeGeneration(true);
+	par_code=model.getCodeDefinition(SchemaParser::SQL_DEFINITION);
+	model.setParallelCodeGeneration(false);
+
+	if(par_code!=seq_code)
+	{
+		cerr << label.toStdString() << ": the SQL generated in parallel differs from the sequential one" << endl;
+		failures++;
+	}
+
+	model.getSQLStatements(collector, true);
+
+	if(normalizeCode(collector.code)!=normalizeCode(seq_code))
+	{
+		cerr << label.toStdString() << ": the streamed statements differ from the model's SQL code" << endl;
+		failures++;
+	}
+
+	model.checkReferencesGraph(inv_objs);
+
+	if(!inv_objs.empty())
+	{
+		cerr << label.toStdString() << ": the references graph has " << inv_objs.size() << " inconsistent object(s)" << endl;
+
+		for(unsigned i=0; i < inv_objs.size(); i++)
+			cerr << "  " << inv_objs[i]->getName(true).toStdString() << " (" << inv_objs[i]->getTypeName().toStdString() << ")" << endl;
+
+		failures++;
+	}
+
+	return(failures);
+}
+
+/* Measures the whole model SQL/XML generation time with the compiled templates
+	 cache of the SchemaParser disabled (schema files reloaded and reparsed for each object)
+	 and enabled, and the SQL generation time in parallel mode. Returns the amount of failed
+	 consistency checks (see checkModelConsistency()). Usage: pgmodeler-rev [model file] [iterations] */
+unsigned benchmarkCodeGeneration(const QString &filename, unsigned iterations)
+{
+	DatabaseModel model;
+	QElapsedTimer timer;
+	unsigned def_types[]={ SchemaParser::SQL_DEFINITION, SchemaParser::XML_DEFINITION };
+	QString def_names[]={ "SQL", "XML" }, code_def;
+	bool cache_modes[]={ false, true };
+	unsigned failures=0;
+
+	model.createSystemObjects(false);
+
+	//Loading the model without DTD validation only to measure the loading time
+	{
+		DatabaseModel aux_model;
+		aux_model.createSystemObjects(false);
+		timer.start();
+		aux_model.loadModel(filename, false);
+		cout << "Model loading (no DTD validation): " << timer.elapsed() << " ms" << endl;
+	}
+
+	timer.start();
+	model.loadModel(filename);
+
+	cout << "Model: " << filename.toStdString() << endl;
+	cout << "Model loading: " << timer.elapsed() << " ms" << endl;
+	cout << "DTD loads: " << XMLParser::getDTDLoadCount() << endl;
+
+	failures=checkModelConsistency(model, filename);
+	cout << "Consistency checks: " << (failures==0 ? "passed" : "FAILED") << endl;
+
+	for(unsigned mode=0; mode < 2; mode++)
+	{
+		SchemaParser::setTemplateCacheEnabled(cache_modes[mode]);
+
+		for(unsigned def=0; def < 2; def++)
+		{
+			timer.start();
+
+			for(unsigned i=0; i < iterations; i++)
+				code_def=model.getCodeDefinition(def_types[def]);
+
+			cout << def_names[def].toStdString() << " generation (template cache "
+					 << (cache_modes[mode] ? "on" : "off") << "): "
+					 << (timer.elapsed() / iterations) << " ms/iteration, "
+					 << code_def.size() << " chars" << endl;
+		}
+	}
+
+	model.setParallelCodeGeneration(true);
+	timer.start();
+
+	for(unsigned i=0; i < iterations; i++)
+		code_def=model.getCodeDefinition(SchemaParser::SQL_DEFINITION);
+
+	cout << "SQL generation (parallel, template cache on): "
+			 << (timer.elapsed() / iterations) << " ms/iteration, "
+			 << code_def.size() << " chars" << endl;
+
+	StatementCounter counter;
+	timer.start();
+	model.getSQLStatements(counter, true);
+
+	cout << "SQL generation (statements stream): "
+			 << timer.elapsed() << " ms, "
+			 << counter.stmt_count << " statements, "
+			 << counter.chars_count << " chars" << endl;
+
+	return(failures);
+}
+
+//Measures the time spent resolving built-in and user defined type names
+void benchmarkTypeResolution(unsigned iterations)
+{
+	QElapsedTimer timer;
+	QStringList types;
+	unsigned count=0;
+
+	PgSQLType::getTypes(types);
+	timer.start();
+
+	for(unsigned i=0; i < iterations; i++)
+	{
+		for(auto &type : types)
+			count+=(PgSQLType::getBaseTypeIndex(type)!=BaseType::null);
+	}
+
+	cout << "Type name resolution: " << count << " lookups in "
+			 << timer.elapsed() << " ms" << endl;
+}
+
+//Amount of objects created per schema on synthetic models
+static const unsigned SYNTH_TABLES=20,
+SYNTH_COLUMNS=10,
+SYNTH_INHERIT_DEPTH=3,
+SYNTH_FUNCTIONS=10,
+SYNTH_VIEWS=5;
+
+/* Populates the model with 'schema_cnt' schemas, each one containing a chain of tables linked by
+	 foreign keys, an inheritance chain, functions and views referencing the tables */
+void createSyntheticModel(DatabaseModel &model, unsigned schema_cnt)
+{
+	BaseObject *lang_sql=nullptr;
+
+	model.setName("synthetic_db");
+	model.createSystemObjects(false);
+	lang_sql=model.getObject("sql", OBJ_LANGUAGE);
+
+	for(unsigned s=0; s < schema_cnt; s++)
+	{
+		Schema *schema=new Schema;
+		vector<Table *> tables;
+
+		schema->setName(QString("schema_%1").arg(s));
+		model.addSchema(schema);
+
+		for(unsigned t=0; t < SYNTH_TABLES; t++)
+		{
+			Table *table=new Table;
+			Column *col=nullptr, *id_col=new Column;
+			Constraint *constr=new Constraint;
+
+			table->setName(QString("table_%1").arg(t));
+			table->setSchema(schema);
+
+			id_col->setName("id");
+			id_col->setType(PgSQLType("integer"));
+			id_col->setNotNull(true);
+			table->addColumn(id_col);
+
+			for(unsigned c=0; c < SYNTH_COLUMNS; c++)
+			{
+				col=new Column;
+				col->setName(QString("column_%1").arg(c));
+				col->setType(PgSQLType(c % 2 == 0 ? "text" : "integer"));
+				table->addColumn(col);
+			}
+
+			constr->setName(table->getName() + "_pk");
+			constr->setConstraintType(ConstraintType::primary_key);
+			constr->addColumn(id_col, Constraint::SOURCE_COLS);
+			table->addConstraint(constr);
+
+			//Each table references the previous one
+			if(!tables.empty())
+			{
+				col=new Column;
+				col->setName("ref_id");
+				col->setType(PgSQLType("integer"));
+				table->addColumn(col);
+
+				constr=new Constraint;
+				constr->setName(table->getName() + "_fk");
+				constr->setConstraintType(ConstraintType::foreign_key);
+				constr->setReferencedTable(tables.back());
+				constr->addColumn(col, Constraint::SOURCE_COLS);
+				constr->addColumn(tables.back()->getColumn("id"), Constraint::REFERENCED_COLS);
+				table->addConstraint(constr);
+			}
+
+			model.addTable(table);
+			model.updateTableFKRelationships(table);
+			tables.push_back(table);
+		}
+
+		//Inheritance chain starting at the first table of the schema
+		Table *parent=tables.front();
+		for(unsigned d=0; d < SYNTH_INHERIT_DEPTH; d++)
+		{
+			Table *child=new Table;
+			Column *col=new Column;
+
+			child->setName(QString("child_%1").arg(d));
+			child->setSchema(schema);
+			col->setName(QString("child_column_%1").arg(d));
+			col->setType(PgSQLType("text"));
+			child->addColumn(col);
+			model.addTable(child);
+
+			model.addRelationship(new Relationship(BaseRelationship::RELATIONSHIP_GEN, child, parent));
+			parent=child;
+		}
+
+		for(unsigned f=0; f < SYNTH_FUNCTIONS; f++)
+		{
+			Function *func=new Function;
+			Parameter param;
+
+			func->setName(QString("function_%1").arg(f));
+			func->setSchema(schema);
+			func->setLanguage(lang_sql);
+			func->setReturnType(PgSQLType("integer"));
+			func->setSourceCode("SELECT $1;");
+
+			param.setName("value");
+			param.setType(PgSQLType("integer"));
+			func->addParameter(param);
+
+			model.addFunction(func);
+		}
+
+		for(unsigned v=0; v < SYNTH_VIEWS; v++)
+		{
+			View *view=new View;
+			Table *table=tables[v % tables.size()];
+			Reference ref_col(table, table->getColumn("id"), "t", "id"),
+								ref_tab(table, nullptr, "t", "");
+
+			view->setName(QString("view_%1").arg(v));
+			view->setSchema(schema);
+			view->addReference(ref_col, Reference::SQL_REFER_SELECT);
+			view->addReference(ref_tab, Reference::SQL_REFER_FROM);
+			model.addView(view);
+		}
+	}
+}
+
+/* Measures how the model operations scale over synthetic models of the specified sizes (in schemas).
+	 The results are written as CSV lines (benchmark;schemas;objects;elapsed_ms) so they can be compared
+	 between revisions. Each synthetic model is also checked for consistency (see checkModelConsistency()),
+	 the amount of failed checks is returned. Usage: pgmodeler-rev --synthetic [size,size,...] [results file] */
+unsigned benchmarkSyntheticModels(const vector<unsigned> &sizes, QTextStream &out)
+{
+	QElapsedTimer timer;
+	QString filename, code_def;
+	vector<BaseObject *> refs;
+	unsigned failures=0;
+
+	out << "benchmark;schemas;objects;elapsed_ms" << endl;
+
+	for(unsigned size : sizes)
+	{
+		DatabaseModel model;
+		unsigned obj_count=0;
+
+		timer.start();
+		createSyntheticModel(model, size);
+		obj_count=model.getObjectCount();
+		out << "create;" << size << ";" << obj_count << ";" << timer.elapsed() << endl;
+
+		filename=QDir::temp().filePath(QString("pgmodeler-rev-synthetic-%1.dbm").arg(size));
+		timer.start();
+		model.saveModel(filename, SchemaParser::XML_DEFINITION);
+		out << "save;" << size << ";" << obj_count << ";" << timer.elapsed() << endl;
+
+		{
+			DatabaseModel loaded_model;
+			loaded_model.createSystemObjects(false);
+			timer.start();
+			loaded_model.loadModel(filename);
+			out << "load;" << size << ";" << obj_count << ";" << timer.elapsed() << endl;
+		}
+
+		QFile::remove(filename);
+
+		timer.start();
+		code_def=model.getCodeDefinition(SchemaParser::SQL_DEFINITION);
+		out << "sql_generation;" << size << ";" << obj_count << ";" << timer.elapsed() << endl;
+
+		timer.start();
+		code_def=model.getCodeDefinition(SchemaParser::XML_DEFINITION);
+		out << "xml_generation;" << size << ";" << obj_count << ";" << timer.elapsed() << endl;
+
+		/* Invalidating every relationship so the whole revalidation (disconnection and reconnection)
+			 is measured, since the validation of a model with no invalid relationship does nothing */
+		for(auto obj : *model.getObjectList(OBJ_RELATIONSHIP))
+			dynamic_cast<Relationship *>(obj)->forceInvalidate();
+
+		timer.start();
+		model.validateRelationships();
+		out << "validate_relationships;" << size << ";" << obj_count << ";" << timer.elapsed() << endl;
+
+		//Querying the references of every table and column (as done when removing objects)
+		timer.start();
+		for(auto obj : *model.getObjectList(OBJ_TABLE))
+		{
+			Table *table=dynamic_cast<Table *>(obj);
+
+			model.getObjectReferences(table, refs);
+
+			for(unsigned i=0; i < table->getColumnCount(); i++)
+				model.getObjectReferences(table->getColumn(i), refs);
+		}
+		out << "object_references;" << size << ";" << obj_count << ";" << timer.elapsed() << endl;
+
+		failures+=checkModelConsistency(model, QString("synthetic model (%1 schemas)").arg(size));
+	}
+
+	return(failures);
+}
+
+int main(int argc, char **argv)
 {
   try
   {
-    return(0);
+		//No GUI is needed by the benchmarks so they can run on headless machines
+		QCoreApplication app(argc, argv);
+		unsigned failures=0;
+
+		if(argc > 1 && QString(argv[1])=="--synthetic")
+		{
+			vector<unsigned> sizes;
+			QStringList size_list=QString(argc > 2 ? argv[2] : "1,5,10").split(',', QString::SkipEmptyParts);
+			QFile output;
+			QTextStream out;
+
+			for(auto &size : size_list)
+				sizes.push_back(qMax(1u, size.toUInt()));
+
+			if(argc > 3)
+			{
+				output.setFileName(argv[3]);
+
+				if(!output.open(QFile::WriteOnly | QFile::Truncate))
+					throw Exception(Exception::getErrorMessage(ERR_FILE_NOT_WRITTEN).arg(argv[3]),
+													ERR_FILE_NOT_WRITTEN,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+			}
+			else
+				output.open(stdout, QFile::WriteOnly);
+
+			out.setDevice(&output);
+			failures=benchmarkSyntheticModels(sizes, out);
+		}
+		else if(argc > 1)
+		{
+			failures=benchmarkCodeGeneration(argv[1], (argc > 2 ? qMax(1u, QString(argv[2]).toUInt()) : 1));
+			benchmarkTypeResolution(1000);
+		}
+
+		//Any failed consistency check makes the program fail so it can be used on automated runs
+    return(failures > 0 ? 1 : 0);
   }
   catch(Exception &e)
   {